@@ -32,6 +32,46 @@
 #include "FastIO.h"
 
 
+#if defined (FIO_IRQ_OFF_MEASURE) && defined (__AVR__) && defined (TCNT1)
+// Longest critical section in CPU cycles
+static volatile uint16_t fio_irqOffMax = 0;
+
+void fio_irqOffMeasureStart ( void )
+{
+	// Timer1 in normal mode counting at F_CPU
+	TCCR1A = 0;
+	TCCR1B = _BV(CS10);
+	fio_irqOffMax = 0;
+}
+
+uint16_t fio_irqOffWorst ( bool reset )
+{
+	uint16_t worst;
+   
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		worst = fio_irqOffMax;
+		if (reset)
+		{
+			fio_irqOffMax = 0;
+		}
+	}
+	return worst;
+}
+
+void fio_irqOffEnd ( const uint16_t *start )
+{
+	// Still inside the critical section
+	uint16_t span = TCNT1 - *start;
+   
+	if (span > fio_irqOffMax)
+	{
+		fio_irqOffMax = span;
+	}
+}
+#endif
+
+
 fio_register fio_pinToOutputRegister(uint8_t pin, uint8_t initial_state)
 {
 	pinMode(pin, OUTPUT);
@@ -44,7 +84,18 @@ fio_register fio_pinToOutputRegister(uint8_t pin, uint8_t initial_state)
 	//  just wasting memory if not using fast io...
 	return 0;
 #else
-	return portOutputRegister(digitalPinToPort(pin));
+#if defined(FIO_SLOW_PIN)
+	if (FIO_SLOW_PIN(pin))
+	{
+		return 0; // written with digitalWrite
+	}
+#endif
+	fio_register reg = portOutputRegister(digitalPinToPort(pin));
+#if defined(FIO_OWER_OFFSET)
+	// allow the pin to be written through the output data register too
+	*(reg + FIO_OWER_OFFSET) = digitalPinToBitMask(pin);
+#endif
+	return reg;
 #endif
 }
 
@@ -57,6 +108,12 @@ fio_register fio_pinToInputRegister(uint8_t pin)
 	//  just wasting memory if not using fast io...
 	return 0;
 #else
+#if defined(FIO_SLOW_PIN)
+	if (FIO_SLOW_PIN(pin))
+	{
+		return 0; // read with digitalRead
+	}
+#endif
 	return portInputRegister(digitalPinToPort(pin));
 #endif
 }
@@ -68,6 +125,12 @@ fio_bit fio_pinToBit(uint8_t pin)
 	// (ab)use the bit variable to store the pin
 	return pin;
 #else
+#if defined(FIO_SLOW_PIN)
+	if (FIO_SLOW_PIN(pin))
+	{
+		return pin;
+	}
+#endif
 	return digitalPinToBitMask(pin);
 #endif
 }
@@ -78,7 +141,7 @@ void fio_digitalWrite(fio_register pinRegister, fio_bit pinBit, uint8_t value)
 #ifdef FIO_FALLBACK
 	digitalWrite(pinBit, value);
 #else
-   ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+   FIO_ATOMIC_BLOCK
    {
       if(value == LOW)
       {
@@ -92,11 +155,17 @@ void fio_digitalWrite(fio_register pinRegister, fio_bit pinBit, uint8_t value)
 #endif
 }
 
-int fio_digitalRead(fio_register pinRegister, uint8_t pinBit)
+int fio_digitalRead(fio_register pinRegister, fio_bit pinBit)
 {
 #ifdef FIO_FALLBACK
 	return digitalRead (pinBit);
 #else
+#if defined(FIO_SLOW_PIN)
+	if (pinRegister == 0)
+	{
+		return digitalRead (pinBit);
+	}
+#endif
 	if (*pinRegister & pinBit)
    {
       return HIGH;
@@ -109,49 +178,13 @@ void fio_shiftOut (fio_register dataRegister, fio_bit dataBit,
                    fio_register clockRegister, fio_bit clockBit, 
                    uint8_t value, uint8_t bitOrder)
 {
-	// # disable interrupts
-	int8_t i;
-   
 	if(bitOrder == LSBFIRST)
 	{
-		for(i = 0; i < 8; i++)
-		{
-			ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
-			{
-				if(value & 1)
-            {
-               fio_digitalWrite_HIGH(dataRegister, dataBit);
-				}
-            else
-            {
-               fio_digitalWrite_LOW(dataRegister, dataBit);
-            }
-            value >>= 1;
-				fio_digitalWrite_HIGH (clockRegister, clockBit);
-				fio_digitalWrite_LOW (clockRegister,clockBit);
-			}
-		}
-      
+		fio_shiftOut<LSBFIRST>(dataRegister, dataBit, clockRegister, clockBit, value);
 	}
 	else
 	{
-		for(i = 0; i < 8; i++)
-		{
-			ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
-			{
-				if(value & 0x80)
-            {
-               fio_digitalWrite_HIGH(dataRegister, dataBit);
-				}
-            else
-            {
-               fio_digitalWrite_LOW(dataRegister, dataBit);
-            }
-				value <<= 1;
-				fio_digitalWrite_HIGH (clockRegister, clockBit);
-				fio_digitalWrite_LOW (clockRegister,clockBit);
-			}
-		}
+		fio_shiftOut<MSBFIRST>(dataRegister, dataBit, clockRegister, clockBit, value);
 	}
 }
 
@@ -159,7 +192,25 @@ void fio_shiftOut (fio_register dataRegister, fio_bit dataBit,
 void fio_shiftOut(fio_register dataRegister, fio_bit dataBit, 
                   fio_register clockRegister, fio_bit clockBit)
 {
-   ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+   if (!FIO_IRQ_OFF_FITS(FIO_SHIFTOUT_CYCLES))
+   {
+      // Only the clock pulses need protecting, one critical section each
+      FIO_ATOMIC_BLOCK
+      {
+         fio_digitalWrite_LOW (dataRegister, dataBit);
+      }
+      for(uint8_t i = 0; i<8; ++i)
+      {
+         FIO_ATOMIC_BLOCK
+         {
+            fio_digitalWrite_HIGH (clockRegister, clockBit);
+            fio_digitalWrite_SWITCH (clockRegister, clockBit);
+         }
+      }
+      return;
+   }
+   
+   FIO_ATOMIC_BLOCK
    {
       // shift out 0x0 (B00000000) fast, byte order is irrelevant
       fio_digitalWrite_LOW (dataRegister, dataBit);
@@ -180,10 +231,9 @@ void fio_shiftOut1_init(uint8_t pin)
 
 void fio_shiftOut1_init(fio_register shift1Register, fio_bit shift1Bit)
 {
-	// Make sure that capacitors are charged
-	// 300us is an educated guess...
+	// Make sure that capacitors are charged, as long as after a latch
 	fio_digitalWrite(shift1Register,shift1Bit,HIGH);
-	delayMicroseconds(300);
+	delayMicroseconds(FIO_SHIFT1_LATCH_HIGH_US);
 }
 
 
@@ -205,39 +255,62 @@ void fio_shiftOut1(fio_register shift1Register, fio_bit shift1Bit, uint8_t value
 	 * 	7HC595N
 	 */
    
-	// iterate but ignore last bit (is it correct now?)
+	// The latch sequence shifts in the last bit (always LOW), the hold after
+	// the bit before it is not needed: the latch LOW discharges the Data
+	// capacitor anyway.
 	for(int8_t i = 7; i>=0; --i)
    {
+      boolean last = !noLatch && (i == 1);
       
 		// assume that pin is HIGH (smokin' pot all day... :) - requires 
       // initialization
 		if(value & _BV(i))
       {
-         ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+         FIO_ATOMIC_BLOCK
          {
             // HIGH = 1 Bit
             fio_digitalWrite_SWITCHTO(shift1Register,shift1Bit,LOW);
             //hold pin LOW for 1us - done! :)
             fio_digitalWrite_SWITCHTO(shift1Register,shift1Bit,HIGH);
          } // end critical section
-         //hold pin HIGH for 15us
-         delayMicroseconds(15);
+         if(!last)
+         {
+            // Data capacitor recharge
+            delayMicroseconds(FIO_SHIFT1_HOLD1_US - FIO_SHIFT1_EDGE_US);
+         }
 		}
       else
       {
-         ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#if defined(FIO_MAX_IRQ_OFF_US) && (FIO_MAX_IRQ_OFF_US < FIO_SHIFT1_LOW0_US)
+         // LOW = 0 Bit, only the edges are protected. An interrupt can only
+         // make the LOW time longer, which still is a 0 Bit as long as it is
+         // well below the latch time.
+         FIO_ATOMIC_BLOCK
+         {
+            fio_digitalWrite_SWITCHTO(shift1Register,shift1Bit,LOW);
+         }
+         delayMicroseconds(FIO_SHIFT1_LOW0_US - FIO_SHIFT1_EDGE_US);
+         FIO_ATOMIC_BLOCK
+         {
+            fio_digitalWrite_SWITCHTO(shift1Register,shift1Bit,HIGH);
+         }
+#else
+         FIO_ATOMIC_BLOCK
          {
             // LOW = 0 Bit
             fio_digitalWrite_SWITCHTO(shift1Register,shift1Bit,LOW);
-            // hold pin LOW for 15us
-            delayMicroseconds(15);
+            // Data capacitor discharge
+            delayMicroseconds(FIO_SHIFT1_LOW0_US - FIO_SHIFT1_EDGE_US);
             fio_digitalWrite_SWITCHTO(shift1Register,shift1Bit,HIGH);
          } // end critical section
-         
-         // hold pin HIGH for 30us
-         delayMicroseconds(30);         
+#endif
+         if(!last)
+         {
+            // Data and latch capacitors recharge
+            delayMicroseconds(FIO_SHIFT1_HOLD0_US - FIO_SHIFT1_EDGE_US);
+         }
 		}
-		if(!noLatch && i==1)
+		if(last)
       {
          break;
       }
@@ -245,19 +318,20 @@ void fio_shiftOut1(fio_register shift1Register, fio_bit shift1Bit, uint8_t value
    
 	if(!noLatch)
    {
-      ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+      FIO_ATOMIC_BLOCK
       {
          // send last bit (=LOW) and Latch command
          fio_digitalWrite_SWITCHTO(shift1Register,shift1Bit,LOW);
       } // end critical section
-      delayMicroseconds(199); 		// Hold pin low for 200us
+      delayMicroseconds(FIO_SHIFT1_LATCH_LOW_US - FIO_SHIFT1_EDGE_US);
       
-      ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+      FIO_ATOMIC_BLOCK
       {
          fio_digitalWrite_HIGH(shift1Register,shift1Bit);
       } // end critical section
-		delayMicroseconds(299);   // Hold pin high for 300us and leave it that 
-      // way - using explicit HIGH here, just in case.
+      // Leave the pin HIGH until the latch capacitor has recharged - using
+      // explicit HIGH here, just in case.
+		delayMicroseconds(FIO_SHIFT1_LATCH_HIGH_US - FIO_SHIFT1_EDGE_US);
 	}
 }
 
@@ -52,6 +52,24 @@ typedef uint32_t fio_bit;
 typedef volatile uint32_t *fio_register;
 
 
+// Cores with 32 bit output registers flanked by set and clear registers.
+// The offsets are in registers (32 bit words) from the output register
+// returned by portOutputRegister.
+#elif defined(ARDUINO_ARCH_SAMD)
+#define FIO_SET_OFFSET   2     // PORT OUTSET
+#define FIO_CLR_OFFSET   1     // PORT OUTCLR
+
+#elif defined(ARDUINO_ARCH_SAM)
+#define FIO_SET_OFFSET   (-2)  // PIO_SODR
+#define FIO_CLR_OFFSET   (-1)  // PIO_CODR
+#define FIO_OWER_OFFSET  26    // PIO_OWER, enables direct PIO_ODSR writes
+
+#elif defined(ARDUINO_ARCH_ESP8266) || defined(ESP8266)
+#define FIO_SET_OFFSET   1     // GPOS
+#define FIO_CLR_OFFSET   2     // GPOC
+// GPIO16 is not on the GPO register, it is written with digitalWrite
+#define FIO_SLOW_PIN(pin) ( (pin) == 16 )
+
 #else
 // fallback to Arduino standard digital i/o routines
 #define FIO_FALLBACK
@@ -61,6 +79,16 @@ typedef uint8_t fio_bit;
 typedef uint8_t fio_register;
 #endif
 
+#if defined(FIO_SET_OFFSET)
+#define FIO_SETCLR
+typedef uint32_t fio_bit;
+#if !defined(FIO_REGISTER)
+// register pointer type, the host test of linux/ replaces it with a mock
+#define FIO_REGISTER volatile uint32_t *
+#endif
+typedef FIO_REGISTER fio_register;
+#endif
+
 
 
 #if !defined(FIO_FALLBACK) && !defined(ATOMIC_BLOCK)
@@ -85,6 +113,76 @@ static __inline__ void __iSeiParam(const uint8_t *__s)
 
 #endif // end of block to create compatible ATOMIC_BLOCK()
 
+/*!
+ @defined 
+ @abstract   Maximum time in microseconds interrupts may be kept disabled.
+ @discussion Not defined by default: the bit banged transports disable
+ interrupts for a whole byte or pulse train to run as fast as possible. When
+ defined (e.g. 2), the critical sections that would be longer than this are
+ split so that only the timing sensitive edges are protected, delays run
+ with interrupts enabled. It trades some throughput for a bounded interrupt
+ latency. Use FIO_IRQ_OFF_MEASURE to size it.
+ */
+//#define FIO_MAX_IRQ_OFF_US 2
+
+/*!
+ @defined 
+ @abstract   Checks if a critical section of a number of cycles is allowed.
+ @discussion Always true if FIO_MAX_IRQ_OFF_US is not defined.
+ */
+#if defined (FIO_MAX_IRQ_OFF_US)
+#define FIO_IRQ_OFF_FITS(cycles) \
+   ( (uint32_t)(cycles) <= (uint32_t)FIO_MAX_IRQ_OFF_US * ( F_CPU / 1000000UL ) )
+#else
+#define FIO_IRQ_OFF_FITS(cycles) ( true )
+#endif
+
+/*!
+ @defined 
+ @abstract   Measures the interrupt-off spans of the fast IO routines.
+ @discussion AVR only. When defined, every FIO_ATOMIC_BLOCK records its
+ length in CPU cycles using Timer1, fio_irqOffWorst reports the longest one.
+ fio_irqOffMeasureStart takes over Timer1 (PWM on its pins and libraries
+ using it stop working), it is meant as a diagnostic build only.
+ */
+//#define FIO_IRQ_OFF_MEASURE
+
+#if defined (FIO_IRQ_OFF_MEASURE) && defined (__AVR__) && defined (TCNT1)
+/*!
+ @function
+ @abstract   Starts measuring the interrupt-off spans.
+ @discussion Sets Timer1 free running at F_CPU and clears the worst span.
+ */
+void fio_irqOffMeasureStart ( void );
+
+/*!
+ @function
+ @abstract   Worst interrupt-off span.
+ @discussion Longest critical section since the last call, measured from
+ inside the section so only a couple of cycles are added by the measurement.
+ Call it after each driver call to get the worst span per call.
+ @param  reset[in] clear the worst span.
+ @result worst span in CPU cycles.
+ */
+uint16_t fio_irqOffWorst ( bool reset = true );
+
+// Critical section hooks, not to be called directly
+void fio_irqOffEnd ( const uint16_t *start );
+
+#define FIO_ATOMIC_BLOCK \
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) \
+   for ( uint16_t __fio_start __attribute__((__cleanup__(fio_irqOffEnd))) = TCNT1, \
+         __fio_todo = 1; __fio_todo; __fio_todo = 0 )
+#else
+/*!
+ @defined 
+ @abstract   Critical section of the bit banged transports.
+ @discussion ATOMIC_BLOCK(ATOMIC_RESTORESTATE), instrumented when
+ FIO_IRQ_OFF_MEASURE is defined.
+ */
+#define FIO_ATOMIC_BLOCK ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#endif
+
 /*!
  @defined 
  @abstract   Performs a bitwise shift.
@@ -99,10 +197,37 @@ static __inline__ void __iSeiParam(const uint8_t *__s)
 #define _BV(bit) (1 << (bit))
 #endif
 
+/*!
+ @function
+ @abstract   Busy waits for at least NS nanoseconds.
+ @discussion The number of CPU cycles is computed at compile time from F_CPU
+ and rounded up, the delay is therefore as close as possible to NS at any
+ clock speed. On AVR the wait is emitted inline as an exact cycle count of
+ NOPs and loops, delays shorter than a cycle compile to a single NOP. Other
+ architectures wait the rounded up number of microseconds.
+
+ Usage: fio_delay_ns<450>();
+ @templatefield NS   minimum delay in nanoseconds (up to 1ms).
+ */
+template <uint32_t NS>
+inline void fio_delay_ns ( void ) __attribute__((always_inline));
+
+template <uint32_t NS>
+inline void fio_delay_ns ( void )
+{
+#if defined (__AVR__)
+   __builtin_avr_delay_cycles ( (uint32_t)
+      ( ( (uint64_t)NS * F_CPU + 999999999ULL ) / 1000000000ULL ) );
+#else
+   delayMicroseconds ( ( NS + 999 ) / 1000 );
+#endif
+}
+
 /*!
  @function
  @abstract  Get the output register for specified pin.
- @discussion if fast digital IO is disabled this function returns NULL
+ @discussion if fast digital IO is disabled, or the pin is not on the output
+ registers of the port (FIO_SLOW_PIN), this function returns NULL
  @param  pin[in] Number of a digital pin
  @result  Register
  */
@@ -111,7 +236,8 @@ fio_register fio_pinToOutputRegister(uint8_t pin, uint8_t initial_state = LOW);
 /*!
  @function
  @abstract  Get the input register for specified pin.
- @discussion if fast digital IO is disabled this function returns NULL
+ @discussion if fast digital IO is disabled, or the pin is not on the
+ registers of the port (FIO_SLOW_PIN), this function returns NULL
  @param  pin[in] Number of a digital pin
  @result  Register
  */
@@ -120,7 +246,8 @@ fio_register fio_pinToInputRegister(uint8_t pin);
 /*!
  @function
  @abstract Find the bit which belongs to specified pin
- @discussion if fast digitalWrite is disabled this function returns the pin
+ @discussion if fast digitalWrite is disabled, or the pin is not on the
+ registers of the port (FIO_SLOW_PIN), this function returns the pin
  @param pin[in] Number of a digital pin
  @result Bit
  */
@@ -145,7 +272,33 @@ void fio_digitalWrite ( fio_register pinRegister, fio_bit pinBit, uint8_t value
  * SWITCH is fast for FIO but probably slow for FIO_FALLBACK so SWITCHTO is recommended if the value is known.
  */
 
-#ifndef FIO_FALLBACK
+#if defined(FIO_SETCLR) && defined(FIO_SLOW_PIN)
+// single store to the set/clear registers, no read-modify-write. The pins
+// off the registers (FIO_SLOW_PIN) have a NULL register and their pin as bit.
+#define fio_digitalWrite_LOW(reg,bit) \
+   do { if ((reg) != 0) { *((reg) + FIO_CLR_OFFSET) = (bit); } \
+        else { digitalWrite((bit),LOW); } } while (0)
+#define fio_digitalWrite_HIGH(reg,bit) \
+   do { if ((reg) != 0) { *((reg) + FIO_SET_OFFSET) = (bit); } \
+        else { digitalWrite((bit),HIGH); } } while (0)
+#define fio_digitalWrite_SWITCH(reg,bit) \
+   do { if ((reg) == 0) { digitalWrite((bit), !digitalRead(bit)); } \
+        else if (*(reg) & (bit)) { *((reg) + FIO_CLR_OFFSET) = (bit); } \
+        else { *((reg) + FIO_SET_OFFSET) = (bit); } } while (0)
+#define fio_digitalWrite_SWITCHTO(reg,bit,val) \
+   do { if (val) { fio_digitalWrite_HIGH(reg,bit); } \
+        else { fio_digitalWrite_LOW(reg,bit); } } while (0)
+#elif defined(FIO_SETCLR)
+// single store to the set/clear registers, no read-modify-write
+#define fio_digitalWrite_LOW(reg,bit) *((reg) + FIO_CLR_OFFSET) = (bit)
+#define fio_digitalWrite_HIGH(reg,bit) *((reg) + FIO_SET_OFFSET) = (bit)
+#define fio_digitalWrite_SWITCH(reg,bit) \
+   do { if (*(reg) & (bit)) { fio_digitalWrite_LOW(reg,bit); } \
+        else { fio_digitalWrite_HIGH(reg,bit); } } while (0)
+#define fio_digitalWrite_SWITCHTO(reg,bit,val) \
+   do { if (val) { fio_digitalWrite_HIGH(reg,bit); } \
+        else { fio_digitalWrite_LOW(reg,bit); } } while (0)
+#elif !defined(FIO_FALLBACK)
 #define fio_digitalWrite_LOW(reg,bit) *reg &= ~bit
 #define fio_digitalWrite_HIGH(reg,bit) *reg |= bit
 #define fio_digitalWrite_SWITCH(reg,bit) *reg ^= bit
@@ -172,7 +325,8 @@ int fio_digitalRead ( fio_register pinRegister, fio_bit pinBit );
 /*!
  @method
  @abstract faster shift out
- @discussion using fast digital write
+ @discussion using fast digital write, bit order selected at runtime. Prefer
+ fio_shiftOut<bitOrder> when the bit order is known at compile time.
  @discussion falls back to normal digitalWrite if fastio is disabled
  @param dataRegister[in] Register of data pin - ignored if fast digital write is disabled
  @param dataBit[in] Bit of data pin - Pin if fast digital write is disabled
@@ -183,6 +337,117 @@ int fio_digitalRead ( fio_register pinRegister, fio_bit pinBit );
 void fio_shiftOut( fio_register dataRegister, fio_bit dataBit, fio_register clockRegister, 
                   fio_bit clockBit, uint8_t value, uint8_t bitOrder );
 
+/*!
+ @method
+ @abstract unrolled shift out with the bit order fixed at compile time
+ @discussion The 8 bits are unrolled and interrupts are disabled once per
+ byte. The data and clock registers are read once and only precomputed
+ values are stored afterwards, when data and clock share a port the clock
+ fall and the next data bit are a single store. Interrupts stay disabled
+ for about 40 to 60 CPU cycles per byte (3-4us at 16MHz), or once per bit
+ if that is over FIO_MAX_IRQ_OFF_US. On cores with
+ set/clear registers every edge is a single store and interrupts are left
+ enabled.
+ @discussion falls back to shiftOut if fastio is disabled
+ @templatefield BIT_ORDER bit order (MSBFIRST, LSBFIRST)
+ @param dataRegister[in] Register of data pin - ignored if fast digital write is disabled
+ @param dataBit[in] Bit of data pin - Pin if fast digital write is disabled
+ @param clockRegister[in] Register of data pin - ignored if fast digital write is disabled
+ @param clockBit[in] Bit of data pin - Pin if fast digital write is disabled
+ @param value[in] byte to shift out
+ */
+template <uint8_t BIT_ORDER>
+inline void fio_shiftOut ( fio_register dataRegister, fio_bit dataBit,
+                           fio_register clockRegister, fio_bit clockBit,
+                           uint8_t value ) __attribute__((always_inline));
+
+// Worst case length in cycles of the single critical section of fio_shiftOut
+#define FIO_SHIFTOUT_CYCLES  64
+
+// Mask of the n-th bit shifted out
+#define FIO_SHIFT_MASK(n) ( ( BIT_ORDER == LSBFIRST ) ? ( 1 << (n) ) : ( 0x80 >> (n) ) )
+
+template <uint8_t BIT_ORDER>
+inline void fio_shiftOut ( fio_register dataRegister, fio_bit dataBit,
+                           fio_register clockRegister, fio_bit clockBit,
+                           uint8_t value )
+{
+#if defined(FIO_FALLBACK)
+   shiftOut ( dataBit, clockBit, BIT_ORDER, value );
+#elif defined(FIO_SETCLR)
+   // Set and clear registers only touch the pin, no critical section needed
+#define FIO_SHIFT_BIT(n) \
+   if ( value & FIO_SHIFT_MASK(n) ) { fio_digitalWrite_HIGH ( dataRegister, dataBit ); } \
+   else                             { fio_digitalWrite_LOW ( dataRegister, dataBit ); } \
+   fio_digitalWrite_HIGH ( clockRegister, clockBit ); \
+   fio_digitalWrite_LOW ( clockRegister, clockBit );
+   
+   FIO_SHIFT_BIT(0) FIO_SHIFT_BIT(1) FIO_SHIFT_BIT(2) FIO_SHIFT_BIT(3)
+   FIO_SHIFT_BIT(4) FIO_SHIFT_BIT(5) FIO_SHIFT_BIT(6) FIO_SHIFT_BIT(7)
+#undef FIO_SHIFT_BIT
+#else
+   if ( !FIO_IRQ_OFF_FITS ( FIO_SHIFTOUT_CYCLES ) )
+   {
+      // One critical section per bit, reading the registers again each time
+#define FIO_SHIFT_BIT(n) \
+      FIO_ATOMIC_BLOCK \
+      { \
+         if ( value & FIO_SHIFT_MASK(n) ) { fio_digitalWrite_HIGH ( dataRegister, dataBit ); } \
+         else                             { fio_digitalWrite_LOW ( dataRegister, dataBit ); } \
+         fio_digitalWrite_HIGH ( clockRegister, clockBit ); \
+         fio_digitalWrite_LOW ( clockRegister, clockBit ); \
+      }
+      
+      FIO_SHIFT_BIT(0) FIO_SHIFT_BIT(1) FIO_SHIFT_BIT(2) FIO_SHIFT_BIT(3)
+      FIO_SHIFT_BIT(4) FIO_SHIFT_BIT(5) FIO_SHIFT_BIT(6) FIO_SHIFT_BIT(7)
+#undef FIO_SHIFT_BIT
+      return;
+   }
+   
+   FIO_ATOMIC_BLOCK
+   {
+      if ( dataRegister == clockRegister )
+      {
+         // The clock fall is stored together with the next data bit, the
+         // data changes after the rising edge has clocked it in.
+         fio_bit low  = *dataRegister & ~( dataBit | clockBit );
+         fio_bit high = low | dataBit;
+         fio_bit out;
+         
+#define FIO_SHIFT_BIT_PORT(n) \
+         out = ( value & FIO_SHIFT_MASK(n) ) ? high : low; \
+         *dataRegister = out; \
+         *dataRegister = out | clockBit;
+         
+         FIO_SHIFT_BIT_PORT(0) FIO_SHIFT_BIT_PORT(1)
+         FIO_SHIFT_BIT_PORT(2) FIO_SHIFT_BIT_PORT(3)
+         FIO_SHIFT_BIT_PORT(4) FIO_SHIFT_BIT_PORT(5)
+         FIO_SHIFT_BIT_PORT(6) FIO_SHIFT_BIT_PORT(7)
+         *dataRegister = out;
+#undef FIO_SHIFT_BIT_PORT
+      }
+      else
+      {
+         fio_bit dataLow   = *dataRegister & ~dataBit;
+         fio_bit dataHigh  = dataLow | dataBit;
+         fio_bit clockLow  = *clockRegister & ~clockBit;
+         fio_bit clockHigh = clockLow | clockBit;
+         
+#define FIO_SHIFT_BIT(n) \
+         *dataRegister  = ( value & FIO_SHIFT_MASK(n) ) ? dataHigh : dataLow; \
+         *clockRegister = clockHigh; \
+         *clockRegister = clockLow;
+         
+         FIO_SHIFT_BIT(0) FIO_SHIFT_BIT(1) FIO_SHIFT_BIT(2) FIO_SHIFT_BIT(3)
+         FIO_SHIFT_BIT(4) FIO_SHIFT_BIT(5) FIO_SHIFT_BIT(6) FIO_SHIFT_BIT(7)
+#undef FIO_SHIFT_BIT
+      }
+   }
+#endif
+}
+
+#undef FIO_SHIFT_MASK
+
 /*!
  @method
  @abstract faster shift out clear
@@ -195,13 +460,43 @@ void fio_shiftOut( fio_register dataRegister, fio_bit dataBit, fio_register cloc
  */
 void fio_shiftOut(fio_register dataRegister, fio_bit dataBit, fio_register clockRegister, fio_bit clockBit);
 
+/*!
+ @defined 
+ @abstract   Shift1 protocol timing in microseconds.
+ @discussion Per bit budgets of the Shift1 RC network, Roman Black's values
+ for the reference circuit. A 1 bit is a short LOW pulse followed by a HIGH
+ hold (HOLD1), a 0 bit a LOW of LOW0 followed by a HIGH hold of HOLD0; the
+ latch is a LOW of LATCH_LOW and a HIGH of LATCH_HIGH. EDGE is the time
+ taken by the edges and the loop, it is taken off each hold. Override them
+ before including FastIO.h to match other RC values.
+ */
+#ifndef FIO_SHIFT1_HOLD1_US
+#define FIO_SHIFT1_HOLD1_US      15
+#endif
+#ifndef FIO_SHIFT1_LOW0_US
+#define FIO_SHIFT1_LOW0_US       15
+#endif
+#ifndef FIO_SHIFT1_HOLD0_US
+#define FIO_SHIFT1_HOLD0_US      30
+#endif
+#ifndef FIO_SHIFT1_LATCH_LOW_US
+#define FIO_SHIFT1_LATCH_LOW_US  200
+#endif
+#ifndef FIO_SHIFT1_LATCH_HIGH_US
+#define FIO_SHIFT1_LATCH_HIGH_US 300
+#endif
+#define FIO_SHIFT1_EDGE_US       1
+
 /*!
  * @method
  * @abstract one wire shift out
- * @discussion protocol needs initialisation (fio_shiftOut1_init)
+ * @discussion protocol needs initialisation (fio_shiftOut1_init). With
+ * noLatch all the 8 bits are shifted and the outputs are not latched, to
+ * load chained shift registers: the last call latches them all.
  * @param shift1Register[in] pins register
  * @param shift1Bit[in] pins bit
  * @param value[in] value to shift out, last byte is ignored and always shifted out LOW
+ * @param noLatch[in] shift the 8 bits without latching
  */
 void fio_shiftOut1(fio_register shift1Register, fio_bit shift1Bit, uint8_t value, boolean noLatch = false);
 /*!
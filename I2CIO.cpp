@@ -30,7 +30,12 @@
    #include <Arduino.h>
 #endif
 
-#if defined(__AVR_ATtiny84__) || (__AVR_ATtiny2313__) || defined (__AVR_ATtiny85__)
+#include "TwiAsync.h"
+
+#if defined (TWI_ASYNC)
+#define Wire WireAsync
+
+#elif defined(__AVR_ATtiny84__) || (__AVR_ATtiny2313__) || defined (__AVR_ATtiny85__)
 #include "TinyWireM.h" // include this if ATtiny84 or ATtiny85 or ATtiny2313
 
 #define Wire TinyWireM
@@ -62,6 +67,7 @@ I2CIO::I2CIO ( )
    _dirMask     = 0xFF;    // mark all as INPUTs
    _shadow      = 0x0;     // no values set
    _initialised = false;
+   _deferred    = false;
 }
 
 // PUBLIC METHODS
@@ -166,6 +172,60 @@ int I2CIO::write ( uint8_t value )
    return ( (status == 0) );
 }
 
+//
+// write
+int I2CIO::write ( const uint8_t *values, uint8_t len )
+{
+   int status = 0;
+
+   if ( _initialised )
+   {
+      Wire.beginTransmission ( _i2cAddr );
+      for ( uint8_t i = 0; i < len; i++ )
+      {
+         _shadow = ( values[i] & ~(_dirMask) );
+#if (ARDUINO <  100)
+         Wire.send ( _shadow );
+#else
+         Wire.write ( _shadow );
+#endif
+      }
+      status = Wire.endTransmission ();
+   }
+   return ( (status == 0) );
+}
+
+//
+// busy
+bool I2CIO::busy ( void )
+{
+#if defined (TWI_ASYNC)
+   return ( Wire.busy ( ) );
+#else
+   return ( false );
+#endif
+}
+
+//
+// flush
+int I2CIO::flush ( void )
+{
+#if defined (TWI_ASYNC)
+   return ( Wire.flush ( ) == 0 );
+#else
+   return ( 1 );
+#endif
+}
+
+//
+// onFlushDone
+void I2CIO::onFlushDone ( t_twiFlushDone callback )
+{
+#if defined (TWI_ASYNC)
+   Wire.onFlushDone ( callback );
+#endif
+}
+
 //
 // digitalRead
 uint8_t I2CIO::digitalRead ( uint8_t pin )
@@ -187,30 +247,56 @@ uint8_t I2CIO::digitalRead ( uint8_t pin )
 // digitalWrite
 int I2CIO::digitalWrite ( uint8_t pin, uint8_t level )
 {
-   uint8_t writeVal;
    int status = 0;
 
    // Check if initialised and that the pin is within range of the device
    // -------------------------------------------------------------------
    if ( ( _initialised ) && ( pin <= 7 ) )
    {
-      // Only write to HIGH the port if the port has been configured as
-      // an OUTPUT pin. Add the new state of the pin to the shadow
-      writeVal = ( 1 << pin ) & ~_dirMask;
-      if ( level == HIGH )
-      {
-         _shadow |= writeVal;
+      status = writeMasked ( ( 1 << pin ), ( level == HIGH ) ? 0xFF : 0x00 );
+   }
+   return ( status );
+}
 
+//
+// writeMasked
+int I2CIO::writeMasked ( uint8_t mask, uint8_t values )
+{
+   int status = 0;
+   
+   if ( _initialised )
+   {
+      // Only write to HIGH the ports that have been configured as OUTPUT
+      // pins. Update the pins in the mask in the shadow
+      mask &= ~_dirMask;
+      _shadow = ( _shadow & ~mask ) | ( values & mask );
+      
+      if ( _deferred )
+      {
+         status = 1;
       }
       else
       {
-         _shadow &= ~writeVal;
+         status = this->write ( _shadow );
       }
-      status = this->write ( _shadow );
    }
    return ( status );
 }
 
+//
+// setDeferredCommit
+void I2CIO::setDeferredCommit ( bool deferred )
+{
+   _deferred = deferred;
+}
+
+//
+// commit
+int I2CIO::commit ( void )
+{
+   return ( this->write ( _shadow ) );
+}
+
 //
 // PRIVATE METHODS
 // ---------------------------------------------------------------------------
@@ -220,6 +306,10 @@ bool I2CIO::isAvailable (uint8_t i2cAddr)
 
    Wire.beginTransmission( i2cAddr );
    error = Wire.endTransmission();
+#if defined (TWI_ASYNC)
+   // The transaction has only been queued, wait for the acknowledge
+   error = Wire.flush();
+#endif
    if (error==0)
    {
      return true;
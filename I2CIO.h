@@ -28,6 +28,7 @@
 #define _I2CIO_H_
 
 #include <inttypes.h>
+#include "TwiAsync.h"
 
 #define _I2CIO_VERSION "1.0.0"
 
@@ -122,6 +123,52 @@ public:
     */   
    int write ( uint8_t value );
    
+   /*!
+    @method
+    @abstract   Write a sequence of values to the device.
+    @discussion Writes len values to the device in a single I2C transaction,
+    the device port will take each value in turn. Values are masked with the
+    direction of the pins as in write(uint8_t).
+    
+    @param      values[in] values to be written to the device.
+    @param      len[in] number of values to write (up to 32).
+    @result     1 on success, 0 otherwise
+    */   
+   int write ( const uint8_t *values, uint8_t len );
+   
+   /*!
+    @method
+    @abstract   Checks if there are writes pending to be sent to the device.
+    @discussion With the interrupt driven transport (TWI_ASYNC) writes return
+    as soon as they have been queued. This method checks if the bus is still
+    sending them. In blocking mode it always returns false.
+    
+    @result     true if there are writes pending, false otherwise.
+    */
+   bool busy ( void );
+   
+   /*!
+    @method
+    @abstract   Waits for all the pending writes to be sent.
+    @discussion In blocking mode writes have always been sent and the method
+    returns immediately.
+    
+    @result     1 if all the writes since the last flush were acknowledged, 0
+    otherwise.
+    */
+   int flush ( void );
+   
+   /*!
+    @method
+    @abstract   Sets a callback for when the pending writes have been sent.
+    @discussion The callback is shared by all the devices on the bus and is
+    called from the TWI interrupt. It is only used with the interrupt driven
+    transport (TWI_ASYNC), in blocking mode the callback is ignored.
+    
+    @param      callback[in] function to call, NULL to disable it.
+    */
+   void onFlushDone ( t_twiFlushDone callback );
+   
    /*!
     @method
     @abstract   Writes a digital level to a particular pin.
@@ -135,6 +182,42 @@ public:
     */   
    int digitalWrite ( uint8_t pin, uint8_t level );
    
+   /*!
+    @method
+    @abstract   Writes a set of pins of the device at once.
+    @discussion Updates the level of all the pins in mask with the values of
+    the corresponding bits in values, in a single transaction. Pins not in
+    mask keep their current level. As with digitalWrite, only pins configured
+    as OUTPUT are changed.
+    
+    @param      mask[in] pins to update, bit n represents pin n.
+    @param      values[in] levels of the pins to update.
+    @result     1 on success, 0 otherwise.
+    */
+   int writeMasked ( uint8_t mask, uint8_t values );
+   
+   /*!
+    @method
+    @abstract   Enables or disables the deferred commit mode.
+    @discussion In deferred commit mode digitalWrite and writeMasked only
+    update the output shadow of the device, the changes are written to the
+    device by calling commit. This allows any number of pin changes to be
+    sent in a single transaction.
+    
+    @param      deferred[in] true to defer the writes, false to write straight
+    away (default).
+    */
+   void setDeferredCommit ( bool deferred );
+   
+   /*!
+    @method
+    @abstract   Writes the pending pin changes to the device.
+    @discussion Writes the output shadow of the device. @see setDeferredCommit.
+    
+    @result     1 on success, 0 otherwise.
+    */
+   int commit ( void );
+   
    
    
 private:
@@ -142,6 +225,7 @@ private:
    uint8_t _dirMask;     // Direction mask
    uint8_t _i2cAddr;     // I2C address
    bool    _initialised; // Initialised object
+   bool    _deferred;    // Writes deferred until commit
 
   /*!
    @method
@@ -0,0 +1,379 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file I2CIO_MCP23008.cpp
+// This file implements a basic IO library using the MCP23008 I2C IO Expander
+// chip.
+//
+// @brief
+// Implement a basic IO library to drive the MCP23008 I2C IO Expander ASIC
+// with the same interface as the I2CIO class for the PCF8574.
+//
+// @version API 1.0.0
+//
+// ---------------------------------------------------------------------------
+#if (ARDUINO <  100)
+   #include <WProgram.h>
+#else
+   #include <Arduino.h>
+#endif
+
+#include "TwiAsync.h"
+
+#if defined (TWI_ASYNC)
+#define Wire WireAsync
+#define MCP23008_SET_CLOCK
+
+#elif defined(__AVR_ATtiny84__) || (__AVR_ATtiny2313__) || defined (__AVR_ATtiny85__)
+#include "TinyWireM.h" // include this if ATtiny84 or ATtiny85 or ATtiny2313
+
+#define Wire TinyWireM
+#else
+
+#if (ARDUINO < 10000)
+   #include <../Wire/Wire.h>
+#else
+   #include <Wire.h>
+#endif
+
+#if (ARDUINO >= 157)
+#define MCP23008_SET_CLOCK    // Wire.setClock available
+#endif
+
+#endif
+
+#include <inttypes.h>
+
+#include "I2CIO_MCP23008.h"
+
+// CONSTANT DEFINITIONS
+// ---------------------------------------------------------------------------
+// MCP23008 registers
+#define MCP23008_IODIR   0x00
+#define MCP23008_IOCON   0x05
+#define MCP23008_GPPU    0x06
+#define MCP23008_GPIO    0x09
+#define MCP23008_OLAT    0x0A
+
+// IOCON sequential operation disabled, address pointer does not increment
+#define MCP23008_SEQOP   0x20
+
+#ifndef INPUT_PULLUP
+#define INPUT_PULLUP     0x2
+#endif
+
+
+// CONSTRUCTOR
+// ---------------------------------------------------------------------------
+I2CIO_MCP23008::I2CIO_MCP23008 ( )
+{
+   _i2cAddr     = 0x0;
+   _dirMask     = 0xFF;    // mark all as INPUTs
+   _shadow      = 0x0;     // no values set
+   _initialised = false;
+   _deferred    = false;
+   _pullUps     = 0x0;     // no pull-ups
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+int I2CIO_MCP23008::begin (  uint8_t i2cAddr )
+{
+   _i2cAddr = i2cAddr;
+
+   Wire.begin ( );
+#if defined (MCP23008_SET_CLOCK) && ( MCP23008_I2C_FREQ != 0 )
+   Wire.setClock ( MCP23008_I2C_FREQ );
+#endif
+
+   _initialised = isAvailable ( _i2cAddr );
+
+   if (_initialised)
+   {
+      // Disable the address pointer auto-increment for the burst writes and
+      // set all the pins as inputs without pull-ups.
+      _dirMask = 0xFF;
+      _pullUps = 0x0;
+      _initialised = writeRegister ( MCP23008_IOCON, MCP23008_SEQOP );
+      _initialised &= writeRegister ( MCP23008_IODIR, _dirMask );
+      _initialised &= writeRegister ( MCP23008_GPPU, _pullUps );
+
+      // Get the current state of the output latch
+      Wire.beginTransmission ( _i2cAddr );
+#if (ARDUINO <  100)
+      Wire.send ( MCP23008_OLAT );
+#else
+      Wire.write ( MCP23008_OLAT );
+#endif
+      Wire.endTransmission ( );
+      Wire.requestFrom ( _i2cAddr, (uint8_t)1 );
+#if (ARDUINO <  100)
+      _shadow = Wire.receive ();
+#else
+      _shadow = Wire.read ();
+#endif
+   }
+   return ( _initialised );
+}
+
+//
+// pinMode
+void I2CIO_MCP23008::pinMode ( uint8_t pin, uint8_t dir )
+{
+   if ( _initialised )
+   {
+      if ( OUTPUT == dir )
+      {
+         _dirMask &= ~( 1 << pin );
+      }
+      else
+      {
+         _dirMask |= ( 1 << pin );
+      }
+
+      if ( INPUT_PULLUP == dir )
+      {
+         _pullUps |= ( 1 << pin );
+      }
+      else
+      {
+         _pullUps &= ~( 1 << pin );
+      }
+      writeRegister ( MCP23008_GPPU, _pullUps );
+      writeRegister ( MCP23008_IODIR, _dirMask );
+   }
+}
+
+//
+// portMode
+void I2CIO_MCP23008::portMode ( uint8_t dir )
+{
+
+   if ( _initialised )
+   {
+      if ( dir == OUTPUT )
+      {
+         _dirMask = 0x00;
+      }
+      else
+      {
+         _dirMask = 0xFF;
+      }
+      _pullUps = ( dir == INPUT_PULLUP ) ? 0xFF : 0x00;
+      writeRegister ( MCP23008_GPPU, _pullUps );
+      writeRegister ( MCP23008_IODIR, _dirMask );
+   }
+}
+
+//
+// read
+uint8_t I2CIO_MCP23008::read ( void )
+{
+   uint8_t retVal = 0;
+
+   if ( _initialised )
+   {
+      Wire.beginTransmission ( _i2cAddr );
+#if (ARDUINO <  100)
+      Wire.send ( MCP23008_GPIO );
+#else
+      Wire.write ( MCP23008_GPIO );
+#endif
+      Wire.endTransmission ( );
+      Wire.requestFrom ( _i2cAddr, (uint8_t)1 );
+#if (ARDUINO <  100)
+      retVal = ( _dirMask & Wire.receive ( ) );
+#else
+      retVal = ( _dirMask & Wire.read ( ) );
+#endif
+   }
+   return ( retVal );
+}
+
+//
+// write
+int I2CIO_MCP23008::write ( uint8_t value )
+{
+   return ( write ( &value, 1 ) );
+}
+
+//
+// write
+int I2CIO_MCP23008::write ( const uint8_t *values, uint8_t len )
+{
+   int status = 0;
+
+   // A longer transaction would be truncated by the Wire buffer
+   if ( len > MCP23008_BURST_MAX )
+   {
+      return ( 0 );
+   }
+
+   if ( _initialised )
+   {
+      // The address pointer stays on GPIO, every byte of the transaction is
+      // written to the port in turn.
+      Wire.beginTransmission ( _i2cAddr );
+#if (ARDUINO <  100)
+      Wire.send ( MCP23008_GPIO );
+#else
+      Wire.write ( MCP23008_GPIO );
+#endif
+      for ( uint8_t i = 0; i < len; i++ )
+      {
+         // Only write HIGH the values of the ports that have been initialised
+         // as outputs updating the output shadow of the device
+         _shadow = ( values[i] & ~(_dirMask) );
+#if (ARDUINO <  100)
+         Wire.send ( _shadow );
+#else
+         Wire.write ( _shadow );
+#endif
+      }
+      status = Wire.endTransmission ();
+   }
+   return ( (status == 0) );
+}
+
+//
+// busy
+bool I2CIO_MCP23008::busy ( void )
+{
+#if defined (TWI_ASYNC)
+   return ( Wire.busy ( ) );
+#else
+   return ( false );
+#endif
+}
+
+//
+// flush
+int I2CIO_MCP23008::flush ( void )
+{
+#if defined (TWI_ASYNC)
+   return ( Wire.flush ( ) == 0 );
+#else
+   return ( 1 );
+#endif
+}
+
+//
+// onFlushDone
+void I2CIO_MCP23008::onFlushDone ( t_twiFlushDone callback )
+{
+#if defined (TWI_ASYNC)
+   Wire.onFlushDone ( callback );
+#endif
+}
+
+//
+// digitalRead
+uint8_t I2CIO_MCP23008::digitalRead ( uint8_t pin )
+{
+   uint8_t pinVal = 0;
+
+   // Check if initialised and that the pin is within range of the device
+   // -------------------------------------------------------------------
+   if ( ( _initialised ) && ( pin <= 7 ) )
+   {
+      // Remove the values which are not inputs and get the value of the pin
+      pinVal = this->read() & _dirMask;
+      pinVal = ( pinVal >> pin ) & 0x01; // Get the pin value
+   }
+   return (pinVal);
+}
+
+//
+// digitalWrite
+int I2CIO_MCP23008::digitalWrite ( uint8_t pin, uint8_t level )
+{
+   int status = 0;
+
+   // Check if initialised and that the pin is within range of the device
+   // -------------------------------------------------------------------
+   if ( ( _initialised ) && ( pin <= 7 ) )
+   {
+      status = writeMasked ( ( 1 << pin ), ( level == HIGH ) ? 0xFF : 0x00 );
+   }
+   return ( status );
+}
+
+//
+// writeMasked
+int I2CIO_MCP23008::writeMasked ( uint8_t mask, uint8_t values )
+{
+   int status = 0;
+
+   if ( _initialised )
+   {
+      // Only write to HIGH the ports that have been configured as OUTPUT
+      // pins. Update the pins in the mask in the shadow
+      mask &= ~_dirMask;
+      _shadow = ( _shadow & ~mask ) | ( values & mask );
+
+      if ( _deferred )
+      {
+         status = 1;
+      }
+      else
+      {
+         status = this->write ( _shadow );
+      }
+   }
+   return ( status );
+}
+
+//
+// setDeferredCommit
+void I2CIO_MCP23008::setDeferredCommit ( bool deferred )
+{
+   _deferred = deferred;
+}
+
+//
+// commit
+int I2CIO_MCP23008::commit ( void )
+{
+   return ( this->write ( _shadow ) );
+}
+
+//
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+bool I2CIO_MCP23008::isAvailable (uint8_t i2cAddr)
+{
+   int error;
+
+   Wire.beginTransmission( i2cAddr );
+   error = Wire.endTransmission();
+#if defined (TWI_ASYNC)
+   // The transaction has only been queued, wait for the acknowledge
+   error = Wire.flush();
+#endif
+   return ( error == 0 );
+}
+
+//
+// writeRegister
+int I2CIO_MCP23008::writeRegister ( uint8_t reg, uint8_t value )
+{
+   Wire.beginTransmission ( _i2cAddr );
+#if (ARDUINO <  100)
+   Wire.send ( reg );
+   Wire.send ( value );
+#else
+   Wire.write ( reg );
+   Wire.write ( value );
+#endif
+   return ( Wire.endTransmission ( ) == 0 );
+}
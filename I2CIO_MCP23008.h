@@ -0,0 +1,276 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no 
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file I2CIO_MCP23008.h
+// This file implements a basic IO library using the MCP23008 I2C IO Expander
+// chip.
+// 
+// @brief 
+// Implement a basic IO library to drive the MCP23008 I2C IO Expander ASIC
+// with the same interface as the I2CIO class for the PCF8574.
+// The device is configured with the address pointer auto-increment disabled
+// (IOCON.SEQOP set), so a single I2C transaction can write the GPIO register
+// any number of times. This is used by the burst writes.
+//
+// @version API 1.0.0
+//
+// ---------------------------------------------------------------------------
+
+#ifndef _I2CIO_MCP23008_H_
+#define _I2CIO_MCP23008_H_
+
+#include <inttypes.h>
+#include "TwiAsync.h"
+
+#define _I2CIO_MCP23008_VERSION "1.0.0"
+
+/*!
+ @defined
+ @abstract   I2C bus frequency used with the MCP23008.
+ @discussion By default (0) begin leaves the bus frequency unchanged, the bus
+ may be shared with devices rated for 100kHz only such as the PCF8574. The
+ MCP23008 supports fast mode I2C: to use it, call Wire.setClock(400000L)
+ after begin, or define MCP23008_I2C_FREQ to 400000L in the compiler flags
+ of the library for begin to set it.
+ */
+#ifndef MCP23008_I2C_FREQ
+#define MCP23008_I2C_FREQ 0
+#endif
+
+/*!
+ @defined
+ @abstract   Maximum number of values of a burst write.
+ @discussion The GPIO register address takes one byte of the 32 byte Wire
+ buffer (BUFFER_LENGTH, TWI_ASYNC_TX_LENGTH with TWI_ASYNC).
+ */
+#define MCP23008_BURST_MAX 31
+
+/*!
+ @class
+ @abstract    I2CIO_MCP23008
+ @discussion  Library driver to control MCP23008 based ASICs. Implementing
+ library calls to set/get port through I2C bus.
+ */
+
+class I2CIO_MCP23008  
+{
+public:
+   /*!
+    @method     
+    @abstract   Constructor method
+    @discussion Class constructor constructor. 
+    */
+   I2CIO_MCP23008 ( );
+   
+   /*!
+    @method
+    @abstract   Initializes the device.
+    @discussion This method initializes the device allocating an I2C address.
+    This method is the first method that should be call prior to calling any
+    other method form this class. On initialization all pins are configured
+    as INPUT on the device with the pull-ups disabled, and the address pointer
+    auto-increment is disabled.
+    
+    @param      i2cAddr: I2C Address where the device is located.
+    @result     1 if the device was initialized correctly, 0 otherwise
+    */   
+   int begin ( uint8_t i2cAddr );
+   
+   /*!
+    @method
+    @abstract   Sets the mode of a particular pin.
+    @discussion Sets the mode of a particular pin to INPUT, INPUT_PULLUP or
+    OUTPUT updating the IODIR and GPPU registers of the device. digitalWrite
+    has no effect on pins which are not declared as output.
+    
+    @param      pin[in] Pin from the I2C IO expander to be configured. Range 0..7
+    @param      dir[in] Pin direction (INPUT, INPUT_PULLUP, OUTPUT).
+    */   
+   void pinMode ( uint8_t pin, uint8_t dir );
+   
+   /*!
+    @method
+    @abstract   Sets all the pins of the device in a particular direction.
+    @discussion This method sets all the pins of the device in a particular
+    direction. This method is useful to set all the pins of the device to be
+    either inputs or outputs.
+    @param      dir[in] Direction of all the pins of the device (INPUT, OUTPUT).
+    */
+   void portMode ( uint8_t dir );
+   
+   /*!
+    @method
+    @abstract   Reads all the pins of the device that are configured as INPUT.
+    @discussion Reads from the device the status of the pins that are configured
+    as INPUT. During initialization all pins are configured as INPUTs by default.
+    Please refer to pinMode or portMode.
+    
+    @param      none
+    */   
+   uint8_t read ( void );
+   
+   /*!
+    @method
+    @abstract   Read a pin from the device.
+    @discussion Reads a particular pin from the device. To read a particular
+    pin it has to be configured as INPUT. During initialization all pins are
+    configured as INPUTs by default. Please refer to pinMode or portMode.
+    
+    @param      pin[in] Pin from the port to read its status. Range (0..7)
+    @result     Returns the pin status (HIGH, LOW) if the pin is configured
+    as an output, reading its value will always return LOW regardless of its
+    real state.
+    */
+   uint8_t digitalRead ( uint8_t pin );
+   
+   /*!
+    @method
+    @abstract   Write a value to the device.
+    @discussion Writes to a set of pins in the device. The value is the binary
+    representation of all the pins in device. The value written is masked with 
+    the configuration of the direction of the pins; to change the state of
+    a particular pin with this method, such pin has to be configured as OUTPUT 
+    using the portMode or pinMode methods. If no pins have been configured as
+    OUTPUTs this method will have no effect.
+    
+    @param      value[in] value to be written to the device.
+    @result     1 on success, 0 otherwise
+    */   
+   int write ( uint8_t value );
+   
+   /*!
+    @method
+    @abstract   Write a sequence of values to the device.
+    @discussion Writes len values to the GPIO register of the device in a
+    single I2C transaction, the device port will take each value in turn. Values are masked with the
+    direction of the pins as in write(uint8_t).
+    
+    @param      values[in] values to be written to the device.
+    @param      len[in] number of values to write (up to MCP23008_BURST_MAX,
+    31), nothing is written if there are more.
+    @result     1 on success, 0 otherwise
+    */   
+   int write ( const uint8_t *values, uint8_t len );
+   
+   /*!
+    @method
+    @abstract   Checks if there are writes pending to be sent to the device.
+    @discussion With the interrupt driven transport (TWI_ASYNC) writes return
+    as soon as they have been queued. This method checks if the bus is still
+    sending them. In blocking mode it always returns false.
+    
+    @result     true if there are writes pending, false otherwise.
+    */
+   bool busy ( void );
+   
+   /*!
+    @method
+    @abstract   Waits for all the pending writes to be sent.
+    @discussion In blocking mode writes have always been sent and the method
+    returns immediately.
+    
+    @result     1 if all the writes since the last flush were acknowledged, 0
+    otherwise.
+    */
+   int flush ( void );
+   
+   /*!
+    @method
+    @abstract   Sets a callback for when the pending writes have been sent.
+    @discussion The callback is shared by all the devices on the bus and is
+    called from the TWI interrupt. It is only used with the interrupt driven
+    transport (TWI_ASYNC), in blocking mode the callback is ignored.
+    
+    @param      callback[in] function to call, NULL to disable it.
+    */
+   void onFlushDone ( t_twiFlushDone callback );
+   
+   /*!
+    @method
+    @abstract   Writes a digital level to a particular pin.
+    @discussion Write a level to the indicated pin of the device. For this 
+    method to have effect, the pin has to be configured as OUTPUT using the
+    pinMode or portMode methods.
+    
+    @param      pin[in] device pin to change level. Range (0..7).
+    @para       level[in] logic level to set the pin at (HIGH, LOW).
+    @result     1 on success, 0 otherwise.
+    */   
+   int digitalWrite ( uint8_t pin, uint8_t level );
+   
+   /*!
+    @method
+    @abstract   Writes a set of pins of the device at once.
+    @discussion Updates the level of all the pins in mask with the values of
+    the corresponding bits in values, in a single transaction. Pins not in
+    mask keep their current level. As with digitalWrite, only pins configured
+    as OUTPUT are changed.
+    
+    @param      mask[in] pins to update, bit n represents pin n.
+    @param      values[in] levels of the pins to update.
+    @result     1 on success, 0 otherwise.
+    */
+   int writeMasked ( uint8_t mask, uint8_t values );
+   
+   /*!
+    @method
+    @abstract   Enables or disables the deferred commit mode.
+    @discussion In deferred commit mode digitalWrite and writeMasked only
+    update the output shadow of the device, the changes are written to the
+    device by calling commit. This allows any number of pin changes to be
+    sent in a single transaction.
+    
+    @param      deferred[in] true to defer the writes, false to write straight
+    away (default).
+    */
+   void setDeferredCommit ( bool deferred );
+   
+   /*!
+    @method
+    @abstract   Writes the pending pin changes to the device.
+    @discussion Writes the output shadow of the device. @see setDeferredCommit.
+    
+    @result     1 on success, 0 otherwise.
+    */
+   int commit ( void );
+   
+   
+   
+private:
+   uint8_t _shadow;      // Shadow output
+   uint8_t _dirMask;     // Direction mask
+   uint8_t _i2cAddr;     // I2C address
+   bool    _initialised; // Initialised object
+   bool    _deferred;    // Writes deferred until commit
+   uint8_t _pullUps;     // Pull-up mask (GPPU)
+
+  /*!
+   @method
+   @abstract   Writes a register of the device.
+   
+   @param      reg[in] register address.
+   @param      value[in] value to write.
+   @result     1 on success, 0 otherwise.
+   */   
+   int writeRegister ( uint8_t reg, uint8_t value );
+
+  /*!
+   @method
+   @abstract   Check if I2C device is available.
+   @discussion Checks to see if an I2C device is available at address i2cAddr.
+   
+   @param      i2cAddr[in] I2C address to check availability 
+   @result     true if available, false otherwise.
+   */   
+   bool isAvailable (uint8_t i2cAddr);
+   
+};
+
+#endif
\ No newline at end of file
@@ -51,7 +51,8 @@
 // Constructor
 LCD::LCD () 
 {
-   
+   _deferredBacklight = false;
+   _homeClearExec = HOME_CLEAR_EXEC;
 }
 
 // PUBLIC METHODS
@@ -168,13 +169,13 @@ void LCD::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
 void LCD::clear()
 {
    command(LCD_CLEARDISPLAY);             // clear display, set cursor position to zero
-   delayMicroseconds(HOME_CLEAR_EXEC);    // this command is time consuming
+   delayMicroseconds(_homeClearExec);     // this command is time consuming
 }
 
 void LCD::home()
 {
    command(LCD_RETURNHOME);             // set cursor position to zero
-   delayMicroseconds(HOME_CLEAR_EXEC);  // This command is time consuming
+   delayMicroseconds(_homeClearExec);   // This command is time consuming
 }
 
 void LCD::setCursor(uint8_t col, uint8_t row)
@@ -350,6 +351,33 @@ void LCD::off ( void )
    noDisplay();
 }
 
+//
+// Defer the backlight changes to the next transfer
+void LCD::setDeferredBacklight ( bool deferred )
+{
+   _deferredBacklight = deferred;
+}
+
+//
+// Nibble to port mapping table
+void LCD::mapNibbles ( uint8_t *nibbleMap, uint8_t d4, uint8_t d5,
+                       uint8_t d6, uint8_t d7 )
+{
+   uint8_t pins[4] = { d4, d5, d6, d7 };
+   
+   for ( uint8_t value = 0; value < 16; value++ )
+   {
+      nibbleMap[value] = 0;
+      for ( uint8_t i = 0; i < 4; i++ )
+      {
+         if ( value & ( 1 << i ) )
+         {
+            nibbleMap[value] |= ( 1 << pins[i] );
+         }
+      }
+   }
+}
+
 // General LCD commands - generic methods used by the rest of the commands
 // ---------------------------------------------------------------------------
 void LCD::command(uint8_t value) 
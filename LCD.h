@@ -94,6 +94,20 @@ inline static void waitUsec ( uint16_t uSec )
 }
 
 
+/*!
+ @defined 
+ @abstract   HD44780 bus timing.
+ @discussion Minimum times in nanoseconds of the HD44780 write cycle from the
+ datasheet (VCC 2.7 to 4.5V, also valid at 5V). Used by the drivers with
+ fio_delay_ns to keep the enable pulse, setup and hold times at spec.
+ */
+#define LCD_T_CYCE   1000   // Enable cycle time
+#define LCD_T_PWEH   450    // Enable pulse width (high level)
+#define LCD_T_AS     60     // Address (RS, R/W) set-up time to Enable rise
+#define LCD_T_AH     20     // Address hold time after Enable fall
+#define LCD_T_DSW    195    // Data set-up time to Enable fall
+#define LCD_T_H      10     // Data hold time after Enable fall
+
 /*!
  @defined 
  @abstract   All these definitions shouldn't be used unless you are writing 
@@ -156,7 +170,8 @@ inline static void waitUsec ( uint16_t uSec )
  @defined 
  @abstract   Defines the duration of the home and clear commands
  @discussion This constant defines the time it takes for the home and clear
- commands in the LCD - Time in microseconds.
+ commands in the LCD - Time in microseconds. Drivers for faster controllers
+ can lower it in _homeClearExec.
  */
 #define HOME_CLEAR_EXEC      2000
 
@@ -470,6 +485,21 @@ public:
     */   
    void off ( void );
    
+   /*!
+    @function
+    @abstract   Defers backlight changes to the next LCD transfer.
+    @discussion On devices where the backlight control travels with every
+    data and command transfer (I2C and shift register backpacks), the backlight
+    methods write to the device straight away. In deferred mode they only
+    update the backlight state, which is latched by the next data or command
+    sent to the LCD or by calling flushBacklight. Devices with a dedicated
+    backlight pin ignore this setting.
+    
+    @param      deferred[in] true to defer backlight changes, false to apply
+    them straight away (default).
+    */
+   void setDeferredBacklight ( bool deferred );
+   
    //
    // virtual class methods
    // --------------------------------------------------------------------------
@@ -504,6 +534,17 @@ public:
     */
    virtual void setBacklight ( uint8_t value ) { };
    
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Writes the current backlight state to the device. Used in
+    deferred backlight mode when there is no other transfer pending to carry
+    the backlight change. @see setDeferredBacklight.
+    This method is device dependent, an empty function call is provided that
+    does nothing.
+    */
+   virtual void flushBacklight ( void ) { };
+   
    /*!
     @function
     @abstract   Writes to the LCD.
@@ -538,6 +579,25 @@ protected:
    uint8_t _numlines;         // Number of lines of the LCD, initialized with begin()
    uint8_t _cols;             // Number of columns in the LCD
    t_backlighPol _polarity;   // Backlight polarity
+   bool _deferredBacklight;   // Backlight changes latched by the next transfer
+   uint16_t _homeClearExec;   // Clear and home execution time (us)
+   
+   /*!
+    @function
+    @abstract   Builds a nibble to IO port mapping table.
+    @discussion Computes the port word for each of the 16 values of a nibble
+    for LCD data lines D4..D7 connected to an arbitrary set of port pins. Used
+    by the expander and shift register drivers to map a nibble with a single
+    table load.
+    
+    @param      nibbleMap[out] 16 entry mapping table.
+    @param      d4[in] port pin (0..7) connected to LCD D4.
+    @param      d5[in] port pin (0..7) connected to LCD D5.
+    @param      d6[in] port pin (0..7) connected to LCD D6.
+    @param      d7[in] port pin (0..7) connected to LCD D7.
+    */
+   static void mapNibbles ( uint8_t *nibbleMap, uint8_t d4, uint8_t d5,
+                            uint8_t d6, uint8_t d7 );
    
 private:
    /*!
@@ -48,6 +48,20 @@
 // STATIC helper functions
 // ---------------------------------------------------------------------------
 
+//
+// bitIndex - position of the (single) bit set in a port bit mask
+static int8_t bitIndex ( fio_bit mask )
+{
+   int8_t index = 0;
+   
+   while ( mask > 1 )
+   {
+      mask >>= 1;
+      index++;
+   }
+   return ( index );
+}
+
 
 // CONSTRUCTORS
 // ---------------------------------------------------------------------------
@@ -121,15 +135,8 @@ LiquidCrystal::LiquidCrystal(uint8_t rs, uint8_t enable,
 // send
 bool LiquidCrystal::send(uint8_t value, uint8_t mode)
 {
-   // Only interested in COMMAND or DATA
-   digitalWrite( _rs_pin, ( mode == LCD_DATA ) );
-   
-   // if there is a RW pin indicated, set it low to Write
-   // ---------------------------------------------------
-   if (_rw_pin != 255) 
-   { 
-      digitalWrite(_rw_pin, LOW);
-   }
+   // Only interested in COMMAND or DATA, RW is kept LOW since init
+   fio_digitalWrite ( _rs_reg, _rs_bit, ( mode == LCD_DATA ) );
    
    if ( mode != FOUR_BITS )
    {   
@@ -147,7 +154,8 @@ bool LiquidCrystal::send(uint8_t value, uint8_t mode)
    {
       writeNbits ( value, 4 );
    }
-   waitUsec ( EXEC_TIME ); // wait for the command to execute by the LCD
+   // The fast IO writes no longer take longer than the LCD command execution
+   delayMicroseconds ( EXEC_TIME ); // wait for the command to execute by the LCD
 
    return true;
 }
@@ -221,13 +229,7 @@ void LiquidCrystal::init(uint8_t fourbitmode, uint8_t rs, uint8_t rw, uint8_t en
                          uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7)
 {
    uint8_t i;
-   
-   // Initialize the IO pins
-   // -----------------------
-   
-   _rs_pin = rs;
-   _rw_pin = rw;
-   _enable_pin = enable;
+   uint8_t numLines = ( fourbitmode ) ? 4 : 8;
    
    _data_pins[0] = d0;
    _data_pins[1] = d1;
@@ -238,34 +240,68 @@ void LiquidCrystal::init(uint8_t fourbitmode, uint8_t rs, uint8_t rw, uint8_t en
    _data_pins[6] = d6;
    _data_pins[7] = d7;
    
-   // Initialize the IO port direction to OUTPUT
-   // ------------------------------------------
+   // Initialize the IO pins as OUTPUTs driven LOW. Now we pull both RS and
+   // R/W low to begin commands
+   // ------------------------------------------------------------------------
+   _rs_reg     = fio_pinToOutputRegister ( rs );
+   _rs_bit     = fio_pinToBit ( rs );
+   _enable_reg = fio_pinToOutputRegister ( enable );
+   _enable_bit = fio_pinToBit ( enable );
    
-   for ( i = 0; i < 4; i++ )
-   {
-      pinMode ( _data_pins[i], OUTPUT );
+   // we can save 1 pin by not using RW. Indicate by passing 255 instead of pin#
+   if ( rw != 255 ) 
+   { 
+      fio_pinToOutputRegister ( rw );
    }
    
-   // Initialize the rest of the ports if it is an 8bit controlled LCD
-   // ----------------------------------------------------------------
+   // Group the data lines by IO port, one register update per port and write
+   // ------------------------------------------------------------------------
+   _numGroups = 0;
    
-   if ( !fourbitmode )
+   for ( i = 0; i < numLines; i++ )
    {
-      for ( i = 4; i < 8; i++ )
+      fio_register reg = fio_pinToOutputRegister ( _data_pins[i] );
+      
+      _data_bits[i] = fio_pinToBit ( _data_pins[i] );
+      
+#ifndef FIO_FALLBACK
+      if ( _numGroups != 0xFF )
       {
-         pinMode ( _data_pins[i], OUTPUT );
+         int8_t  shift = bitIndex ( _data_bits[i] ) - i;
+         uint8_t g;
+         
+         for ( g = 0; ( g < _numGroups ) && ( _groups[g].reg != reg ); g++ );
+         
+         if ( g == _numGroups )
+         {
+            if ( ( g == LCD_MAX_PORT_GROUPS ) || ( reg == 0 ) )
+            {
+               // too many ports or a pin off the port registers, use
+               // digitalWrite
+               _numGroups = 0xFF;
+               continue;
+            }
+            _groups[g].reg   = reg;
+            _groups[g].mask  = 0;
+            _groups[g].lines = 0;
+            _groups[g].shift = shift;
+            _numGroups++;
+         }
+         else if ( _groups[g].shift != shift )
+         {
+            _groups[g].shift = LCD_NO_SHIFT;
+         }
+         _groups[g].mask  |= _data_bits[i];
+         _groups[g].lines |= ( 1 << i );
       }
+#endif
    }
-   pinMode(_rs_pin, OUTPUT);
    
-   // we can save 1 pin by not using RW. Indicate by passing 255 instead of pin#
-   if (_rw_pin != 255) 
-   { 
-      pinMode(_rw_pin, OUTPUT);
+   if ( _numGroups == 0xFF )
+   {
+      _numGroups = 0;
    }
    
-   pinMode(_enable_pin, OUTPUT);
-   
    // Initialise displaymode functions to defaults: LCD_1LINE and LCD_5x8DOTS
    // -------------------------------------------------------------------------
    if (fourbitmode)
@@ -273,15 +309,6 @@ void LiquidCrystal::init(uint8_t fourbitmode, uint8_t rs, uint8_t rw, uint8_t en
    else 
       _displayfunction = LCD_8BITMODE | LCD_1LINE | LCD_5x8DOTS;
    
-   // Now we pull both RS and R/W low to begin commands
-   digitalWrite(_rs_pin, LOW);
-   digitalWrite(_enable_pin, LOW);
-   
-   if (_rw_pin != 255) 
-   { 
-      digitalWrite(_rw_pin, LOW);
-   }
-   
    // Initialise the backlight pin no nothing
    _backlightPin = LCD_NOBACKLIGHT;
    _polarity = POSITIVE;
@@ -291,21 +318,75 @@ void LiquidCrystal::init(uint8_t fourbitmode, uint8_t rs, uint8_t rw, uint8_t en
 // pulseEnable
 void LiquidCrystal::pulseEnable(void) 
 {
-   // There is no need for the delays, since the digitalWrite operation
-   // takes longer.
-   digitalWrite(_enable_pin, HIGH);   
-   waitUsec(1);          // enable pulse must be > 450ns   
-   digitalWrite(_enable_pin, LOW);
+   fio_delay_ns<LCD_T_AS> ( );       // RS set-up time to enable rise
+   fio_digitalWrite ( _enable_reg, _enable_bit, HIGH );
+   fio_delay_ns<LCD_T_PWEH> ( );     // enable pulse must be > 450ns   
+   fio_digitalWrite ( _enable_reg, _enable_bit, LOW );
+   fio_delay_ns<LCD_T_CYCE - LCD_T_PWEH> ( ); // enable cycle, covers hold times
 }
 
 //
 // write4bits
 void LiquidCrystal::writeNbits(uint8_t value, uint8_t numBits) 
 {
-   for (uint8_t i = 0; i < numBits; i++) 
+#ifndef FIO_FALLBACK
+   if ( _numGroups != 0 )
+   {
+      value &= (uint8_t)( ( 1 << numBits ) - 1 );
+      
+      for ( uint8_t g = 0; g < _numGroups; g++ )
+      {
+         t_lcdPortGroup *group = &_groups[g];
+         uint8_t lines = value & group->lines;
+         fio_bit bits  = 0;
+         
+         // Map the data lines to the bits of the port
+         if ( group->shift == LCD_NO_SHIFT )
+         {
+            for ( uint8_t i = 0; lines != 0; i++, lines >>= 1 )
+            {
+               if ( lines & 0x01 )
+               {
+                  bits |= _data_bits[i];
+               }
+            }
+         }
+         else if ( group->shift >= 0 )
+         {
+            bits = (fio_bit)lines << group->shift;
+         }
+         else
+         {
+            bits = (fio_bit)( lines >> -group->shift );
+         }
+         
+#if defined (FIO_SETCLR)
+         // Set and clear registers, no read-modify-write to protect
+         *( group->reg + FIO_SET_OFFSET ) = bits;
+         *( group->reg + FIO_CLR_OFFSET ) = group->mask & ~bits;
+#else
+         // A port fully driven by the data lines is a single store
+         if ( group->mask == (fio_bit)~(fio_bit)0 )
+         {
+            *group->reg = bits;
+         }
+         else
+         {
+            FIO_ATOMIC_BLOCK
+            {
+               *group->reg = ( *group->reg & ~group->mask ) | bits;
+            }
+         }
+#endif
+      }
+   }
+   else
+#endif
    {
-      digitalWrite(_data_pins[i], (value >> i) & 0x01);
+      for (uint8_t i = 0; i < numBits; i++) 
+      {
+         digitalWrite(_data_pins[i], (value >> i) & 0x01);
+      }
    }
    pulseEnable();
 }
-
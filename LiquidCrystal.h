@@ -41,6 +41,39 @@
  */
 #define EXEC_TIME 37
 
+/*!
+ @defined 
+ @abstract   Maximum number of IO ports the data lines can be spread over.
+ @discussion The data lines sharing an IO port are written with a single
+ register update. If the data lines use more ports than this, the driver
+ falls back to one digitalWrite per data line.
+ */
+#ifndef LCD_MAX_PORT_GROUPS
+#define LCD_MAX_PORT_GROUPS 4
+#endif
+
+/*!
+ @defined 
+ @abstract   Port group without in order data lines.
+ @discussion Shift value of a port group whose data lines are not wired in
+ order, these are mapped bit by bit.
+ */
+#define LCD_NO_SHIFT    -128
+
+/*!
+ @typedef
+ @abstract   Data lines of the LCD sharing an IO port.
+ @discussion Precomputed at initialisation to write all the data lines of a
+ port in one go.
+ */
+typedef struct
+{
+   fio_register reg;    // port output register
+   fio_bit      mask;   // port bits driven by the data lines of the group
+   uint8_t      lines;  // data lines in the group (bit n: data line n)
+   int8_t       shift;  // port bit - data line, LCD_NO_SHIFT if not in order
+} t_lcdPortGroup;
+
 class LiquidCrystal : public LCD
 {
 public:
@@ -139,23 +172,30 @@ private:
     @method     
     @abstract   Writes numBits bits from value value to the LCD.
     @discussion Writes numBists bits (the least significant) to the LCD control 
-    data lines.
+    data lines. The data lines sharing an IO port are updated with a single
+    register write, when all 8 data lines are the bits of a port in order the
+    value is written with a single port store.
     */   
    void writeNbits(uint8_t value, uint8_t numBits);
    
    /*!
     @method     
     @abstract   Pulse the LCD enable line (En).
-    @discussion Sends a pulse of 1 uS to the Enable pin to execute an command
-    or write operation.
+    @discussion Sends a pulse to the Enable pin to execute an command or
+    write operation. The pulse width and enable cycle are timed to the
+    HD44780 spec at any clock speed.
     */ 
    void pulseEnable();
    
-   uint8_t _rs_pin;       // LOW: command.  HIGH: character.
-   uint8_t _rw_pin;       // LOW: write to LCD.  HIGH: read from LCD.
-   uint8_t _enable_pin;   // activated by a HIGH pulse.
-   uint8_t _data_pins[8]; // Data pins.
-   uint8_t _backlightPin; // Pin associated to control the LCD backlight
+   fio_register _rs_reg;      // LOW: command.  HIGH: character.
+   fio_bit      _rs_bit;
+   fio_register _enable_reg;  // activated by a HIGH pulse.
+   fio_bit      _enable_bit;
+   uint8_t _data_pins[8];     // Data pins.
+   fio_bit _data_bits[8];     // Port bit of each data pin.
+   t_lcdPortGroup _groups[LCD_MAX_PORT_GROUPS]; // Data pins grouped by port
+   uint8_t _numGroups;        // Port groups in use, 0: digitalWrite per pin
+   uint8_t _backlightPin;     // Pin associated to control the LCD backlight
 };
 
 #endif
@@ -34,6 +34,7 @@
 #endif
 #include <inttypes.h>
 #include "I2CIO.h"
+#include "I2CIO_MCP23008.h"
 #include "LiquidCrystal_I2C.h"
 
 // CONSTANT  definitions
@@ -141,7 +142,8 @@ LiquidCrystal_I2C::LiquidCrystal_I2C(uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
 
 //
 // begin
-void LiquidCrystal_I2C::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) 
+template <class IO>
+void LiquidCrystal_I2C_IO<IO>::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) 
 {
    init();     // Initialise the I2C expander interface
    LCD::begin ( cols, lines, dotsize );
@@ -154,7 +156,8 @@ void LiquidCrystal_I2C::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
 
 //
 // setBacklightPin
-void LiquidCrystal_I2C::setBacklightPin ( uint8_t value, t_backlighPol pol = POSITIVE )
+template <class IO>
+void LiquidCrystal_I2C_IO<IO>::setBacklightPin ( uint8_t value, t_backlighPol pol )
 {
    _backlightPinMask = ( 1 << value );
    _polarity = pol;
@@ -163,7 +166,8 @@ void LiquidCrystal_I2C::setBacklightPin ( uint8_t value, t_backlighPol pol = POS
 
 //
 // setBacklight
-void LiquidCrystal_I2C::setBacklight( uint8_t value ) 
+template <class IO>
+void LiquidCrystal_I2C_IO<IO>::setBacklight( uint8_t value ) 
 {
    // Check if backlight is available
    // ----------------------------------------------------
@@ -180,17 +184,57 @@ void LiquidCrystal_I2C::setBacklight( uint8_t value )
       {
          _backlightStsMask = _backlightPinMask & LCD_NOBACKLIGHT;
       }
+      if ( !_deferredBacklight )
+      {
+         _i2cio.write( _backlightStsMask );
+      }
+   }
+}
+
+//
+// flushBacklight
+template <class IO>
+void LiquidCrystal_I2C_IO<IO>::flushBacklight ( void )
+{
+   if ( _backlightPinMask != 0x0 )
+   {
       _i2cio.write( _backlightStsMask );
    }
 }
 
 
+//
+// busy
+template <class IO>
+bool LiquidCrystal_I2C_IO<IO>::busy ( void )
+{
+   return ( _i2cio.busy ( ) );
+}
+
+//
+// flush
+template <class IO>
+void LiquidCrystal_I2C_IO<IO>::flush ( void )
+{
+   _i2cio.flush ( );
+}
+
+//
+// onFlushDone
+template <class IO>
+void LiquidCrystal_I2C_IO<IO>::onFlushDone ( t_twiFlushDone callback )
+{
+   _i2cio.onFlushDone ( callback );
+}
+
+
 // PRIVATE METHODS
 // ---------------------------------------------------------------------------
 
 //
 // init
-int LiquidCrystal_I2C::init()
+template <class IO>
+int LiquidCrystal_I2C_IO<IO>::init()
 {
    int status = 0;
    
@@ -209,8 +253,9 @@ int LiquidCrystal_I2C::init()
 
 //
 // config
-void LiquidCrystal_I2C::config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs, 
-                                uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 )
+template <class IO>
+void LiquidCrystal_I2C_IO<IO>::config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs, 
+                                       uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 )
 {
    _Addr = lcd_Addr;
    
@@ -222,11 +267,8 @@ void LiquidCrystal_I2C::config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_
    _Rw = ( 1 << Rw );
    _Rs = ( 1 << Rs );
    
-   // Initialise pin mapping
-   _data_pins[0] = ( 1 << d4 );
-   _data_pins[1] = ( 1 << d5 );
-   _data_pins[2] = ( 1 << d6 );
-   _data_pins[3] = ( 1 << d7 );
+   // Initialise pin mapping, one expander word per nibble value
+   mapNibbles ( _nibbleMap, d4, d5, d6, d7 );
 }
 
 
@@ -236,61 +278,65 @@ void LiquidCrystal_I2C::config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_
 
 //
 // send - write either command or data
-bool LiquidCrystal_I2C::send(uint8_t value, uint8_t mode)
+template <class IO>
+bool LiquidCrystal_I2C_IO<IO>::send(uint8_t value, uint8_t mode)
 {
    // No need to use the delay routines since the time taken to write takes
    // longer that what is needed both for toggling and enable pin an to execute
-   // the command.
+   // the command. The enable pulses of both nibbles go in a single I2C
+   // transaction.
    
-   bool result = true;
+   uint8_t buf[4];
+   uint8_t len = 2;
+   uint8_t control;
+   bool result;
+
+   // Is it a command or data, merge the control lines once for both nibbles
+   // ----------------------------------------------------------------------
+   control = ( mode == LCD_DATA ) ? ( _Rs | _backlightStsMask ) : _backlightStsMask;
 
    if ( mode == FOUR_BITS )
    {
-      result = write4bits( (value & 0x0F), COMMAND );
+      write4bits( (value & 0x0F), control, buf );
    }
    else 
    {
-      result = write4bits((value >> 4), mode);
-      result &= write4bits((value & 0x0F), mode);
+      write4bits( (value >> 4), control, buf );
+      write4bits( (value & 0x0F), control, &buf[2] );
+      len = 4;
+   }
+   result = _i2cio.write ( buf, len );
+   
+   // Initialisation, clear and home delays are done by the caller once this
+   // returns, make sure that the command has reached the LCD by then.
+   if ( ( mode == FOUR_BITS ) || ( ( mode == COMMAND ) && ( value < 0x04 ) ) )
+   {
+      result &= _i2cio.flush ( );
    }
    return result;
 }
 
 //
 // write4bits
-bool LiquidCrystal_I2C::write4bits ( uint8_t value, uint8_t mode )
+template <class IO>
+void LiquidCrystal_I2C_IO<IO>::write4bits ( uint8_t value, uint8_t control, uint8_t *buf )
 {
-   uint8_t pinMapValue = 0;
-   
-   // Map the value to LCD pin mapping
-   // --------------------------------
-   for ( uint8_t i = 0; i < 4; i++ )
-   {
-      if ( ( value & 0x1 ) == 1 )
-      {
-         pinMapValue |= _data_pins[i];
-      }
-      value = ( value >> 1 );
-   }
-   
-   // Is it a command or data
-   // -----------------------
-   if ( mode == LCD_DATA )
-   {
-      mode = _Rs;
-   }
-   
-   pinMapValue |= mode | _backlightStsMask;
-   return pulseEnable ( pinMapValue );
+   // Map the value to LCD pin mapping and add the control lines
+   // ----------------------------------------------------------
+   uint8_t pinMapValue = _nibbleMap[value & 0x0F] | control;
+   pulseEnable ( pinMapValue, buf );
 }
 
 //
 // pulseEnable
-bool LiquidCrystal_I2C::pulseEnable (uint8_t data)
+template <class IO>
+void LiquidCrystal_I2C_IO<IO>::pulseEnable (uint8_t data, uint8_t *buf)
 {
-   bool result = _i2cio.write (data | _En);   // En HIGH
-   if (result) {
-       result &= _i2cio.write (data & ~_En);  // En LOW
-   }
-   return result;
+   buf[0] = data | _En;   // En HIGH
+   buf[1] = data & ~_En;  // En LOW
 }
+
+// Expander drivers
+// ---------------------------------------------------------------------------
+template class LiquidCrystal_I2C_IO<I2CIO>;
+template class LiquidCrystal_I2C_IO<I2CIO_MCP23008>;
@@ -19,6 +19,8 @@
 // this class implements the all methods to command an LCD based
 // on the Hitachi HD44780 and compatible chipsets using I2C extension
 // backpacks such as the I2CLCDextraIO with the PCF8574* I2C IO Expander ASIC.
+// The driver is the LiquidCrystal_I2C_IO template, shared with the backpacks
+// based on other 8 bit I2C IO expanders such as the MCP23008.
 //
 // The functionality provided by this class and its base class is identical
 // to the original functionality of the Arduino LiquidCrystal library.
@@ -35,62 +37,20 @@
 #include "LCD.h"
 
 
-class LiquidCrystal_I2C : public LCD 
+/*!
+ @class
+ @abstract    LiquidCrystal_I2C_IO
+ @discussion  4 bit LCD driver over an 8 bit I2C IO expander. The expander
+ driver is a template parameter, any class with the interface of I2CIO
+ (begin, portMode, write, busy, flush and onFlushDone) can be used: I2CIO for
+ the PCF8574 and I2CIO_MCP23008 for the MCP23008. The LCD classes derived from
+ it only provide the constructors with the default wiring of their backpacks.
+ @templatefield IO   expander driver class.
+ */
+template <class IO>
+class LiquidCrystal_I2C_IO : public LCD
 {
 public:
-   
-   /*!
-    @method     
-    @abstract   Class constructor. 
-    @discussion Initializes class variables and defines the I2C address of the
-    LCD. The constructor does not initialize the LCD.
-    
-    @param      lcd_Addr[in] I2C address of the IO expansion module. For I2CLCDextraIO,
-    the address can be configured using the on board jumpers.
-    */
-   LiquidCrystal_I2C (uint8_t lcd_Addr);
-   // Constructor with backlight control
-   LiquidCrystal_I2C (uint8_t lcd_Addr, uint8_t backlighPin, t_backlighPol pol);
-   
-   /*!
-    @method     
-    @abstract   Class constructor. 
-    @discussion Initializes class variables and defines the I2C address of the
-    LCD. The constructor does not initialize the LCD.
-    
-    @param      lcd_Addr[in] I2C address of the IO expansion module. For I2CLCDextraIO,
-    the address can be configured using the on board jumpers.
-    @param      En[in] LCD En (Enable) pin connected to the IO extender module
-    @param      Rw[in] LCD Rw (Read/write) pin connected to the IO extender module
-    @param      Rs[in] LCD Rs (Reset) pin connected to the IO extender module
-    */
-   LiquidCrystal_I2C( uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs);
-   // Constructor with backlight control
-   LiquidCrystal_I2C(uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs,
-                     uint8_t backlighPin, t_backlighPol pol);   
-   
-   /*!
-    @method     
-    @abstract   Class constructor. 
-    @discussion Initializes class variables and defines the I2C address of the
-    LCD. The constructor does not initialize the LCD.
-    
-    @param      lcd_Addr[in] I2C address of the IO expansion module. For I2CLCDextraIO,
-    the address can be configured using the on board jumpers.
-    @param      En[in] LCD En (Enable) pin connected to the IO extender module
-    @param      Rw[in] LCD Rw (Read/write) pin connected to the IO extender module
-    @param      Rs[in] LCD Rs (Reset) pin connected to the IO extender module
-    @param      d4[in] LCD data 0 pin map on IO extender module
-    @param      d5[in] LCD data 1 pin map on IO extender module
-    @param      d6[in] LCD data 2 pin map on IO extender module
-    @param      d7[in] LCD data 3 pin map on IO extender module
-    */
-   LiquidCrystal_I2C(uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs, 
-                     uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 );
-   // Constructor with backlight control
-   LiquidCrystal_I2C(uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs, 
-                     uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
-                     uint8_t backlighPin, t_backlighPol pol);
    /*!
     @function
     @abstract   LCD initialization and associated HW.
@@ -144,15 +104,46 @@ public:
     */
    void setBacklight ( uint8_t value );
    
-private:
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Writes the current backlight state to the IO expander. Only needed in
+    deferred backlight mode when no other transfer is pending.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void );
    
    /*!
     @method     
-    @abstract   Initializes the LCD class
-    @discussion Initializes the LCD class and IO expansion module.
+    @abstract   Checks if the LCD is still being updated.
+    @discussion With the interrupt driven I2C transport (TWI_ASYNC defined in
+    TwiAsync.h) the LCD methods return as soon as the expander writes have been
+    queued. This method checks if they are still being sent to the LCD. In
+    blocking mode it always returns false.
+    
+    @result     true if there are writes pending, false otherwise.
     */
-   int  init();
+   bool busy ( void );
+   
+   /*!
+    @method     
+    @abstract   Waits for all the pending writes to reach the LCD.
+    @discussion In blocking mode it returns immediately.
+    */
+   void flush ( void );
+   
+   /*!
+    @method     
+    @abstract   Sets a callback for when the pending writes have been sent.
+    @discussion The callback is called from the TWI interrupt once the queue
+    of writes has been drained and is shared by all the devices on the bus.
+    It is only used with the interrupt driven transport (TWI_ASYNC).
+    
+    @param      callback[in] function to call, NULL to disable it.
+    */
+   void onFlushDone ( t_twiFlushDone callback );
    
+protected:
    /*!
     @function
     @abstract   Initialises class private variables
@@ -171,34 +162,110 @@ private:
    void config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs, 
                 uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 );
    
+private:
+   
+   /*!
+    @method     
+    @abstract   Initializes the LCD class
+    @discussion Initializes the LCD class and IO expansion module.
+    */
+   int  init();
+   
    /*!
     @method     
     @abstract   Writes an 4 bit value to the LCD.
-    @discussion Writes 4 bits (the least significant) to the LCD control data lines.
+    @discussion Maps 4 bits (the least significant) to the LCD control data
+    lines and stores the expander words to latch them in buf.
     @param      value[in] Value to write to the LCD
-    @param      more[in]  Value to distinguish between command and data.
-    COMMAND == command, DATA == data.
+    @param      control[in] Expander word of the control lines (RS and
+    backlight) to write with the data.
+    @param      buf[out] Expander words, 2 bytes.
     */
-   bool write4bits(uint8_t value, uint8_t mode);
+   void write4bits(uint8_t value, uint8_t control, uint8_t *buf);
    
    /*!
     @method     
     @abstract   Pulse the LCD enable line (En).
-    @discussion Sends a pulse of 1 uS to the Enable pin to execute an command
-    or write operation.
+    @discussion Stores the expander words to pulse the Enable pin with data
+    on the LCD lines. The pulse lasts one I2C byte.
+    @param      data[in] Expander word with the LCD lines.
+    @param      buf[out] Expander words, 2 bytes.
     */
-   bool pulseEnable(uint8_t);
+   void pulseEnable(uint8_t data, uint8_t *buf);
    
    
    uint8_t _Addr;             // I2C Address of the IO expander
    uint8_t _backlightPinMask; // Backlight IO pin mask
    uint8_t _backlightStsMask; // Backlight status mask
-   I2CIO   _i2cio;            // I2CIO PCF8574* expansion module driver I2CLCDextraIO
+   IO      _i2cio;            // Expansion module driver
    uint8_t _En;               // LCD expander word for enable pin
    uint8_t _Rw;               // LCD expander word for R/W pin
    uint8_t _Rs;               // LCD expander word for Register Select pin
-   uint8_t _data_pins[4];     // LCD data lines
+   uint8_t _nibbleMap[16];    // Nibble to LCD data lines mapping
+   
+};
+
+/*!
+ @class
+ @abstract    LiquidCrystal_I2C
+ @discussion  LCD driver for the PCF8574* based backpacks.
+ */
+class LiquidCrystal_I2C : public LiquidCrystal_I2C_IO<I2CIO>
+{
+public:
+   
+   /*!
+    @method     
+    @abstract   Class constructor. 
+    @discussion Initializes class variables and defines the I2C address of the
+    LCD. The constructor does not initialize the LCD.
+    
+    @param      lcd_Addr[in] I2C address of the IO expansion module. For I2CLCDextraIO,
+    the address can be configured using the on board jumpers.
+    */
+   LiquidCrystal_I2C (uint8_t lcd_Addr);
+   // Constructor with backlight control
+   LiquidCrystal_I2C (uint8_t lcd_Addr, uint8_t backlighPin, t_backlighPol pol);
+   
+   /*!
+    @method     
+    @abstract   Class constructor. 
+    @discussion Initializes class variables and defines the I2C address of the
+    LCD. The constructor does not initialize the LCD.
+    
+    @param      lcd_Addr[in] I2C address of the IO expansion module. For I2CLCDextraIO,
+    the address can be configured using the on board jumpers.
+    @param      En[in] LCD En (Enable) pin connected to the IO extender module
+    @param      Rw[in] LCD Rw (Read/write) pin connected to the IO extender module
+    @param      Rs[in] LCD Rs (Reset) pin connected to the IO extender module
+    */
+   LiquidCrystal_I2C( uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs);
+   // Constructor with backlight control
+   LiquidCrystal_I2C(uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs,
+                     uint8_t backlighPin, t_backlighPol pol);   
    
+   /*!
+    @method     
+    @abstract   Class constructor. 
+    @discussion Initializes class variables and defines the I2C address of the
+    LCD. The constructor does not initialize the LCD.
+    
+    @param      lcd_Addr[in] I2C address of the IO expansion module. For I2CLCDextraIO,
+    the address can be configured using the on board jumpers.
+    @param      En[in] LCD En (Enable) pin connected to the IO extender module
+    @param      Rw[in] LCD Rw (Read/write) pin connected to the IO extender module
+    @param      Rs[in] LCD Rs (Reset) pin connected to the IO extender module
+    @param      d4[in] LCD data 0 pin map on IO extender module
+    @param      d5[in] LCD data 1 pin map on IO extender module
+    @param      d6[in] LCD data 2 pin map on IO extender module
+    @param      d7[in] LCD data 3 pin map on IO extender module
+    */
+   LiquidCrystal_I2C(uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs, 
+                     uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 );
+   // Constructor with backlight control
+   LiquidCrystal_I2C(uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs, 
+                     uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
+                     uint8_t backlighPin, t_backlighPol pol);
 };
 
-#endif
+#endif
\ No newline at end of file
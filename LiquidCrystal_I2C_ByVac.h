@@ -29,8 +29,13 @@
 #define LiquidCrystal_I2C_ByVac_h
 #include <inttypes.h>
 #include <Print.h>
+#include "TwiAsync.h"
 
-#if defined(__AVR_ATtiny84__) || (__AVR_ATtiny2313__) || defined (__AVR_ATtiny85__)
+#if defined (TWI_ASYNC)
+
+#define Wire WireAsync
+
+#elif defined(__AVR_ATtiny84__) || (__AVR_ATtiny2313__) || defined (__AVR_ATtiny85__)
 
 #include "TinyWireM.h" // include this if ATtiny84 or ATtiny85 or ATtiny2313
 
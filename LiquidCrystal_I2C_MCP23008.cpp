@@ -0,0 +1,128 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no 
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_I2C_MCP23008.c
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using an I2C IO extension board.
+// 
+// @brief 
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. The original library has been reworked in such a way that 
+// this class implements the all methods to command an LCD based
+// on the Hitachi HD44780 and compatible chipsets using I2C extension
+// backpacks based on the MCP23008 I2C IO Expander ASIC such as the
+// Adafruit I2C/SPI LCD backpack.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// The driver itself is LiquidCrystal_I2C_IO, @see LiquidCrystal_I2C.cpp.
+//
+// ---------------------------------------------------------------------------
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include <inttypes.h>
+#include "LiquidCrystal_I2C_MCP23008.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// Default library configuration parameters used by class constructor with
+// only the I2C address field. They match the Adafruit I2C/SPI LCD backpack
+// which ties the LCD Rw pin to ground, GP0 is left unused.
+// ---------------------------------------------------------------------------
+/*!
+ @defined 
+ @abstract   Enable bit of the LCD
+ @discussion Defines the IO of the expander connected to the LCD Enable
+ */
+#define EN 2  // Enable bit
+
+/*!
+ @defined 
+ @abstract   Read/Write bit of the LCD
+ @discussion Defines the IO of the expander connected to the LCD Rw pin
+ */
+#define RW 0  // Read/Write bit (not connected)
+
+/*!
+ @defined 
+ @abstract   Register bit of the LCD
+ @discussion Defines the IO of the expander connected to the LCD Register select pin
+ */
+#define RS 1  // Register select bit
+
+/*!
+ @defined 
+ @abstract   LCD dataline allocation this library only supports 4 bit LCD control
+ mode.
+ @discussion D4, D5, D6, D7 LCD data lines pin mapping of the extender module
+ */
+#define D4 3
+#define D5 4
+#define D6 5
+#define D7 6
+
+/*!
+ @defined 
+ @abstract   Backlight bit of the LCD
+ @discussion Defines the IO of the expander driving the backlight (active high)
+ */
+#define BL 7
+
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_I2C_MCP23008::LiquidCrystal_I2C_MCP23008( uint8_t lcd_Addr )
+{
+   config(lcd_Addr, EN, RW, RS, D4, D5, D6, D7);
+   setBacklightPin(BL, POSITIVE);
+}
+
+
+LiquidCrystal_I2C_MCP23008::LiquidCrystal_I2C_MCP23008(uint8_t lcd_Addr, uint8_t backlighPin, 
+                                     t_backlighPol pol = POSITIVE)
+{
+   config(lcd_Addr, EN, RW, RS, D4, D5, D6, D7);
+   setBacklightPin(backlighPin, pol);
+}
+
+LiquidCrystal_I2C_MCP23008::LiquidCrystal_I2C_MCP23008(uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
+                                     uint8_t Rs)
+{
+   config(lcd_Addr, En, Rw, Rs, D4, D5, D6, D7);
+}
+
+LiquidCrystal_I2C_MCP23008::LiquidCrystal_I2C_MCP23008(uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
+                                     uint8_t Rs, uint8_t backlighPin, 
+                                     t_backlighPol pol = POSITIVE)
+{
+   config(lcd_Addr, En, Rw, Rs, D4, D5, D6, D7);
+   setBacklightPin(backlighPin, pol);
+}
+
+LiquidCrystal_I2C_MCP23008::LiquidCrystal_I2C_MCP23008(uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
+                                     uint8_t Rs, uint8_t d4, uint8_t d5,
+                                     uint8_t d6, uint8_t d7 )
+{
+   config(lcd_Addr, En, Rw, Rs, d4, d5, d6, d7);
+}
+
+LiquidCrystal_I2C_MCP23008::LiquidCrystal_I2C_MCP23008(uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
+                                     uint8_t Rs, uint8_t d4, uint8_t d5,
+                                     uint8_t d6, uint8_t d7, uint8_t backlighPin, 
+                                     t_backlighPol pol = POSITIVE )
+{
+   config(lcd_Addr, En, Rw, Rs, d4, d5, d6, d7);
+   setBacklightPin(backlighPin, pol);
+}
@@ -0,0 +1,111 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no 
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_I2C_MCP23008.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using an I2C IO extension board.
+// 
+// @brief 
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. The original library has been reworked in such a way that 
+// this class implements the all methods to command an LCD based
+// on the Hitachi HD44780 and compatible chipsets using I2C extension
+// backpacks based on the MCP23008 I2C IO Expander ASIC such as the
+// Adafruit I2C/SPI LCD backpack. It is the LiquidCrystal_I2C driver on the
+// I2CIO_MCP23008 expander driver, with the default wiring of the Adafruit
+// backpack.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// The expander is used with the address pointer auto-increment disabled, so
+// the four expander words needed to latch both nibbles of a byte are written
+// to the GPIO register in a single I2C transaction. The MCP23008 can also
+// run the bus in fast mode (400kHz) when no slower device shares it, @see
+// MCP23008_I2C_FREQ.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_I2C_MCP23008_h
+#define LiquidCrystal_I2C_MCP23008_h
+#include <inttypes.h>
+#include <Print.h>
+
+#include "I2CIO_MCP23008.h"
+#include "LiquidCrystal_I2C.h"
+
+
+/*!
+ @class
+ @abstract    LiquidCrystal_I2C_MCP23008
+ @discussion  LCD driver for the MCP23008 based backpacks.
+ */
+class LiquidCrystal_I2C_MCP23008 : public LiquidCrystal_I2C_IO<I2CIO_MCP23008>
+{
+public:
+   
+   /*!
+    @method     
+    @abstract   Class constructor. 
+    @discussion Initializes class variables and defines the I2C address of the
+    LCD. The constructor does not initialize the LCD.
+    
+    The pin mapping and backlight control default to the Adafruit backpack
+    wiring: RS on GP1, EN on GP2, D4..D7 on GP3..GP6 and the backlight on
+    GP7.
+    
+    @param      lcd_Addr[in] I2C address of the IO expansion module. For the Adafruit
+    backpack, the address can be configured using the on board jumpers.
+    */
+   LiquidCrystal_I2C_MCP23008 (uint8_t lcd_Addr);
+   // Constructor with backlight control
+   LiquidCrystal_I2C_MCP23008 (uint8_t lcd_Addr, uint8_t backlighPin, t_backlighPol pol);
+   
+   /*!
+    @method     
+    @abstract   Class constructor. 
+    @discussion Initializes class variables and defines the I2C address of the
+    LCD. The constructor does not initialize the LCD.
+    
+    @param      lcd_Addr[in] I2C address of the IO expansion module. For the Adafruit
+    backpack, the address can be configured using the on board jumpers.
+    @param      En[in] LCD En (Enable) pin connected to the IO extender module
+    @param      Rw[in] LCD Rw (Read/write) pin connected to the IO extender module
+    @param      Rs[in] LCD Rs (Reset) pin connected to the IO extender module
+    */
+   LiquidCrystal_I2C_MCP23008( uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs);
+   // Constructor with backlight control
+   LiquidCrystal_I2C_MCP23008(uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs,
+                     uint8_t backlighPin, t_backlighPol pol);   
+   
+   /*!
+    @method     
+    @abstract   Class constructor. 
+    @discussion Initializes class variables and defines the I2C address of the
+    LCD. The constructor does not initialize the LCD.
+    
+    @param      lcd_Addr[in] I2C address of the IO expansion module. For the Adafruit
+    backpack, the address can be configured using the on board jumpers.
+    @param      En[in] LCD En (Enable) pin connected to the IO extender module
+    @param      Rw[in] LCD Rw (Read/write) pin connected to the IO extender module
+    @param      Rs[in] LCD Rs (Reset) pin connected to the IO extender module
+    @param      d4[in] LCD data 0 pin map on IO extender module
+    @param      d5[in] LCD data 1 pin map on IO extender module
+    @param      d6[in] LCD data 2 pin map on IO extender module
+    @param      d7[in] LCD data 3 pin map on IO extender module
+    */
+   LiquidCrystal_I2C_MCP23008(uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs, 
+                     uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 );
+   // Constructor with backlight control
+   LiquidCrystal_I2C_MCP23008(uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs, 
+                     uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
+                     uint8_t backlighPin, t_backlighPol pol);
+};
+
+#endif
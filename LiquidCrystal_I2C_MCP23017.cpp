@@ -0,0 +1,343 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_I2C_MCP23017.cpp
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using an MCP23017 I2C IO extension board in 8 bit
+// mode.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. The LCD data lines are connected to GPIOA and the control
+// lines to GPIOB of an MCP23017, the LCD is driven in 8 bit mode.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "TwiAsync.h"
+
+#if defined (TWI_ASYNC)
+#define Wire WireAsync
+#define MCP23017_SET_CLOCK
+
+#elif defined(__AVR_ATtiny84__) || (__AVR_ATtiny2313__) || defined (__AVR_ATtiny85__)
+#include "TinyWireM.h" // include this if ATtiny84 or ATtiny85 or ATtiny2313
+
+#define Wire TinyWireM
+#else
+
+#if (ARDUINO < 10000)
+   #include <../Wire/Wire.h>
+#else
+   #include <Wire.h>
+#endif
+
+#if (ARDUINO >= 157)
+#define MCP23017_SET_CLOCK    // Wire.setClock available
+#endif
+
+#endif
+
+#include <inttypes.h>
+#include "LiquidCrystal_I2C_MCP23017.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+// MCP23017 registers (IOCON.BANK = 0)
+#define MCP23017_IODIRA  0x00
+#define MCP23017_IOCON   0x0A
+#define MCP23017_GPIOA   0x12
+#define MCP23017_GPIOB   0x13
+
+// IOCON sequential operation disabled, the address pointer toggles between
+// the A/B pair of registers
+#define MCP23017_SEQOP   0x20
+
+// flags for backlight control
+/*!
+ @defined
+ @abstract   LCD_NOBACKLIGHT
+ @discussion NO BACKLIGHT MASK
+ */
+#define LCD_NOBACKLIGHT 0x00
+
+/*!
+ @defined
+ @abstract   LCD_BACKLIGHT
+ @discussion BACKLIGHT MASK used when backlight is on
+ */
+#define LCD_BACKLIGHT   0xFF
+
+
+// Default library configuration parameters used by class constructor with
+// only the I2C address field. All of them in GPIOB.
+// ---------------------------------------------------------------------------
+/*!
+ @defined
+ @abstract   Enable bit of the LCD
+ @discussion Defines the IO of GPIOB connected to the LCD Enable
+ */
+#define EN 2  // Enable bit
+
+/*!
+ @defined
+ @abstract   Read/Write bit of the LCD
+ @discussion Defines the IO of GPIOB connected to the LCD Rw pin
+ */
+#define RW 1  // Read/Write bit
+
+/*!
+ @defined
+ @abstract   Register bit of the LCD
+ @discussion Defines the IO of GPIOB connected to the LCD Register select pin
+ */
+#define RS 0  // Register select bit
+
+/*!
+ @defined
+ @abstract   Backlight bit of the LCD
+ @discussion Defines the IO of GPIOB driving the backlight
+ */
+#define BL 3
+
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_I2C_MCP23017::LiquidCrystal_I2C_MCP23017( uint8_t lcd_Addr )
+{
+   config(lcd_Addr, EN, RW, RS);
+   setBacklightPin(BL, POSITIVE);
+}
+
+LiquidCrystal_I2C_MCP23017::LiquidCrystal_I2C_MCP23017(uint8_t lcd_Addr,
+                                                       uint8_t backlighPin,
+                                                       t_backlighPol pol = POSITIVE)
+{
+   config(lcd_Addr, EN, RW, RS);
+   setBacklightPin(backlighPin, pol);
+}
+
+LiquidCrystal_I2C_MCP23017::LiquidCrystal_I2C_MCP23017(uint8_t lcd_Addr, uint8_t En,
+                                                       uint8_t Rw, uint8_t Rs)
+{
+   config(lcd_Addr, En, Rw, Rs);
+}
+
+LiquidCrystal_I2C_MCP23017::LiquidCrystal_I2C_MCP23017(uint8_t lcd_Addr, uint8_t En,
+                                                       uint8_t Rw, uint8_t Rs,
+                                                       uint8_t backlighPin,
+                                                       t_backlighPol pol = POSITIVE)
+{
+   config(lcd_Addr, En, Rw, Rs);
+   setBacklightPin(backlighPin, pol);
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_I2C_MCP23017::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   init();     // Initialise the I2C expander interface
+   LCD::begin ( cols, lines, dotsize );
+}
+
+
+// User commands - users can expand this section
+//----------------------------------------------------------------------------
+// Turn the (optional) backlight off/on
+
+//
+// setBacklightPin
+void LiquidCrystal_I2C_MCP23017::setBacklightPin ( uint8_t value, t_backlighPol pol = POSITIVE )
+{
+   _backlightPinMask = ( 1 << value );
+   _polarity = pol;
+   setBacklight(BACKLIGHT_OFF);
+}
+
+//
+// setBacklight
+void LiquidCrystal_I2C_MCP23017::setBacklight( uint8_t value )
+{
+   // Check if backlight is available
+   // ----------------------------------------------------
+   if ( _backlightPinMask != 0x0 )
+   {
+      // Check for polarity to configure mask accordingly
+      // ----------------------------------------------------------
+      if  (((_polarity == POSITIVE) && (value > 0)) ||
+           ((_polarity == NEGATIVE ) && ( value == 0 )))
+      {
+         _backlightStsMask = _backlightPinMask & LCD_BACKLIGHT;
+      }
+      else
+      {
+         _backlightStsMask = _backlightPinMask & LCD_NOBACKLIGHT;
+      }
+      if ( !_deferredBacklight )
+      {
+         flushBacklight ( );
+      }
+   }
+}
+
+//
+// flushBacklight
+void LiquidCrystal_I2C_MCP23017::flushBacklight ( void )
+{
+   if ( ( _backlightPinMask != 0x0 ) && _initialised )
+   {
+      Wire.beginTransmission ( _Addr );
+#if (ARDUINO <  100)
+      Wire.send ( MCP23017_GPIOB );
+      Wire.send ( _backlightStsMask );
+#else
+      Wire.write ( MCP23017_GPIOB );
+      Wire.write ( _backlightStsMask );
+#endif
+      Wire.endTransmission ( );
+   }
+}
+
+//
+// busy
+bool LiquidCrystal_I2C_MCP23017::busy ( void )
+{
+#if defined (TWI_ASYNC)
+   return ( Wire.busy ( ) );
+#else
+   return ( false );
+#endif
+}
+
+//
+// flush
+void LiquidCrystal_I2C_MCP23017::flush ( void )
+{
+#if defined (TWI_ASYNC)
+   Wire.flush ( );
+#endif
+}
+
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// init
+int LiquidCrystal_I2C_MCP23017::init()
+{
+   Wire.begin ( );
+#if defined (MCP23017_SET_CLOCK) && ( MCP23017_I2C_FREQ != 0 )
+   Wire.setClock ( MCP23017_I2C_FREQ );
+#endif
+
+   // Make the address pointer toggle between the A/B registers, set both
+   // ports as outputs and drive all the lines LOW.
+   // ------------------------------------------------------------------------
+   _initialised = writeRegisters ( MCP23017_IOCON, MCP23017_SEQOP, MCP23017_SEQOP );
+   if ( _initialised )
+   {
+      _initialised = writeRegisters ( MCP23017_IODIRA, 0x00, 0x00 );
+      _initialised &= writeRegisters ( MCP23017_GPIOA, 0x00, 0x00 );
+      _displayfunction = LCD_8BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   }
+   return ( _initialised );
+}
+
+//
+// config
+void LiquidCrystal_I2C_MCP23017::config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
+                                         uint8_t Rs)
+{
+   _Addr = lcd_Addr;
+
+   _backlightPinMask = 0;
+   _backlightStsMask = LCD_NOBACKLIGHT;
+   _polarity = POSITIVE;
+   _initialised = false;
+
+   _En = ( 1 << En );
+   _Rw = ( 1 << Rw );
+   _Rs = ( 1 << Rs );
+}
+
+//
+// writeRegisters
+bool LiquidCrystal_I2C_MCP23017::writeRegisters ( uint8_t reg, uint8_t valueA,
+                                                  uint8_t valueB )
+{
+   Wire.beginTransmission ( _Addr );
+#if (ARDUINO <  100)
+   Wire.send ( reg );
+   Wire.send ( valueA );
+   Wire.send ( valueB );
+#else
+   Wire.write ( reg );
+   Wire.write ( valueA );
+   Wire.write ( valueB );
+#endif
+   return ( Wire.endTransmission ( ) == 0 );
+}
+
+
+// low level data pushing commands
+//----------------------------------------------------------------------------
+
+//
+// send - write either command or data
+bool LiquidCrystal_I2C_MCP23017::send(uint8_t value, uint8_t mode)
+{
+   // No need to use the delay routines since the time taken to write takes
+   // longer that what is needed both for toggling and enable pin an to execute
+   // the command. The address pointer toggles between GPIOB and GPIOA, the
+   // data lines are stable for a whole byte before EN falls.
+   uint8_t control = _backlightStsMask;
+   bool result;
+
+   if ( mode == LCD_DATA )
+   {
+      control |= _Rs;
+   }
+
+   Wire.beginTransmission ( _Addr );
+#if (ARDUINO <  100)
+   Wire.send ( MCP23017_GPIOB );
+   Wire.send ( control | _En );   // GPIOB: En HIGH
+   Wire.send ( value );           // GPIOA: data
+   Wire.send ( control );         // GPIOB: En LOW
+#else
+   Wire.write ( MCP23017_GPIOB );
+   Wire.write ( control | _En );  // GPIOB: En HIGH
+   Wire.write ( value );          // GPIOA: data
+   Wire.write ( control );        // GPIOB: En LOW
+#endif
+   result = ( Wire.endTransmission ( ) == 0 );
+
+#if defined (TWI_ASYNC)
+   // Function set, clear and home delays are done by the caller once this
+   // returns, make sure that the command has reached the LCD by then.
+   if ( ( mode == COMMAND ) &&
+        ( ( value < 0x04 ) || ( ( value & 0xE0 ) == LCD_FUNCTIONSET ) ) )
+   {
+      result &= ( Wire.flush ( ) == 0 );
+   }
+#endif
+   return result;
+}
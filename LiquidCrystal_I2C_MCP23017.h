@@ -0,0 +1,214 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_I2C_MCP23017.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using an MCP23017 I2C IO extension board in 8 bit
+// mode.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. The original library has been reworked in such a way that
+// this class implements the all methods to command an LCD based
+// on the Hitachi HD44780 and compatible chipsets using an MCP23017 16 bit
+// I2C IO expander. The 8 LCD data lines are connected to GPIOA and the LCD
+// control lines (RS, RW, EN) and the backlight control to GPIOB.
+//
+// Unlike the PCF8574 and MCP23008 backpacks, the LCD is driven in 8 bit mode: a
+// single enable pulse per character. The expander is used with the address
+// pointer toggling between GPIOB and GPIOA, therefore each character is sent
+// in a single I2C transaction of 3 data bytes:
+//    GPIOB: RS, EN high - GPIOA: data - GPIOB: EN low (data latched).
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_I2C_MCP23017_h
+#define LiquidCrystal_I2C_MCP23017_h
+#include <inttypes.h>
+#include <Print.h>
+
+#include "TwiAsync.h"
+#include "LCD.h"
+
+/*!
+ @defined
+ @abstract   I2C bus frequency used with the MCP23017.
+ @discussion By default (0) begin leaves the bus frequency unchanged, the bus
+ may be shared with devices rated for 100kHz only such as the PCF8574. The
+ MCP23017 supports fast mode I2C: to use it, call Wire.setClock(400000L)
+ after begin, or define MCP23017_I2C_FREQ to 400000L in the compiler flags
+ of the library for begin to set it.
+ */
+#ifndef MCP23017_I2C_FREQ
+#define MCP23017_I2C_FREQ 0
+#endif
+
+
+class LiquidCrystal_I2C_MCP23017 : public LCD
+{
+public:
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the I2C address of the
+    LCD. The constructor does not initialize the LCD.
+
+    The LCD control lines default to RS on GPB0, RW on GPB1, EN on GPB2 and
+    the backlight on GPB3.
+
+    @param      lcd_Addr[in] I2C address of the IO expansion module.
+    */
+   LiquidCrystal_I2C_MCP23017 (uint8_t lcd_Addr);
+   // Constructor with backlight control
+   LiquidCrystal_I2C_MCP23017 (uint8_t lcd_Addr, uint8_t backlighPin,
+                               t_backlighPol pol);
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the I2C address of the
+    LCD. The constructor does not initialize the LCD.
+
+    @param      lcd_Addr[in] I2C address of the IO expansion module.
+    @param      En[in] LCD En (Enable) pin connected to GPIOB (0..7)
+    @param      Rw[in] LCD Rw (Read/write) pin connected to GPIOB (0..7)
+    @param      Rs[in] LCD Rs (Reset) pin connected to GPIOB (0..7)
+    */
+   LiquidCrystal_I2C_MCP23017 ( uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
+                                uint8_t Rs );
+   // Constructor with backlight control
+   LiquidCrystal_I2C_MCP23017 ( uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
+                                uint8_t Rs, uint8_t backlighPin,
+                                t_backlighPol pol );
+
+   /*!
+    @function
+    @abstract   LCD initialization and associated HW.
+    @discussion Initializes the LCD to a given size (col, row). This methods
+    initializes the LCD, therefore, it MUST be called prior to using any other
+    method from this class or parent class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual bool send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Sets the pin to control the backlight.
+    @discussion Sets the pin of GPIOB to control the backlight. This device
+    doesn't support dimming backlight capability.
+
+    @param      value: GPIOB pin driving the backlight (0..7).
+    @param      pol: backlight polarity POSITIVE|NEGATIVE.
+    */
+   void setBacklightPin ( uint8_t value, t_backlighPol pol );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    @discussion Switch-on/off the LCD backlight.
+    The setBacklightPin has to be called before setting the backlight for
+    this method to work. @see setBacklightPin.
+
+    @param      value: backlight mode (HIGH|LOW)
+    */
+   void setBacklight ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Writes the current backlight state to GPIOB. Only needed in
+    deferred backlight mode when no other transfer is pending.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void );
+
+   /*!
+    @method
+    @abstract   Checks if the LCD is still being updated.
+    @discussion With the interrupt driven I2C transport (TWI_ASYNC defined in
+    TwiAsync.h) checks if there are writes still being sent to the LCD. In
+    blocking mode it always returns false.
+
+    @result     true if there are writes pending, false otherwise.
+    */
+   bool busy ( void );
+
+   /*!
+    @method
+    @abstract   Waits for all the pending writes to reach the LCD.
+    @discussion In blocking mode it returns immediately.
+    */
+   void flush ( void );
+
+private:
+
+   /*!
+    @method
+    @abstract   Initializes the LCD class
+    @discussion Initializes the LCD class and IO expansion module.
+    */
+   int  init();
+
+   /*!
+    @function
+    @abstract   Initialises class private variables
+    @discussion This is the class single point for initialising private variables.
+
+    @param      lcd_Addr[in] I2C address of the IO expansion module.
+    @param      En[in] LCD En (Enable) pin connected to GPIOB
+    @param      Rw[in] LCD Rw (Read/write) pin connected to GPIOB
+    @param      Rs[in] LCD Rs (Reset) pin connected to GPIOB
+    */
+   void config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs);
+
+   /*!
+    @method
+    @abstract   Writes a pair of registers of the expander.
+    @discussion Writes a register and the next one in a single transaction.
+
+    @param      reg[in] register address.
+    @param      valueA[in] value of the first register.
+    @param      valueB[in] value of the second register.
+    @result     true on success, false otherwise.
+    */
+   bool writeRegisters ( uint8_t reg, uint8_t valueA, uint8_t valueB );
+
+   uint8_t _Addr;             // I2C Address of the IO expander
+   uint8_t _backlightPinMask; // Backlight IO pin mask
+   uint8_t _backlightStsMask; // Backlight status mask
+   uint8_t _En;               // LCD expander word for enable pin
+   uint8_t _Rw;               // LCD expander word for R/W pin
+   uint8_t _Rs;               // LCD expander word for Register Select pin
+   bool    _initialised;      // Expander found and configured
+
+};
+
+#endif
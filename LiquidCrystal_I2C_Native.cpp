@@ -0,0 +1,272 @@
+// ---------------------------------------------------------------------------
+// Copyright 2012 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_I2C_Native.cpp
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but for character controllers with a native I2C
+// interface.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. @see LiquidCrystal_I2C_Native.h.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include <inttypes.h>
+#include "LiquidCrystal_I2C_Native.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// Command and clear/home execution times (us) of the controllers, at their
+// slowest oscillator setting. The US2066 datasheet gives no figure, the
+// HD44780 ones are used.
+#define ST7032_EXEC            27
+#define ST7032_HOME_CLEAR    1100
+#define AIP31068_EXEC          37
+#define AIP31068_HOME_CLEAR  1520
+#define US2066_EXEC            37
+
+// Time it takes to clock a byte and its acknowledge on the bus (us)
+#define I2C_NATIVE_BYTE_TIME ( 9000000L / I2C_NATIVE_BUS_CLOCK )
+
+// ST7032i extended instruction set (function set IS bit)
+#define ST7032_IS              0x01
+#define ST7032_OSC             0x14   // 1/5 bias, 183Hz frame
+#define ST7032_CONTRAST_LOW    0x70
+#define ST7032_POWER_ICON      0x50
+#define ST7032_BOOSTER         0x04
+#define ST7032_FOLLOWER        0x6C   // follower on, amplified ratio 4
+
+// US2066 extended (function set RE bit) and OLED characterization commands
+#define US2066_RE              0x02
+#define US2066_FUNCTION_SEL_A  0x71
+#define US2066_REGULATOR_ON    0x5C
+#define US2066_REGULATOR_OFF   0x00
+#define US2066_SD_ON           0x79
+#define US2066_SD_OFF          0x78
+#define US2066_CONTRAST        0x81
+
+// Default contrast values
+#define ST7032_DEF_CONTRAST    32
+#define US2066_DEF_CONTRAST    0x7F
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_I2C_Native::LiquidCrystal_I2C_Native ( t_i2cNativeController controller,
+                                                     uint8_t lcd_Addr )
+{
+   config ( controller, lcd_Addr,
+            ( controller == I2C_NATIVE_US2066 ) ? US2066_DEF_CONTRAST
+                                                : ST7032_DEF_CONTRAST,
+            true );
+}
+
+LiquidCrystal_I2C_Native::LiquidCrystal_I2C_Native ( t_i2cNativeController controller,
+                                                     uint8_t lcd_Addr,
+                                                     uint8_t contrast,
+                                                     bool booster )
+{
+   config ( controller, lcd_Addr, contrast, booster );
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_I2C_Native::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   Wire.begin ( );
+   _displayfunction = LCD_8BITMODE | LCD_1LINE | LCD_5x8DOTS;
+
+   LCD::begin ( cols, lines, dotsize );
+
+   // Controller power setup, the function set has been done by LCD::begin
+   // ------------------------------------------------------------------------
+   switch ( _controller )
+   {
+      case I2C_NATIVE_ST7032:
+         send ( LCD_FUNCTIONSET | _displayfunction | ST7032_IS, COMMAND );
+         send ( ST7032_OSC, COMMAND );
+         send ( LCD_FUNCTIONSET | _displayfunction, COMMAND );
+         break;
+
+      case I2C_NATIVE_US2066:
+         send ( LCD_FUNCTIONSET | _displayfunction | US2066_RE, COMMAND );
+         send ( US2066_FUNCTION_SEL_A, COMMAND );
+         send ( _booster ? US2066_REGULATOR_ON : US2066_REGULATOR_OFF, LCD_DATA );
+         send ( LCD_FUNCTIONSET | _displayfunction, COMMAND );
+         break;
+
+      default:
+         break;
+   }
+   _initialised = true;
+   contrastSetup ( );
+
+   if ( _controller == I2C_NATIVE_ST7032 )
+   {
+      // Follower circuit, wait for the power to stabilise
+      send ( LCD_FUNCTIONSET | _displayfunction | ST7032_IS, COMMAND );
+      send ( ST7032_FOLLOWER, COMMAND );
+      delay ( 200 );
+      send ( LCD_FUNCTIONSET | _displayfunction, COMMAND );
+   }
+}
+
+//
+// write
+#if (ARDUINO >= 100)
+size_t LiquidCrystal_I2C_Native::write(const uint8_t *buffer, size_t size)
+{
+   return ( transmit ( I2C_NATIVE_DATA, buffer, size ) );
+}
+#endif
+
+//
+// setContrast
+void LiquidCrystal_I2C_Native::setContrast ( uint8_t value )
+{
+   _contrast = value;
+   if ( _initialised )
+   {
+      contrastSetup ( );
+   }
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// config
+void LiquidCrystal_I2C_Native::config ( t_i2cNativeController controller,
+                                        uint8_t lcd_Addr, uint8_t contrast,
+                                        bool booster )
+{
+   uint8_t execTime;
+
+   _Addr        = lcd_Addr;
+   _controller  = controller;
+   _contrast    = contrast;
+   _booster     = booster;
+   _initialised = false;
+
+   switch ( controller )
+   {
+      case I2C_NATIVE_ST7032:
+         execTime       = ST7032_EXEC;
+         _homeClearExec = ST7032_HOME_CLEAR;
+         break;
+
+      case I2C_NATIVE_AIP31068:
+         execTime       = AIP31068_EXEC;
+         _homeClearExec = AIP31068_HOME_CLEAR;
+         break;
+
+      default:
+         execTime       = US2066_EXEC;
+         break;
+   }
+
+   // Runs only if the bus is slow enough to cover the execution time
+   _maxRun = ( I2C_NATIVE_BYTE_TIME >= execTime ) ? I2C_NATIVE_MAX_RUN : 1;
+}
+
+//
+// contrastSetup
+void LiquidCrystal_I2C_Native::contrastSetup ( void )
+{
+   switch ( _controller )
+   {
+      case I2C_NATIVE_ST7032:
+         send ( LCD_FUNCTIONSET | _displayfunction | ST7032_IS, COMMAND );
+         send ( ST7032_CONTRAST_LOW | ( _contrast & 0x0F ), COMMAND );
+         send ( ST7032_POWER_ICON | ( _booster ? ST7032_BOOSTER : 0 ) |
+                ( ( _contrast >> 4 ) & 0x03 ), COMMAND );
+         send ( LCD_FUNCTIONSET | _displayfunction, COMMAND );
+         break;
+
+      case I2C_NATIVE_US2066:
+         send ( LCD_FUNCTIONSET | _displayfunction | US2066_RE, COMMAND );
+         send ( US2066_SD_ON, COMMAND );
+         send ( US2066_CONTRAST, COMMAND );
+         send ( _contrast, COMMAND );
+         send ( US2066_SD_OFF, COMMAND );
+         send ( LCD_FUNCTIONSET | _displayfunction, COMMAND );
+         break;
+
+      default:
+         break;
+   }
+}
+
+//
+// transmit
+size_t LiquidCrystal_I2C_Native::transmit ( uint8_t control, const uint8_t *buf,
+                                            size_t len )
+{
+   size_t written = 0;
+
+   while ( written < len )
+   {
+      uint8_t run = ( len - written > _maxRun ) ? _maxRun : len - written;
+
+      Wire.beginTransmission ( _Addr );
+      Wire.write ( control );
+      for ( uint8_t i = 0; i < run; i++ )
+      {
+         Wire.write ( buf[written + i] );
+      }
+      if ( Wire.endTransmission ( ) != 0 )
+      {
+         break;
+      }
+      written += run;
+   }
+   return ( written );
+}
+
+// low level data pushing commands
+//----------------------------------------------------------------------------
+
+//
+// send - write either command or data
+bool LiquidCrystal_I2C_Native::send(uint8_t value, uint8_t mode)
+{
+   bool result;
+
+   // The controller starts in 8 bit mode, LCD::begin only sends FOUR_BITS
+   // writes in 4 bit mode
+   if ( mode == FOUR_BITS )
+   {
+      return true;
+   }
+
+   result = ( transmit ( ( mode == LCD_DATA ) ? I2C_NATIVE_DATA : I2C_NATIVE_COMMAND,
+                         &value, 1 ) == 1 );
+
+#if defined (TWI_ASYNC)
+   // Clear and home delays are done by the caller once this returns, make
+   // sure that the command has reached the LCD by then.
+   if ( ( mode == COMMAND ) && ( value < 0x04 ) )
+   {
+      result = ( Wire.flush ( ) == 0 ) && result;
+   }
+#endif
+   return result;
+}
@@ -0,0 +1,235 @@
+// ---------------------------------------------------------------------------
+// Copyright 2012 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_I2C_Native.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but for character controllers with a native I2C
+// interface.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK for the HD44780 compatible controllers that have an I2C slave
+// interface of their own:
+//    - ST7032i (COG LCDs), with its contrast and booster setup.
+//    - AIP31068 (Grove RGB LCD, the RGB backlight is a separate chip).
+//    - US2066 / SSD1311 (character OLEDs), with its contrast and internal
+//      regulator setup.
+//
+// Every transaction starts with a control byte (Co, RS) followed by a run
+// of bytes (Co = 0): text printed with print or write(buf, len) is sent as
+// one transaction per I2C_NATIVE_MAX_RUN characters, 8 bit per byte with no
+// nibble splitting. A run only relies on the bus byte time to cover the
+// controller execution time, when the bus is too fast for the controller
+// (@see I2C_NATIVE_BUS_CLOCK) each byte is sent in its own transaction.
+//
+// 1 and 2 line modules are supported, the DDRAM layout of the 4 line US2066
+// modules differs from the HD44780 one.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_I2C_Native_h
+#define LiquidCrystal_I2C_Native_h
+#include <inttypes.h>
+#include <Print.h>
+#include "TwiAsync.h"
+
+#if defined (TWI_ASYNC)
+
+#define Wire WireAsync
+
+#elif defined(__AVR_ATtiny84__) || (__AVR_ATtiny2313__) || defined (__AVR_ATtiny85__)
+
+#include "TinyWireM.h" // include this if ATtiny84 or ATtiny85 or ATtiny2313
+
+#define Wire TinyWireM
+
+#else
+
+#if (ARDUINO < 10000)
+   #include <../Wire/Wire.h>
+#else
+   #include <Wire.h>
+#endif
+
+#endif
+
+#include "LCD.h"
+
+/*!
+ @defined
+ @abstract   I2C bus clock in Hz.
+ @discussion Clock set on the bus by the sketch (Wire default 100kHz). It
+ decides if a byte takes longer than the controller execution time, i.e.
+ if bytes can be sent in runs.
+ */
+#ifndef I2C_NATIVE_BUS_CLOCK
+#define I2C_NATIVE_BUS_CLOCK 100000L
+#endif
+
+/*!
+ @defined
+ @abstract   Maximum number of bytes of a run.
+ @discussion Bytes after the control byte in one transaction, within the
+ transmit buffer of Wire (32 bytes) and TinyWireM (18 bytes).
+ */
+#ifndef I2C_NATIVE_MAX_RUN
+#define I2C_NATIVE_MAX_RUN   16
+#endif
+
+/*!
+ @defined
+ @abstract   Control bytes.
+ @discussion Co = 0 (last control byte, a run follows) with RS = 0 for
+ commands and RS = 1 for DDRAM/CGRAM data.
+ */
+#define I2C_NATIVE_COMMAND   0x00
+#define I2C_NATIVE_DATA      0x40
+
+/*!
+ @typedef
+ @abstract   Supported controllers.
+ */
+typedef enum { I2C_NATIVE_ST7032, I2C_NATIVE_AIP31068,
+               I2C_NATIVE_US2066 } t_i2cNativeController;
+
+
+class LiquidCrystal_I2C_Native : public LCD
+{
+public:
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the controller and the
+    I2C address of the LCD. The constructor does not initialize the LCD.
+    The contrast and booster use the defaults of the controller.
+
+    @param      controller[in] I2C_NATIVE_ST7032, I2C_NATIVE_AIP31068 or
+    I2C_NATIVE_US2066.
+    @param      lcd_Addr[in] I2C address of the controller: 0x3E for the
+    ST7032i and the AIP31068, 0x3C or 0x3D for the US2066.
+    */
+   LiquidCrystal_I2C_Native (t_i2cNativeController controller, uint8_t lcd_Addr);
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the controller, the
+    I2C address and the contrast setup of the LCD. The constructor does not
+    initialize the LCD.
+
+    @param      controller[in] I2C_NATIVE_ST7032, I2C_NATIVE_AIP31068 or
+    I2C_NATIVE_US2066.
+    @param      lcd_Addr[in] I2C address of the controller.
+    @param      contrast[in] initial contrast, @see setContrast.
+    @param      booster[in] ST7032i: voltage booster on (3.3V modules) or off
+    (5V modules). US2066: internal regulator on (5V supply) or off (3.3V
+    supply). Ignored for the AIP31068.
+    */
+   LiquidCrystal_I2C_Native (t_i2cNativeController controller, uint8_t lcd_Addr,
+                             uint8_t contrast, bool booster);
+
+   /*!
+    @function
+    @abstract   LCD initialization and associated HW.
+    @discussion Initializes the LCD to a given size (col, row) and then the
+    contrast and power setup of the controller. This methods initializes the
+    LCD, therefore, it MUST be called prior to using any other method from
+    this class or parent class.
+
+    The begin method can be overloaded if necessary to initialize any HW that
+    is implemented by a library and can't be done during construction, here
+    we use the Wire class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command, in a transaction of its own.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual bool send(uint8_t value, uint8_t mode);
+
+#if (ARDUINO >= 100)
+   /*!
+    @function
+    @abstract   Writes a set of characters.
+    @discussion Writes the characters to the DDRAM (or CGRAM) in runs of up
+    to I2C_NATIVE_MAX_RUN bytes per transaction. print uses it for strings
+    and numbers.
+
+    @param      buffer[in] characters to write.
+    @param      size[in] number of characters.
+    @result     number of characters written.
+    */
+   virtual size_t write(const uint8_t *buffer, size_t size);
+   using LCD::write;
+#endif
+
+   /*!
+    @function
+    @abstract   Sets the contrast of the LCD.
+    @discussion ST7032i: 0..63. US2066: 0..255. The AIP31068 has no software
+    contrast control.
+
+    @param      value[in] contrast.
+    */
+   void setContrast ( uint8_t value );
+
+private:
+
+   /*!
+    @method
+    @abstract   Writes bytes in runs.
+    @discussion Splits the bytes in runs of the maximum length allowed by the
+    bus and the controller, each run being one transaction.
+    @param      control[in] control byte, I2C_NATIVE_COMMAND or I2C_NATIVE_DATA.
+    @param      buf[in] bytes to write.
+    @param      len[in] number of bytes.
+    @result     number of bytes written.
+    */
+   size_t transmit ( uint8_t control, const uint8_t *buf, size_t len );
+
+   /*!
+    @method
+    @abstract   Sends the contrast (and booster) setup of the controller.
+    */
+   void contrastSetup ( void );
+
+   /*!
+    @method
+    @abstract   Sets the controller dependent parameters.
+    */
+   void config ( t_i2cNativeController controller, uint8_t lcd_Addr,
+                 uint8_t contrast, bool booster );
+
+   uint8_t _Addr;                     // I2C address of the controller
+   t_i2cNativeController _controller; // Controller type
+   uint8_t _contrast;                 // Contrast
+   bool    _booster;                  // Booster / regulator enabled
+   uint8_t _maxRun;                   // Bytes per transaction
+   bool    _initialised;              // begin has been called
+};
+
+#endif
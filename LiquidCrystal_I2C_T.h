@@ -0,0 +1,256 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_I2C_T.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using an I2C IO extension board with its wiring
+// fixed at compile time.
+//
+// @brief
+// This is the compile time configured version of the LiquidCrystal_I2C class.
+// The expander pins connected to the LCD are template parameters, therefore
+// the pin masks and the nibble mapping are constants that the compiler folds
+// into the code instead of being stored in each instance. When the data lines
+// are wired to consecutive expander pins (D4..D7 on n..n+3) the mapping is a
+// single shift.
+//
+// Usage:
+//    LiquidCrystal_I2C_T<2, 1, 0, 4, 5, 6, 7, 3> lcd ( 0x27 );
+//
+// The LiquidCrystal_I2C class keeps the runtime pin configuration.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_I2C_T_h
+#define LiquidCrystal_I2C_T_h
+#include <inttypes.h>
+#include <Print.h>
+
+#include "I2CIO.h"
+#include "LCD.h"
+
+/*!
+ @class
+ @abstract    LiquidCrystal_I2C_T
+ @discussion  I2C expander LCD driver with the pin mapping fixed at compile
+ time.
+ @templatefield EN   expander pin connected to the LCD Enable.
+ @templatefield RW   expander pin connected to the LCD Rw (kept LOW).
+ @templatefield RS   expander pin connected to the LCD Register select.
+ @templatefield D4   expander pin connected to the LCD D4.
+ @templatefield D5   expander pin connected to the LCD D5.
+ @templatefield D6   expander pin connected to the LCD D6.
+ @templatefield D7   expander pin connected to the LCD D7.
+ @templatefield BL   expander pin controlling the backlight, any value above
+ 7 for no backlight control.
+ @templatefield POL  backlight polarity (POSITIVE, NEGATIVE).
+ */
+template <uint8_t EN, uint8_t RW, uint8_t RS,
+          uint8_t D4, uint8_t D5, uint8_t D6, uint8_t D7,
+          uint8_t BL = 0xFF, t_backlighPol POL = POSITIVE>
+class LiquidCrystal_I2C_T : public LCD
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the I2C address of the
+    LCD. The constructor does not initialize the LCD.
+
+    @param      lcd_Addr[in] I2C address of the IO expansion module.
+    */
+   LiquidCrystal_I2C_T ( uint8_t lcd_Addr )
+   {
+      _Addr = lcd_Addr;
+      _backlightStsMask = 0;
+      _polarity = POL;
+   }
+
+   /*!
+    @function
+    @abstract   LCD initialization and associated HW.
+    @discussion Initializes the LCD to a given size (col, row). This methods
+    initializes the LCD, therefore, it MUST be called prior to using any other
+    method from this class or parent class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin ( uint8_t cols, uint8_t rows,
+                        uint8_t charsize = LCD_5x8DOTS )
+   {
+      // Initialise the I2C expander interface
+      if ( _i2cio.begin ( _Addr ) == 1 )
+      {
+         _i2cio.portMode ( OUTPUT );  // Set the entire IO extender to OUTPUT
+         _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+         _i2cio.write ( 0 );          // Set the entire port to LOW
+      }
+      LCD::begin ( cols, rows, charsize );
+   }
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command. Both nibbles are sent in a single I2C transaction.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual bool send ( uint8_t value, uint8_t mode )
+   {
+      uint8_t buf[4];
+      uint8_t len = 2;
+      uint8_t control;
+      bool result;
+
+      control = ( mode == LCD_DATA ) ? ( RS_MASK | _backlightStsMask )
+                                     : _backlightStsMask;
+
+      if ( mode == FOUR_BITS )
+      {
+         pulseEnable ( mapNibble ( value ) | control, buf );
+      }
+      else
+      {
+         pulseEnable ( mapNibble ( value >> 4 ) | control, buf );
+         pulseEnable ( mapNibble ( value ) | control, &buf[2] );
+         len = 4;
+      }
+      result = _i2cio.write ( buf, len );
+
+      // Initialisation, clear and home delays are done by the caller once
+      // this returns, make sure that the command has reached the LCD by then.
+      if ( ( mode == FOUR_BITS ) || ( ( mode == COMMAND ) && ( value < 0x04 ) ) )
+      {
+         result &= _i2cio.flush ( );
+      }
+      return result;
+   }
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    @discussion Switch-on/off the LCD backlight. Has no effect if the class
+    has been instantiated without backlight control pin.
+
+    @param      value: backlight mode (HIGH|LOW)
+    */
+   void setBacklight ( uint8_t value )
+   {
+      if ( BL_MASK != 0x0 )
+      {
+         if ( ( ( POL == POSITIVE ) && ( value > 0 ) ) ||
+              ( ( POL == NEGATIVE ) && ( value == 0 ) ) )
+         {
+            _backlightStsMask = BL_MASK;
+         }
+         else
+         {
+            _backlightStsMask = 0;
+         }
+         if ( !_deferredBacklight )
+         {
+            flushBacklight ( );
+         }
+      }
+   }
+
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Writes the current backlight state to the IO expander. Only
+    needed in deferred backlight mode when no other transfer is pending.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void )
+   {
+      if ( BL_MASK != 0x0 )
+      {
+         _i2cio.write ( _backlightStsMask );
+      }
+   }
+
+   /*!
+    @method
+    @abstract   Checks if the LCD is still being updated.
+    @discussion @see LiquidCrystal_I2C::busy.
+    */
+   bool busy ( void ) { return ( _i2cio.busy ( ) ); }
+
+   /*!
+    @method
+    @abstract   Waits for all the pending writes to reach the LCD.
+    @discussion @see LiquidCrystal_I2C::flush.
+    */
+   void flush ( void ) { _i2cio.flush ( ); }
+
+   /*!
+    @method
+    @abstract   Sets a callback for when the pending writes have been sent.
+    @discussion @see LiquidCrystal_I2C::onFlushDone.
+    */
+   void onFlushDone ( t_twiFlushDone callback ) { _i2cio.onFlushDone ( callback ); }
+
+private:
+   // Expander words of the LCD lines, compile time constants
+   static const uint8_t EN_MASK = ( 1 << EN );
+   static const uint8_t RS_MASK = ( 1 << RS );
+   static const uint8_t BL_MASK = ( BL < 8 ) ? ( 1 << ( BL & 0x07 ) ) : 0;
+   static const bool    SHIFT_MAP = ( D5 == D4 + 1 ) && ( D6 == D4 + 2 ) &&
+                                    ( D7 == D4 + 3 );
+
+   /*!
+    @method
+    @abstract   Maps a nibble to the LCD data lines.
+    @discussion Reduces to a shift when the data lines are wired to
+    consecutive pins of the expander.
+
+    @param      value[in] nibble to map (least significant 4 bits).
+    @result     expander word with the nibble on the data lines.
+    */
+   static inline uint8_t mapNibble ( uint8_t value )
+   {
+      if ( SHIFT_MAP )
+      {
+         return ( (uint8_t)( ( value & 0x0F ) << D4 ) );
+      }
+      return ( ( ( value & 0x01 ) ? ( 1 << D4 ) : 0 ) |
+               ( ( value & 0x02 ) ? ( 1 << D5 ) : 0 ) |
+               ( ( value & 0x04 ) ? ( 1 << D6 ) : 0 ) |
+               ( ( value & 0x08 ) ? ( 1 << D7 ) : 0 ) );
+   }
+
+   /*!
+    @method
+    @abstract   Pulse the LCD enable line (En).
+    @discussion Stores the expander words to pulse the Enable pin with data
+    on the LCD lines.
+    */
+   static inline void pulseEnable ( uint8_t data, uint8_t *buf )
+   {
+      buf[0] = data | EN_MASK;                // En HIGH
+      buf[1] = data & (uint8_t)~EN_MASK;      // En LOW
+   }
+
+   I2CIO   _i2cio;            // I2CIO PCF8574* expansion module driver
+   uint8_t _Addr;             // I2C Address of the IO expander
+   uint8_t _backlightStsMask; // Backlight status mask
+};
+
+#endif
@@ -12,8 +12,8 @@
 // @file LiquidCrystal_SI2C.c
 // This file implements a basic liquid crystal library that comes as standard
 // in the Arduino SDK but using an I2C IO extension board and software I2C.
-// It will use digital pins 6 and 7 for SCL and SDA, but it can be changed
-// in SI2CIO.cpp to use other pins if needed. 
+// It uses PB0 for SCL and PB1 for SDA, displays on other pins are given a
+// bus generated with SOFTI2C_BUS (@see SoftI2CMaster.h), one per pin pair.
 // 
 // @brief 
 // This is a basic implementation of the LiquidCrystal library of the
@@ -142,6 +142,30 @@ LiquidCrystal_SI2C::LiquidCrystal_SI2C(uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
    setBacklightPin(backlighPin, pol);
 }
 
+LiquidCrystal_SI2C::LiquidCrystal_SI2C( const t_softI2CBus &bus,
+                                       uint8_t lcd_Addr ) : _si2cio ( bus )
+{
+   config(lcd_Addr, EN, RW, RS, D4, D5, D6, D7);
+}
+
+LiquidCrystal_SI2C::LiquidCrystal_SI2C( const t_softI2CBus &bus,
+                                       uint8_t lcd_Addr, uint8_t backlighPin,
+                                       t_backlighPol pol ) : _si2cio ( bus )
+{
+   config(lcd_Addr, EN, RW, RS, D4, D5, D6, D7);
+   setBacklightPin(backlighPin, pol);
+}
+
+LiquidCrystal_SI2C::LiquidCrystal_SI2C( const t_softI2CBus &bus,
+                                       uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
+                                       uint8_t Rs, uint8_t d4, uint8_t d5,
+                                       uint8_t d6, uint8_t d7, uint8_t backlighPin,
+                                       t_backlighPol pol ) : _si2cio ( bus )
+{
+   config(lcd_Addr, En, Rw, Rs, d4, d5, d6, d7);
+   setBacklightPin(backlighPin, pol);
+}
+
 // PUBLIC METHODS
 // ---------------------------------------------------------------------------
 
@@ -187,6 +211,19 @@ void LiquidCrystal_SI2C::setBacklight( uint8_t value )
       {
          _backlightStsMask = _backlightPinMask & LCD_NOBACKLIGHT;
       }
+      if ( !_deferredBacklight )
+      {
+         _si2cio.write( _backlightStsMask );
+      }
+   }
+}
+
+//
+// flushBacklight
+void LiquidCrystal_SI2C::flushBacklight ( void )
+{
+   if ( _backlightPinMask != 0x0 )
+   {
       _si2cio.write( _backlightStsMask );
    }
 }
@@ -229,11 +266,8 @@ void LiquidCrystal_SI2C::config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8
    _Rw = ( 1 << Rw );
    _Rs = ( 1 << Rs );
    
-   // Initialise pin mapping
-   _data_pins[0] = ( 1 << d4 );
-   _data_pins[1] = ( 1 << d5 );
-   _data_pins[2] = ( 1 << d6 );
-   _data_pins[3] = ( 1 << d7 );   
+   // Initialise pin mapping, one expander word per nibble value
+   mapNibbles ( _nibbleMap, d4, d5, d6, d7 );
 }
 
 
@@ -249,42 +283,29 @@ bool LiquidCrystal_SI2C::send(uint8_t value, uint8_t mode)
    // longer that what is needed both for toggling and enable pin an to execute
    // the command.
    
+   // Is it a command or data, merge the control lines once for both nibbles
+   // ----------------------------------------------------------------------
+   uint8_t control = ( mode == LCD_DATA ) ? ( _Rs | _backlightStsMask ) 
+                                          : _backlightStsMask;
+   
    if ( mode == FOUR_BITS )
    {
-      return write4bits( (value & 0x0F), COMMAND );
+      return write4bits( (value & 0x0F), control );
    }
    else 
    {
-      return write4bits( (value >> 4), mode ) &&
-      write4bits( (value & 0x0F), mode);
+      return write4bits( (value >> 4), control ) &&
+      write4bits( (value & 0x0F), control);
    }
 }
 
 //
 // write4bits
-bool LiquidCrystal_SI2C::write4bits ( uint8_t value, uint8_t mode )
+bool LiquidCrystal_SI2C::write4bits ( uint8_t value, uint8_t control )
 {
-   uint8_t pinMapValue = 0;
-   
-   // Map the value to LCD pin mapping
-   // --------------------------------
-   for ( uint8_t i = 0; i < 4; i++ )
-   {
-      if ( ( value & 0x1 ) == 1 )
-      {
-         pinMapValue |= _data_pins[i];
-      }
-      value = ( value >> 1 );
-   }
-   
-   // Is it a command or data
-   // -----------------------
-   if ( mode == LCD_DATA )
-   {
-      mode = _Rs;
-   }
-   
-   pinMapValue |= mode | _backlightStsMask;
+   // Map the value to LCD pin mapping and add the control lines
+   // ----------------------------------------------------------
+   uint8_t pinMapValue = _nibbleMap[value & 0x0F] | control;
    return pulseEnable ( pinMapValue );
 }
 
@@ -12,8 +12,8 @@
 // @file LiquidCrystal_I2C.h
 // This file implements a basic liquid crystal library that comes as standard
 // in the Arduino SDK but using an I2C IO extension board and software I2C.
-// It will use digital pins 6 and 7 for SCL and SDA, but it can be changed
-// in SI2CIO.cpp to use other pins if needed. 
+// It uses PB0 for SCL and PB1 for SDA, displays on other pins are given a
+// bus generated with SOFTI2C_BUS (@see SoftI2CMaster.h), one per pin pair.
 
 // @brief 
 // This is a basic implementation of the LiquidCrystal library of the
@@ -97,6 +97,28 @@ public:
    LiquidCrystal_SI2C(uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_t Rs, 
                      uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
                      uint8_t backlighPin, t_backlighPol pol);
+   
+   /*!
+    @method     
+    @abstract   Class constructor. 
+    @discussion Initializes class variables and defines the software I2C bus
+    and the I2C address of the LCD. The constructor does not initialize the
+    LCD.
+    
+    @param      bus[in] software I2C bus of the LCD, generated with
+    SOFTI2C_BUS(bus, sdaPort, sdaPin, sclPort, sclPin).
+    @param      lcd_Addr[in] I2C address of the IO expansion module. For I2CLCDextraIO,
+    the address can be configured using the on board jumpers.
+    */
+   LiquidCrystal_SI2C (const t_softI2CBus &bus, uint8_t lcd_Addr);
+   // Constructor with backlight control
+   LiquidCrystal_SI2C (const t_softI2CBus &bus, uint8_t lcd_Addr,
+                      uint8_t backlighPin, t_backlighPol pol);
+   // Constructor with pin mapping and backlight control
+   LiquidCrystal_SI2C(const t_softI2CBus &bus, uint8_t lcd_Addr, uint8_t En,
+                     uint8_t Rw, uint8_t Rs, uint8_t d4, uint8_t d5,
+                     uint8_t d6, uint8_t d7, uint8_t backlighPin,
+                     t_backlighPol pol);
    /*!
     @function
     @abstract   LCD initialization and associated HW.
@@ -150,6 +172,15 @@ public:
     */
    void setBacklight ( uint8_t value );
    
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Writes the current backlight state to the IO expander. Only needed in
+    deferred backlight mode when no other transfer is pending.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void );
+   
 private:
    
    /*!
@@ -182,10 +213,10 @@ private:
     @abstract   Writes an 4 bit value to the LCD.
     @discussion Writes 4 bits (the least significant) to the LCD control data lines.
     @param      value[in] Value to write to the LCD
-    @param      more[in]  Value to distinguish between command and data.
-    COMMAND == command, DATA == data.
+    @param      control[in] Expander word of the control lines (RS and
+    backlight) to write with the data.
     */
-   bool write4bits(uint8_t value, uint8_t mode);
+   bool write4bits(uint8_t value, uint8_t control);
    
    /*!
     @method     
@@ -203,7 +234,7 @@ private:
    uint8_t _En;               // LCD expander word for enable pin
    uint8_t _Rw;               // LCD expander word for R/W pin
    uint8_t _Rs;               // LCD expander word for Register Select pin
-   uint8_t _data_pins[4];     // LCD data lines
+   uint8_t _nibbleMap[16];    // Nibble to LCD data lines mapping
    
 };
 
@@ -0,0 +1,281 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SI2CLanes.cpp
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using an I2C IO extension board on one lane of
+// parallel software I2C buses.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. @see LiquidCrystal_SI2CLanes.h.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+
+#if defined (__AVR__)
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include <inttypes.h>
+#include "SI2CLanes.h"
+#include "LiquidCrystal_SI2CLanes.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// flags for backlight control
+/*!
+ @defined
+ @abstract   LCD_NOBACKLIGHT
+ @discussion NO BACKLIGHT MASK
+ */
+#define LCD_NOBACKLIGHT 0x00
+
+/*!
+ @defined
+ @abstract   LCD_BACKLIGHT
+ @discussion BACKLIGHT MASK used when backlight is on
+ */
+#define LCD_BACKLIGHT   0xFF
+
+
+// Default library configuration parameters used by class constructor with
+// only the I2C address field, same as LiquidCrystal_SI2C.
+// ---------------------------------------------------------------------------
+/*!
+ @defined
+ @abstract   Enable bit of the LCD
+ @discussion Defines the IO of the expander connected to the LCD Enable
+ */
+#define EN 6  // Enable bit
+
+/*!
+ @defined
+ @abstract   Read/Write bit of the LCD
+ @discussion Defines the IO of the expander connected to the LCD Rw pin
+ */
+#define RW 5  // Read/Write bit
+
+/*!
+ @defined
+ @abstract   Register bit of the LCD
+ @discussion Defines the IO of the expander connected to the LCD Register select pin
+ */
+#define RS 4  // Register select bit
+
+/*!
+ @defined
+ @abstract   LCD dataline allocation this library only supports 4 bit LCD control
+ mode.
+ @discussion D4, D5, D6, D7 LCD data lines pin mapping of the extender module
+ */
+#define D4 0
+#define D5 1
+#define D6 2
+#define D7 3
+
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_SI2CLanes::LiquidCrystal_SI2CLanes( SI2CLanes &lanes, uint8_t lane,
+                                                  uint8_t lcd_Addr ) :
+   _lanes ( lanes )
+{
+   config(lane, lcd_Addr, EN, RW, RS, D4, D5, D6, D7);
+}
+
+LiquidCrystal_SI2CLanes::LiquidCrystal_SI2CLanes( SI2CLanes &lanes, uint8_t lane,
+                                                  uint8_t lcd_Addr,
+                                                  uint8_t backlighPin,
+                                                  t_backlighPol pol ) :
+   _lanes ( lanes )
+{
+   config(lane, lcd_Addr, EN, RW, RS, D4, D5, D6, D7);
+   setBacklightPin(backlighPin, pol);
+}
+
+LiquidCrystal_SI2CLanes::LiquidCrystal_SI2CLanes( SI2CLanes &lanes, uint8_t lane,
+                                                  uint8_t lcd_Addr, uint8_t En,
+                                                  uint8_t Rw, uint8_t Rs,
+                                                  uint8_t d4, uint8_t d5,
+                                                  uint8_t d6, uint8_t d7 ) :
+   _lanes ( lanes )
+{
+   config(lane, lcd_Addr, En, Rw, Rs, d4, d5, d6, d7);
+}
+
+LiquidCrystal_SI2CLanes::LiquidCrystal_SI2CLanes( SI2CLanes &lanes, uint8_t lane,
+                                                  uint8_t lcd_Addr, uint8_t En,
+                                                  uint8_t Rw, uint8_t Rs,
+                                                  uint8_t d4, uint8_t d5,
+                                                  uint8_t d6, uint8_t d7,
+                                                  uint8_t backlighPin,
+                                                  t_backlighPol pol ) :
+   _lanes ( lanes )
+{
+   config(lane, lcd_Addr, En, Rw, Rs, d4, d5, d6, d7);
+   setBacklightPin(backlighPin, pol);
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_SI2CLanes::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   init();     // Initialise the lanes and the I2C expander
+   LCD::begin ( cols, lines, dotsize );
+}
+
+//
+// setBacklightPin
+void LiquidCrystal_SI2CLanes::setBacklightPin ( uint8_t value, t_backlighPol pol = POSITIVE )
+{
+   _backlightPinMask = ( 1 << value );
+   _polarity = pol;
+   setBacklight(BACKLIGHT_OFF);
+}
+
+//
+// setBacklight
+void LiquidCrystal_SI2CLanes::setBacklight( uint8_t value )
+{
+   // Check if backlight is available
+   // ----------------------------------------------------
+   if ( _backlightPinMask != 0x0 )
+   {
+      // Check for polarity to configure mask accordingly
+      // ----------------------------------------------------------
+      if  (((_polarity == POSITIVE) && (value > 0)) ||
+           ((_polarity == NEGATIVE ) && ( value == 0 )))
+      {
+         _backlightStsMask = _backlightPinMask & LCD_BACKLIGHT;
+      }
+      else
+      {
+         _backlightStsMask = _backlightPinMask & LCD_NOBACKLIGHT;
+      }
+      if ( !_deferredBacklight )
+      {
+         flushBacklight ( );
+      }
+   }
+}
+
+//
+// flushBacklight
+void LiquidCrystal_SI2CLanes::flushBacklight ( void )
+{
+   // No bus traffic before begin, it latches the backlight state
+   if ( ( _backlightPinMask != 0x0 ) && _initialised )
+   {
+      _lanes.queue ( _lane, _Addr, &_backlightStsMask, 1 );
+      flush ( );
+   }
+}
+
+//
+// flush
+void LiquidCrystal_SI2CLanes::flush ( void )
+{
+   _lanes.flush ( );
+}
+
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// init
+int LiquidCrystal_SI2CLanes::init()
+{
+   uint8_t off = 0;
+
+   // Release the lanes, then set the entire IO extender LOW
+   // ------------------------------------------------------------------------
+   _lanes.begin ( );
+   _initialised = true;
+   _lanes.queue ( _lane, _Addr, &off, 1 );
+   _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+
+   return ( ( _lanes.flush ( ) & ( 1 << _lane ) ) ? 1 : 0 );
+}
+
+//
+// config
+void LiquidCrystal_SI2CLanes::config (uint8_t lane, uint8_t lcd_Addr, uint8_t En,
+                                      uint8_t Rw, uint8_t Rs, uint8_t d4,
+                                      uint8_t d5, uint8_t d6, uint8_t d7 )
+{
+   _lane = lane;
+   _Addr = lcd_Addr;
+   _initialised = false;
+
+   _backlightPinMask = 0;
+   _backlightStsMask = LCD_NOBACKLIGHT;
+   _polarity = POSITIVE;
+
+   _En = ( 1 << En );
+   _Rw = ( 1 << Rw );
+   _Rs = ( 1 << Rs );
+
+   // Initialise pin mapping, one expander word per nibble value
+   mapNibbles ( _nibbleMap, d4, d5, d6, d7 );
+}
+
+
+
+// low level data pushing commands
+//----------------------------------------------------------------------------
+
+//
+// send - queue either command or data
+bool LiquidCrystal_SI2CLanes::send(uint8_t value, uint8_t mode)
+{
+   uint8_t buf[4];
+   uint8_t len = 0;
+   bool result = true;
+
+   // Is it a command or data, merge the control lines once for both nibbles
+   // ----------------------------------------------------------------------
+   uint8_t control = ( mode == LCD_DATA ) ? ( _Rs | _backlightStsMask )
+                                          : _backlightStsMask;
+
+   // Each nibble is written with En HIGH then with En LOW, at the bus speed
+   // the next En pulse comes well after the LCD execution time.
+   if ( mode != FOUR_BITS )
+   {
+      buf[1] = _nibbleMap[value >> 4] | control;       // upper nibble
+      buf[0] = buf[1] | _En;
+      len = 2;
+   }
+   buf[len+1] = _nibbleMap[value & 0x0F] | control;    // lower nibble
+   buf[len]   = buf[len+1] | _En;
+   len += 2;
+
+   _lanes.queue ( _lane, _Addr, buf, len );
+
+   // Initialisation, clear and home delays are done by the caller once this
+   // returns, make sure that the command has reached the LCD by then.
+   if ( ( mode == FOUR_BITS ) || ( ( mode == COMMAND ) && ( value < 0x04 ) ) )
+   {
+      result = ( ( _lanes.flush ( ) & ( 1 << _lane ) ) != 0 );
+   }
+   return result;
+}
+
+#endif // defined (__AVR__)
@@ -0,0 +1,200 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SI2CLanes.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using an I2C IO extension board on one lane of
+// parallel software I2C buses.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK for PCF8574 backpacks, as LiquidCrystal_SI2C. Each display
+// sits on its own lane of a SI2CLanes object, the lanes share the SCL line
+// and are clocked together.
+//
+// The writes of a display are queued on its lane, flush sends the queues of
+// all the lanes at once, so N displays are updated in the time of one:
+//
+//    const uint8_t sda[] = { 2, 3, 4, 5 };   // PD2..PD5
+//    uint8_t queues[4 * SI2C_LANES_QUEUE];   // a 20 character row per lane
+//    SI2CLanes lanes ( 6, sda, 4, queues, sizeof ( queues ) ); // SCL on pin 6
+//    LiquidCrystal_SI2CLanes lcd0 ( lanes, 0, 0x38 );
+//    ...
+//    lcd0.print ( a ); lcd1.print ( b ); lcd2.print ( c ); lcd3.print ( d );
+//    lanes.flush ( );
+//
+// The queue of a lane is also flushed when it is full, by the LCD
+// initialisation and by the clear and home commands, as their execution
+// delays only hold once the command has reached the LCD.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef _LIQUIDCRYSTAL_SI2CLANES_H_
+#define _LIQUIDCRYSTAL_SI2CLANES_H_
+
+#if defined (__AVR__)
+
+#include <inttypes.h>
+#include <Print.h>
+
+#include "SI2CLanes.h"
+#include "LCD.h"
+
+
+class LiquidCrystal_SI2CLanes : public LCD
+{
+public:
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the lane and the I2C
+    address of the LCD. The constructor does not initialize the LCD.
+
+    @param      lanes[in] parallel software I2C buses of the LCD.
+    @param      lane[in] lane of the LCD.
+    @param      lcd_Addr[in] I2C address of the IO expansion module.
+    */
+   LiquidCrystal_SI2CLanes (SI2CLanes &lanes, uint8_t lane, uint8_t lcd_Addr);
+   // Constructor with backlight control
+   LiquidCrystal_SI2CLanes (SI2CLanes &lanes, uint8_t lane, uint8_t lcd_Addr,
+                            uint8_t backlighPin, t_backlighPol pol);
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the lane, the I2C
+    address and the expander pin mapping of the LCD. The constructor does
+    not initialize the LCD.
+
+    @param      lanes[in] parallel software I2C buses of the LCD.
+    @param      lane[in] lane of the LCD.
+    @param      lcd_Addr[in] I2C address of the IO expansion module.
+    @param      En[in] LCD En (Enable) pin connected to the IO extender module
+    @param      Rw[in] LCD Rw (Read/write) pin connected to the IO extender module
+    @param      Rs[in] LCD Rs (Reset) pin connected to the IO extender module
+    @param      d4[in] LCD data 0 pin map on IO extender module
+    @param      d5[in] LCD data 1 pin map on IO extender module
+    @param      d6[in] LCD data 2 pin map on IO extender module
+    @param      d7[in] LCD data 3 pin map on IO extender module
+    */
+   LiquidCrystal_SI2CLanes (SI2CLanes &lanes, uint8_t lane, uint8_t lcd_Addr,
+                            uint8_t En, uint8_t Rw, uint8_t Rs,
+                            uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 );
+   // Constructor with backlight control
+   LiquidCrystal_SI2CLanes (SI2CLanes &lanes, uint8_t lane, uint8_t lcd_Addr,
+                            uint8_t En, uint8_t Rw, uint8_t Rs,
+                            uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
+                            uint8_t backlighPin, t_backlighPol pol);
+
+   /*!
+    @function
+    @abstract   LCD initialization and associated HW.
+    @discussion Initializes the LCD to a given size (col, row). This methods
+    initializes the LCD, therefore, it MUST be called prior to using any other
+    method from this class or parent class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Queues the expander words of a value on the lane of the LCD.
+    The writes are sent by the next flush.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    @result     false if a flushed write was not acknowledged.
+    */
+   virtual bool send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Sets the pin to control the backlight.
+    @discussion Sets the pin in the device to control the backlight. This device
+    doesn't support dimming backlight capability.
+
+    @param      value: expander pin of the backlight (0, .., 7).
+    @param      pol: polarity POSITIVE|NEGATIVE.
+    */
+   void setBacklightPin ( uint8_t value, t_backlighPol pol );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    @discussion Switch-on/off the LCD backlight.
+    The setBacklightPin has to be called before setting the backlight for
+    this method to work. @see setBacklightPin.
+
+    @param      value: backlight mode (HIGH|LOW)
+    */
+   void setBacklight ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Queues the current backlight state and flushes the lanes.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void );
+
+   /*!
+    @function
+    @abstract   Sends the queued writes of all the lanes.
+    @discussion Same as calling flush on the SI2CLanes object.
+    */
+   void flush ( void );
+
+private:
+
+   /*!
+    @method
+    @abstract   Initializes the LCD class
+    @discussion Initializes the LCD class and IO expansion module.
+    */
+   int  init();
+
+   /*!
+    @function
+    @abstract   Initialises class private variables
+    @discussion This is the class single point for initialising private variables.
+    */
+   void config (uint8_t lane, uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
+                uint8_t Rs, uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 );
+
+
+   SI2CLanes &_lanes;          // Parallel software I2C buses
+   uint8_t _lane;              // Lane of the LCD
+   uint8_t _Addr;              // I2C Address of the IO expander
+   uint8_t _backlightPinMask;  // Backlight IO pin mask
+   uint8_t _backlightStsMask;  // Backlight status mask
+   uint8_t _En;                // LCD expander word for enable pin
+   uint8_t _Rw;                // LCD expander word for R/W pin
+   uint8_t _Rs;                // LCD expander word for Register Select pin
+   uint8_t _nibbleMap[16];     // Nibble to LCD data lines mapping
+   bool    _initialised;       // begin has been called
+
+};
+
+#else
+#error "ONLY SUPPORTED ON AVR PROCESSORS"
+#endif // defined (__AVR__)
+
+#endif
@@ -0,0 +1,258 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SPI.cpp
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using a latching shift register driven by the
+// hardware SPI.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. The shift register wiring and pin mapping are the ones of
+// LiquidCrystal_SR3W, the data and clock lines are the SPI MOSI and SCK.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include <SPI.h>
+
+#include "LiquidCrystal_SPI.h"
+#include "FastIO.h"
+
+/*!
+ @defined
+ @abstract   LCD_NOBACKLIGHT
+ @discussion No BACKLIGHT MASK
+ */
+#define LCD_NOBACKLIGHT 0x00
+
+/*!
+ @defined
+ @abstract   LCD_BACKLIGHT
+ @discussion BACKLIGHT MASK used when backlight is on
+ */
+#define LCD_BACKLIGHT   0xFF
+
+
+// Default library configuration parameters used by class constructor with
+// only the strobe pin, same as LiquidCrystal_SR3W.
+// ---------------------------------------------------------------------------
+/*!
+ @defined
+ @abstract   Enable bit of the LCD
+ @discussion Defines the IO of the expander connected to the LCD's Enable
+ */
+#define EN 4  // Enable bit
+
+/*!
+ @defined
+ @abstract   Read/Write bit of the LCD
+ @discussion Defines the IO of the expander connected to the LCD's Rw pin
+ */
+#define RW 5  // Read/Write bit
+
+/*!
+ @defined
+ @abstract   Register bit of the LCD
+ @discussion Defines the IO of the expander connected to the LCD's Register select pin
+ */
+#define RS 6  // Register select bit
+
+/*!
+ @defined
+ @abstract   LCD dataline allocation this library only supports 4 bit LCD control
+ mode.
+ @discussion D4, D5, D6, D7 LCD data lines pin mapping of the extender module
+ */
+#define D4 0
+#define D5 1
+#define D6 2
+#define D7 3
+
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_SPI::LiquidCrystal_SPI(uint8_t strobe)
+{
+   init( strobe, RS, RW, EN, D4, D5, D6, D7 );
+}
+
+LiquidCrystal_SPI::LiquidCrystal_SPI(uint8_t strobe, uint8_t backlighPin,
+                                     t_backlighPol pol)
+{
+   init( strobe, RS, RW, EN, D4, D5, D6, D7 );
+   setBacklightPin(backlighPin, pol);
+}
+
+LiquidCrystal_SPI::LiquidCrystal_SPI(uint8_t strobe, uint8_t En, uint8_t Rw,
+                                     uint8_t Rs, uint8_t d4, uint8_t d5,
+                                     uint8_t d6, uint8_t d7 )
+{
+   init( strobe, Rs, Rw, En, d4, d5, d6, d7 );
+}
+
+LiquidCrystal_SPI::LiquidCrystal_SPI(uint8_t strobe, uint8_t En, uint8_t Rw,
+                                     uint8_t Rs, uint8_t d4, uint8_t d5,
+                                     uint8_t d6, uint8_t d7,
+                                     uint8_t backlighPin, t_backlighPol pol)
+{
+   init( strobe, Rs, Rw, En, d4, d5, d6, d7 );
+   setBacklightPin(backlighPin, pol);
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_SPI::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   SPI.begin ( );
+   _initialised = true;
+   LCD::begin ( cols, lines, dotsize );
+   flushBacklight ( );
+}
+
+//
+// send
+bool LiquidCrystal_SPI::send(uint8_t value, uint8_t mode)
+{
+   uint8_t buf[4];
+   uint8_t len = 0;
+
+   // Is it a command or data, merge the control lines once for both nibbles
+   // ----------------------------------------------------------------------
+   uint8_t control = ( mode == LCD_DATA ) ? ( _Rs | _backlightStsMask )
+                                          : _backlightStsMask;
+
+   // Each nibble is loaded with En HIGH then with En LOW
+   if ( mode != FOUR_BITS )
+   {
+      buf[1] = _nibbleMap[value >> 4] | control;       // upper nibble
+      buf[0] = buf[1] | _En;
+      len = 2;
+   }
+   buf[len+1] = _nibbleMap[value & 0x0F] | control;    // lower nibble
+   buf[len]   = buf[len+1] | _En;
+   len += 2;
+
+   // Wait for the previous write to have been executed by the LCD
+   while ( ( micros ( ) - _lastSend ) < LCD_SPI_EXEC_TIME );
+
+   loadSR ( buf, len );
+   _lastSend = micros ( );
+
+   return true;
+}
+
+//
+// setBacklightPin
+void LiquidCrystal_SPI::setBacklightPin ( uint8_t value, t_backlighPol pol = POSITIVE )
+{
+   _backlightPinMask = ( 1 << value );
+   _backlightStsMask = LCD_NOBACKLIGHT;
+   _polarity = pol;
+   setBacklight (BACKLIGHT_OFF);     // Set backlight to off as initial setup
+}
+
+//
+// setBacklight
+void LiquidCrystal_SPI::setBacklight ( uint8_t value )
+{
+   // Check if backlight is available
+   // ----------------------------------------------------
+   if ( _backlightPinMask != 0x0 )
+   {
+      // Check for polarity to configure mask accordingly
+      // ----------------------------------------------------------
+      if  (((_polarity == POSITIVE) && (value > 0)) ||
+           ((_polarity == NEGATIVE ) && ( value == 0 )))
+      {
+         _backlightStsMask = _backlightPinMask & LCD_BACKLIGHT;
+      }
+      else
+      {
+         _backlightStsMask = _backlightPinMask & LCD_NOBACKLIGHT;
+      }
+      if ( !_deferredBacklight )
+      {
+         flushBacklight ( );
+      }
+   }
+}
+
+//
+// flushBacklight
+void LiquidCrystal_SPI::flushBacklight ( void )
+{
+   // No SPI traffic before SPI.begin, begin latches the backlight state.
+   if ( _initialised && ( _backlightPinMask != 0x0 ) )
+   {
+      loadSR ( &_backlightStsMask, 1 );
+   }
+}
+
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// init
+void LiquidCrystal_SPI::init(uint8_t strobe, uint8_t Rs, uint8_t Rw, uint8_t En,
+                             uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7)
+{
+   _strobe     = fio_pinToBit(strobe);
+   _strobe_reg = fio_pinToOutputRegister(strobe);
+
+   // LCD pin mapping
+   _backlightPinMask = 0;
+   _backlightStsMask = LCD_NOBACKLIGHT;
+   _polarity = POSITIVE;
+   _lastSend = 0;
+   _initialised = false;
+
+   _En = ( 1 << En );
+   _Rw = ( 1 << Rw );
+   _Rs = ( 1 << Rs );
+
+   // Initialise pin mapping, one expander word per nibble value
+   mapNibbles ( _nibbleMap, d4, d5, d6, d7 );
+
+   _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+}
+
+//
+// loadSR
+void LiquidCrystal_SPI::loadSR(const uint8_t *buf, uint8_t len)
+{
+   SPI.beginTransaction ( SPISettings ( LCD_SPI_CLOCK, MSBFIRST, SPI_MODE0 ) );
+   for ( uint8_t i = 0; i < len; i++ )
+   {
+      // transfer returns once the byte is in the shift register, the En
+      // HIGH time is the time it takes to shift the next byte (1us at 8MHz)
+      SPI.transfer ( buf[i] );
+
+      // Strobe the data into the latch
+      FIO_ATOMIC_BLOCK
+      {
+         fio_digitalWrite_HIGH(_strobe_reg, _strobe);
+         fio_digitalWrite_SWITCHTO(_strobe_reg, _strobe, LOW);
+      }
+   }
+   SPI.endTransaction ( );
+}
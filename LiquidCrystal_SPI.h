@@ -0,0 +1,224 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SPI.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using a latching shift register driven by the
+// hardware SPI.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. It drives the same 74HC595 wiring as LiquidCrystal_SR3W, with
+// the shift register data and clock connected to the MCU SPI MOSI and SCK
+// pins instead of general purpose IOs, and any digital IO as latch (strobe).
+// The SPI peripheral shifts a byte in 8 SPI clocks (1us at 8MHz) where
+// fio_shiftOut needs several times that, and it shares the bus with other
+// SPI devices (SD cards, ...) through SPI.beginTransaction.
+//
+//   +--------------------------------------------+
+//   |                 MCU                        |
+//   |   IO (latch)    MOSI          SCK          |
+//   +----+-------------+-------------+-----------+
+//        |             |             |
+//   +----+-------------+-------------+-----------+
+//   |    Strobe        Data          Clock       |
+//   |          8-bit shift/latch register        | 74HC595N
+//   |    Qa0  Qb1  Qc2  Qd3  Qe4  Qf5  Qg6  Qh7  |
+//   +----+----+----+----+----+----+----+----+----+
+//        |    |    |    |    |    |    |
+//        |11  |12  |13  |14  |6   |5   |4   (LCD pins)
+//   +----+----+----+----+----+----+----+----+----+
+//   |    DB4  DB5  DB6  DB7  E    Rw   RS        |
+//   |                 LCD Module                 |
+//
+// NOTE: Rw is not used by the driver so it can be connected to GND. The
+// pin mapping of the shift register outputs is configurable as in
+// LiquidCrystal_SR3W.
+//
+// The sketch has to include SPI.h.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef _LIQUIDCRYSTAL_SPI_H_
+#define _LIQUIDCRYSTAL_SPI_H_
+
+#include <inttypes.h>
+#include "LCD.h"
+#include "FastIO.h"
+
+/*!
+ @defined
+ @abstract   SPI clock frequency of the shift register.
+ @discussion The 74HC595 takes well above 8MHz, the maximum SPI clock of a
+ 16MHz AVR. Lower it for long wires.
+ */
+#ifndef LCD_SPI_CLOCK
+#define LCD_SPI_CLOCK        8000000
+#endif
+
+/*!
+ @defined
+ @abstract   Execution time of a command or data write.
+ @discussion 37us, plus the resolution of micros() (4us on 16MHz AVRs) as
+ the wait is measured with it.
+ */
+#define LCD_SPI_EXEC_TIME    41
+
+
+class LiquidCrystal_SPI : public LCD
+{
+public:
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the IO driving the
+    shift register latch. The constructor does not initialize the LCD.
+    Default configuration:
+       Shift register      LCD
+       QA - 0              DB4
+       QB - 1              DB5
+       QC - 2              DB6
+       QD - 3              DB7
+       QE - 4              E
+       QF - 5
+       QG - 6              Rs
+       GND                 Rw
+
+    @param      strobe[in] digital IO connected to shiftregister strobe pin.
+    */
+   LiquidCrystal_SPI(uint8_t strobe);
+   // Constructor with backlight control
+   LiquidCrystal_SPI(uint8_t strobe, uint8_t backlighPin, t_backlighPol pol);
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the control lines of
+    the LCD and the shiftregister. The constructor does not initialize the LCD.
+
+    @param      strobe[in] digital IO connected to shiftregister strobe pin.
+    @param      En[in] LCD En (Enable) pin connected to SR output pin.
+    @param      Rw[in] LCD Rw (Read/write) pin connected to SR output pin.
+    @param      Rs[in] LCD Rs (Reg Select) pin connected to SR output pin.
+    @param      d4[in] LCD data 4 pin map to the SR output pin.
+    @param      d5[in] LCD data 5 pin map to the SR output pin.
+    @param      d6[in] LCD data 6 pin map to the SR output pin.
+    @param      d7[in] LCD data 7 pin map to the SR output pin.
+    */
+   LiquidCrystal_SPI(uint8_t strobe, uint8_t En, uint8_t Rw, uint8_t Rs,
+                     uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 );
+   // Constructor with backlight control
+   LiquidCrystal_SPI(uint8_t strobe, uint8_t En, uint8_t Rw, uint8_t Rs,
+                     uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
+                     uint8_t backlighPin, t_backlighPol pol);
+
+   /*!
+    @function
+    @abstract   LCD initialization and associated HW.
+    @discussion Initializes the SPI bus and the LCD to a given size (col, row).
+    This methods initializes the LCD, therefore, it MUST be called prior to
+    using any other method from this class or parent class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command. The expander words of both nibbles are shifted and
+    latched back to back in one SPI transaction. It does not wait for the
+    LCD to execute the write, the next send waits for whatever remains of
+    the execution time.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual bool send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Sets the pin to control the backlight.
+    @discussion Sets the pin in the device to control the backlight. This device
+    doesn't support dimming backlight capability.
+
+    @param      value: pin mapped on the 74HC595N (0, .., 7) for (Qa0, .., Qh7)
+    respectively.
+    @param      pol: polarity POSITIVE|NEGATIVE.
+    */
+   void setBacklightPin ( uint8_t value, t_backlighPol pol );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    @discussion Switch-on/off the LCD backlight.
+    The setBacklightPin has to be called before setting the backlight for
+    this method to work. @see setBacklightPin.
+
+    @param      value: backlight mode (HIGH|LOW)
+    */
+   void setBacklight ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Writes the current backlight state to the shift register. Only needed in
+    deferred backlight mode when no other transfer is pending. Does nothing
+    before begin, which latches the backlight state.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void );
+
+private:
+
+   /*!
+    @method
+    @abstract   Initializes the LCD class
+    @discussion Initializes the LCD class and the latch pin.
+    */
+   void init(uint8_t strobe, uint8_t Rs, uint8_t Rw, uint8_t En,
+             uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7);
+
+   /*!
+    @method
+    @abstract   Shifts and latches a sequence of bytes.
+    @discussion Each byte is shifted by the SPI and latched on the shift
+    register outputs before the next one is shifted, all in one SPI
+    transaction.
+    @param      buf[in] bytes to load.
+    @param      len[in] number of bytes.
+    */
+   void loadSR(const uint8_t *buf, uint8_t len);
+
+
+   fio_bit      _strobe;           // shift register strobe pin
+   fio_register _strobe_reg;       // SR strobe pin MCU register
+   uint8_t      _En;               // LCD expander word for enable pin
+   uint8_t      _Rw;               // LCD expander word for R/W pin
+   uint8_t      _Rs;               // LCD expander word for Register Select pin
+   uint8_t      _nibbleMap[16];    // Nibble to LCD data lines mapping
+   uint8_t      _backlightPinMask; // Backlight IO pin mask
+   uint8_t      _backlightStsMask; // Backlight status mask
+   unsigned long _lastSend;        // micros() of the last LCD write
+   bool         _initialised;      // begin has been called
+
+};
+
+#endif
@@ -145,7 +145,7 @@ void LiquidCrystal_SR::shiftIt(uint8_t val)
       // Clear to get Enable LOW
       fio_shiftOut(_srDataRegister, _srDataBit, _srClockRegister, _srClockBit);
    }
-   fio_shiftOut(_srDataRegister, _srDataBit, _srClockRegister, _srClockBit, val, MSBFIRST);
+   fio_shiftOut<MSBFIRST>(_srDataRegister, _srDataBit, _srClockRegister, _srClockBit, val);
    
    // LCD ENABLE PULSE
    //
@@ -154,10 +154,10 @@ void LiquidCrystal_SR::shiftIt(uint8_t val)
    // latch. The shiftregister latch pin (STR, RCL or similar) is then
    // connected to the LCD enable pin. The LCD is (very likely) slower
    // to read the Enable pulse, and then reads the new contents of the SR.
-   ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+   FIO_ATOMIC_BLOCK
    {
       fio_digitalWrite_HIGH(_srEnableRegister, _srEnableBit);
-      delayMicroseconds (1);         // enable pulse must be >450ns               
+      fio_delay_ns<LCD_T_PWEH> ( );  // enable pulse must be >450ns               
       fio_digitalWrite_SWITCHTO(_srEnableRegister, _srEnableBit, LOW);
    } // end critical section
 }
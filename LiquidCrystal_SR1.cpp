@@ -0,0 +1,144 @@
+// ---------------------------------------------------------------------------
+// Copyright 2012 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SR1.cpp
+// Connects a hd44780 LCD using 1 pin from the Arduino, via a latching shift
+// register and the Shift1 protocol developed by Roman Black
+// (http://www.romanblack.com/shift1.htm).
+//
+// @brief
+// This is the Shift1 interface class for the LCD library.
+//
+// See the corresponding SR1 header file for full details.
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include "LiquidCrystal_SR1.h"
+
+#include "FastIO.h"
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_SR1::LiquidCrystal_SR1 ( uint8_t srdata, t_sr1_wiring wiring,
+                                       t_backlighPol blpol )
+{
+   _srRegister = fio_pinToOutputRegister ( srdata, HIGH );
+   _srMask = fio_pinToBit ( srdata );
+
+   _wiring = wiring;
+   _blPolarity = blpol;
+   _blMask = 0;
+
+   if ( _wiring == SR1_CHAINED )
+   {
+      _displayfunction = LCD_8BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   }
+   else
+   {
+      _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   }
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_SR1::begin ( uint8_t cols, uint8_t lines, uint8_t dotsize )
+{
+   // Charge the capacitors and leave the outputs cleared
+   fio_shiftOut1_init ( _srRegister, _srMask );
+   loadSR ( 0, 0 );
+
+   LCD::begin ( cols, lines, dotsize );
+}
+
+/************ low level data pushing commands **********/
+//
+// send
+bool LiquidCrystal_SR1::send ( uint8_t value, uint8_t mode )
+{
+   uint8_t control = ( mode == LCD_DATA ) ? SR1_RS_MASK : 0;
+
+   control |= _blMask;
+
+   if ( _wiring == SR1_CHAINED )
+   {
+      // 8 bit mode, the whole byte is on the second shift register
+      loadSR ( control | SR1_EN_MASK, value );
+      loadSR ( control, value );
+      return true;
+   }
+
+   // 4 bit mode, one nibble at a time
+   for ( int8_t shift = ( mode == FOUR_BITS ) ? 0 : 4; shift >= 0; shift -= 4 )
+   {
+      uint8_t data = control;
+
+      if ( value & _BV(shift) )     data |= SR1_D4_MASK;
+      if ( value & _BV(shift + 1) ) data |= SR1_D5_MASK;
+      if ( value & _BV(shift + 2) ) data |= SR1_D6_MASK;
+      if ( value & _BV(shift + 3) ) data |= SR1_D7_MASK;
+
+      loadSR ( data | SR1_EN_MASK, 0 ); // Send with enable high
+      loadSR ( data, 0 );               // Send with enable low
+   }
+   return true;
+}
+
+//
+// setBacklight
+void LiquidCrystal_SR1::setBacklight ( uint8_t value )
+{
+   // Check for polarity to configure mask accordingly
+   // ----------------------------------------------------------
+   if  ( ((_blPolarity == POSITIVE) && (value > 0)) ||
+         ((_blPolarity == NEGATIVE ) && ( value == 0 )) )
+   {
+      _blMask = SR1_BL_MASK;
+   }
+   else
+   {
+      _blMask = 0;
+   }
+
+   if ( !_deferredBacklight )
+   {
+      flushBacklight ( );
+   }
+}
+
+//
+// flushBacklight
+void LiquidCrystal_SR1::flushBacklight ( void )
+{
+   // EN stays LOW, the LCD does not see this load
+   loadSR ( _blMask, 0 );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// loadSR
+void LiquidCrystal_SR1::loadSR ( uint8_t control, uint8_t data )
+{
+   if ( _wiring == SR1_CHAINED )
+   {
+      // Pushed to the second shift register by the control byte
+      fio_shiftOut1 ( _srRegister, _srMask, data, true );
+   }
+   fio_shiftOut1 ( _srRegister, _srMask, control );
+}
@@ -0,0 +1,160 @@
+// ---------------------------------------------------------------------------
+// Copyright 2012 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SR1.h
+// Connects a hd44780 LCD using 1 pin from the Arduino, via a latching shift
+// register and the Shift1 protocol developed by Roman Black
+// (http://www.romanblack.com/shift1.htm).
+//
+// @brief
+// This is the Shift1 interface class for the LCD library, it uses the
+// fio_shiftOut1 primitive of FastIO.
+//
+// The pin drives the shift register clock directly, the data input through
+// a short RC (~15us) and the latch through a long RC (~200us): a short LOW
+// pulse shifts a '1', a long LOW a '0' and a very long LOW latches the
+// outputs. The timing is set by the FIO_SHIFT1_* budgets of FastIO.h.
+//
+// Single shift register (SR1_SINGLE), LCD in 4 bit mode, shifted MSB first:
+// Bit #0 (QA) - not used (always LOW, shifted by the latch sequence)
+// Bit #1 (QB) - LCD D4
+// Bit #2 (QC) - LCD D5
+// Bit #3 (QD) - LCD D6
+// Bit #4 (QE) - LCD D7
+// Bit #5 (QF) - LCD RS
+// Bit #6 (QG) - LCD EN
+// Bit #7 (QH) - optional backlight control
+//
+// Two chained shift registers (SR1_CHAINED), LCD in 8 bit mode: the second
+// shift register (Q'H of the first one to its serial input) carries D0..D7
+// on QA..QH and the first one RS, EN and the backlight as above. The data
+// byte is shifted without latch (noLatch) and latched together with the
+// control byte.
+//
+// Speed, with the reference RC values (1 bit: 16us, 0 bit: 45us, latch:
+// 500us):
+//    SR1_SINGLE:  4 latched loads per character, 2.5 to 3ms per character.
+//    SR1_CHAINED: 2 latched loads of 16 bits, 1.5 to 2.4ms per character.
+// LiquidCrystal_SR1W takes 0.1 to 0.2ms per character, 15 to 20 times
+// less, with a diode and a different RC network. This driver is meant for
+// the boards built around the original Shift1 circuit.
+//
+// The LCD RW pin has to be connected to GND.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef _LIQUIDCRYSTAL_SR1_
+#define _LIQUIDCRYSTAL_SR1_
+
+#include <inttypes.h>
+#include "LCD.h"
+#include "FastIO.h"
+
+// Shift1 SR output bit constants
+// ---------------------------------------------------------------------------
+#define SR1_D4_MASK        0x02
+#define SR1_D5_MASK        0x04
+#define SR1_D6_MASK        0x08
+#define SR1_D7_MASK        0x10
+#define SR1_RS_MASK        0x20
+#define SR1_EN_MASK        0x40
+#define SR1_BL_MASK        0x80
+
+typedef enum { SR1_SINGLE, SR1_CHAINED } t_sr1_wiring;
+
+class LiquidCrystal_SR1 : public LCD
+{
+public:
+   /*!
+    @method
+    @abstract   LCD Shift1 SHIFT REGISTER constructor.
+    @discussion Defines the pin connected to the shift register. The
+    constructor does not initialize the LCD.
+
+    @param srdata[in]   Arduino pin for shift register.
+    @param wiring[in]   SR1_SINGLE (4 bit mode) or SR1_CHAINED (8 bit mode).
+    @param blpol[in]    optional backlight polarity (default = POSITIVE)
+    */
+   LiquidCrystal_SR1 ( uint8_t srdata, t_sr1_wiring wiring = SR1_SINGLE,
+                       t_backlighPol blpol = POSITIVE );
+
+   /*!
+    @function
+    @abstract   LCD initialization and associated HW.
+    @discussion Charges the Shift1 capacitors and initializes the LCD to a
+    given size (col, row). This methods initializes the LCD, therefore, it
+    MUST be called prior to using any other method from this class or parent
+    class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin ( uint8_t cols, uint8_t rows,
+                        uint8_t charsize = LCD_5x8DOTS );
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command using the shift register. Each load takes longer than
+    the LCD execution time, no further delay is needed.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in]  DATA=8bit data, COMMAND=8bit cmd, FOUR_BITS=4bit cmd
+    the LCD.
+    */
+   virtual bool send ( uint8_t value, uint8_t mode );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    @discussion Switch-on/off the LCD backlight.
+
+    @param      mode[in] backlight mode (0 off, non-zero on)
+    */
+   void setBacklight ( uint8_t mode );
+
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Loads the backlight state with EN LOW. Only needed in
+    deferred backlight mode when no other transfer is pending.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void );
+
+private:
+
+   /*!
+    @method
+    @abstract   Loads and latches the shift register(s).
+    @discussion In SR1_CHAINED wiring the data byte is shifted first without
+    latch.
+    @param      control[in] word of the (first) shift register.
+    @param      data[in] LCD data lines (SR1_CHAINED only).
+    */
+   void loadSR ( uint8_t control, uint8_t data );
+
+   fio_register _srRegister; // Serial PIN
+   fio_bit _srMask;
+
+   t_sr1_wiring _wiring;
+
+   uint8_t _blPolarity;
+   uint8_t _blMask;
+};
+
+#endif
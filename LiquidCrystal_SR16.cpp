@@ -0,0 +1,226 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SR16.cpp
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using two chained latching shift registers and the
+// LCD in 8 bit mode.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. @see LiquidCrystal_SR16.h for the wiring.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include "LiquidCrystal_SR16.h"
+
+#include "FastIO.h"
+
+/*!
+ @defined
+ @abstract   LCD_NOBACKLIGHT
+ @discussion No BACKLIGHT MASK
+ */
+#define LCD_NOBACKLIGHT 0x00
+
+/*!
+ @defined
+ @abstract   LCD_BACKLIGHT
+ @discussion BACKLIGHT MASK used when backlight is on
+ */
+#define LCD_BACKLIGHT   0xFF
+
+/*!
+ @defined
+ @abstract   Register bit of the LCD
+ @discussion Defines the output of the second shift register connected to
+ the LCD's Register select pin
+ */
+#define RS 0  // Register select bit
+
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_SR16::LiquidCrystal_SR16(uint8_t data, uint8_t clk, uint8_t strobe)
+{
+   init( data, clk, strobe, RS );
+}
+
+LiquidCrystal_SR16::LiquidCrystal_SR16(uint8_t data, uint8_t clk, uint8_t strobe,
+                                       uint8_t backlighPin, t_backlighPol pol)
+{
+   init( data, clk, strobe, RS );
+   setBacklightPin(backlighPin, pol);
+}
+
+LiquidCrystal_SR16::LiquidCrystal_SR16(uint8_t data, uint8_t clk, uint8_t strobe,
+                                       uint8_t Rs)
+{
+   init( data, clk, strobe, Rs );
+}
+
+LiquidCrystal_SR16::LiquidCrystal_SR16(uint8_t data, uint8_t clk, uint8_t strobe,
+                                       uint8_t Rs, uint8_t backlighPin,
+                                       t_backlighPol pol)
+{
+   init( data, clk, strobe, Rs );
+   setBacklightPin(backlighPin, pol);
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_SR16::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   _initialised = true;
+   LCD::begin ( cols, lines, dotsize );
+}
+
+//
+// send
+bool LiquidCrystal_SR16::send(uint8_t value, uint8_t mode)
+{
+   uint8_t control = ( _gpioMask & ~( _Rs | _backlightPinMask ) ) |
+                     _backlightStsMask;
+
+   if ( mode == LCD_DATA )
+   {
+      control |= _Rs;
+   }
+
+   // Wait for the previous write to have been executed by the LCD
+   while ( ( micros ( ) - _lastSend ) < LCD_SR16_EXEC_TIME );
+
+   loadSR ( control, value );
+   _lastSend = micros ( );
+
+   return true;
+}
+
+//
+// setBacklightPin
+void LiquidCrystal_SR16::setBacklightPin ( uint8_t value, t_backlighPol pol = POSITIVE )
+{
+   _backlightPinMask = ( 1 << value );
+   _backlightStsMask = LCD_NOBACKLIGHT;
+   _polarity = pol;
+   setBacklight (BACKLIGHT_OFF);     // Set backlight to off as initial setup
+}
+
+//
+// setBacklight
+void LiquidCrystal_SR16::setBacklight ( uint8_t value )
+{
+   // Check if backlight is available
+   // ----------------------------------------------------
+   if ( _backlightPinMask != 0x0 )
+   {
+      // Check for polarity to configure mask accordingly
+      // ----------------------------------------------------------
+      if  (((_polarity == POSITIVE) && (value > 0)) ||
+           ((_polarity == NEGATIVE ) && ( value == 0 )))
+      {
+         _backlightStsMask = _backlightPinMask & LCD_BACKLIGHT;
+      }
+      else
+      {
+         _backlightStsMask = _backlightPinMask & LCD_NOBACKLIGHT;
+      }
+      if ( !_deferredBacklight )
+      {
+         flushBacklight ( );
+      }
+   }
+}
+
+//
+// flushBacklight
+void LiquidCrystal_SR16::flushBacklight ( void )
+{
+   // The latch pulses the LCD enable, repeat the function set as a no-op.
+   // begin latches the backlight state once the LCD is initialised.
+   if ( _initialised )
+   {
+      send ( LCD_FUNCTIONSET | _displayfunction, COMMAND );
+   }
+}
+
+//
+// gpioWrite
+void LiquidCrystal_SR16::gpioWrite ( uint8_t pin, uint8_t level )
+{
+   if ( level == LOW )
+   {
+      _gpioMask &= ~( 1 << pin );
+   }
+   else
+   {
+      _gpioMask |= ( 1 << pin );
+   }
+}
+
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// init
+void LiquidCrystal_SR16::init(uint8_t data, uint8_t clk, uint8_t strobe,
+                              uint8_t Rs)
+{
+   _data       = fio_pinToBit(data);
+   _clk        = fio_pinToBit(clk);
+   _strobe     = fio_pinToBit(strobe);
+   _data_reg   = fio_pinToOutputRegister(data);
+   _clk_reg    = fio_pinToOutputRegister(clk);
+   _strobe_reg = fio_pinToOutputRegister(strobe);
+
+   // LCD pin mapping
+   _backlightPinMask = 0;
+   _backlightStsMask = LCD_NOBACKLIGHT;
+   _polarity = POSITIVE;
+   _gpioMask = 0;
+   _lastSend = 0;
+   _initialised = false;
+
+   _Rs = ( 1 << Rs );
+
+   _displayfunction = LCD_8BITMODE | LCD_1LINE | LCD_5x8DOTS;
+}
+
+//
+// loadSR
+void LiquidCrystal_SR16::loadSR(uint8_t control, uint8_t data)
+{
+   // The first byte shifted ends up in the second shift register
+   fio_shiftOut<MSBFIRST>(_data_reg, _data, _clk_reg, _clk, control);
+   fio_shiftOut<MSBFIRST>(_data_reg, _data, _clk_reg, _clk, data);
+
+   // Strobe the word into the latch, this is the LCD enable pulse: the
+   // outputs change on the rising edge and stay stable until the LCD reads
+   // them on the falling edge, covering the data set-up time.
+   FIO_ATOMIC_BLOCK
+   {
+      fio_digitalWrite_HIGH(_strobe_reg, _strobe);
+      fio_delay_ns<LCD_T_PWEH> ( );
+      fio_digitalWrite_SWITCHTO(_strobe_reg, _strobe, LOW);
+   }
+}
@@ -0,0 +1,220 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SR16.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using two chained latching shift registers and the
+// LCD in 8 bit mode.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. Two daisy chained 74HC595 carry the 8 data lines and the
+// control lines of the LCD, every byte is written with a single 16 bit load
+// where the 4 bit shift register drivers need two (or four) loads. The
+// shift register latch (strobe) drives the LCD Enable: the rising edge puts
+// the new word on the outputs, the LCD reads it on the falling edge.
+//
+//   +--------------------------------------------+
+//   |                 MCU                        |
+//   |   IO1           IO2           IO3          |
+//   +----+-------------+-------------+-----------+
+//        |             |             |
+//        | Data        | Clock       | Strobe ----------------- LCD E
+//   +----+-------------+-------------+-----------+
+//   |          8-bit shift/latch register (1)    | 74HC595N
+//   |    Qa0  Qb1  Qc2  Qd3  Qe4  Qf5  Qg6  Qh7  |
+//   +----+----+----+----+----+----+----+----+----+
+//        |    |    |    |    |    |    |    |    Qh' (serial out)
+//        DB0  DB1  DB2  DB3  DB4  DB5  DB6  DB7  |
+//   +---------------------------------------+----+
+//   |          8-bit shift/latch register (2)    | 74HC595N
+//   |    Qa0  Qb1  Qc2  Qd3  Qe4  Qf5  Qg6  Qh7  |
+//   +----+----+----+----+----+----+----+----+----+
+//        |    |    |    |    |    |    |    |
+//        RS   BL   general purpose outputs
+//
+// NOTE: the LCD Rw has to be connected to GND. The data lines are fixed on
+// the first shift register, RS and the backlight can be on any output of
+// the second one. Its other outputs are general purpose outputs, they are
+// updated with the next LCD write (@see gpioWrite).
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef _LIQUIDCRYSTAL_SR16_H_
+#define _LIQUIDCRYSTAL_SR16_H_
+
+#include <inttypes.h>
+#include "LCD.h"
+#include "FastIO.h"
+
+/*!
+ @defined
+ @abstract   Execution time of a command or data write.
+ @discussion 37us, plus the resolution of micros() (4us on 16MHz AVRs) as
+ the wait is measured with it.
+ */
+#define LCD_SR16_EXEC_TIME   41
+
+
+class LiquidCrystal_SR16 : public LCD
+{
+public:
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the IO driving the
+    shift registers. The constructor does not initialize the LCD.
+    Default configuration of the second shift register:
+       Shift register      LCD
+       QA - 0              Rs
+       QB - 1              Backlight (with setBacklightPin)
+       QC .. QH            general purpose
+
+    @param      data[in] digital IO connected to the shiftregister data pin.
+    @param      clk[in] digital IO connected to the shiftregister clock pin.
+    @param      strobe[in] digital IO connected to shiftregister strobe pin
+    and to the LCD Enable.
+    */
+   LiquidCrystal_SR16(uint8_t data, uint8_t clk, uint8_t strobe);
+   // Constructor with backlight control
+   LiquidCrystal_SR16(uint8_t data, uint8_t clk, uint8_t strobe,
+                      uint8_t backlighPin, t_backlighPol pol);
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the control lines of
+    the LCD and the shiftregister. The constructor does not initialize the LCD.
+
+    @param      data[in] digital IO connected to the shiftregister data pin.
+    @param      clk[in] digital IO connected to the shiftregister clock pin.
+    @param      strobe[in] digital IO connected to shiftregister strobe pin
+    and to the LCD Enable.
+    @param      Rs[in] LCD Rs (Reg Select) pin connected to an output (0..7) of
+    the second shift register.
+    */
+   LiquidCrystal_SR16(uint8_t data, uint8_t clk, uint8_t strobe, uint8_t Rs);
+   // Constructor with backlight control
+   LiquidCrystal_SR16(uint8_t data, uint8_t clk, uint8_t strobe, uint8_t Rs,
+                      uint8_t backlighPin, t_backlighPol pol);
+
+   /*!
+    @function
+    @abstract   LCD initialization and associated HW.
+    @discussion Initializes the LCD to a given size (col, row). This methods
+    initializes the LCD, therefore, it MUST be called prior to using any other
+    method from this class or parent class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command. The 16 bit word is shifted and latched once, the
+    latch pulse being the LCD enable pulse. It does not wait for the LCD to
+    execute the write, the next send waits for whatever remains of the
+    execution time.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual bool send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Sets the pin to control the backlight.
+    @discussion Sets the pin in the device to control the backlight. This device
+    doesn't support dimming backlight capability.
+
+    @param      value: output of the second shift register (0, .., 7).
+    @param      pol: polarity POSITIVE|NEGATIVE.
+    */
+   void setBacklightPin ( uint8_t value, t_backlighPol pol );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    @discussion Switch-on/off the LCD backlight.
+    The setBacklightPin has to be called before setting the backlight for
+    this method to work. @see setBacklightPin.
+
+    @param      value: backlight mode (HIGH|LOW)
+    */
+   void setBacklight ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Every latch pulse is an LCD write, the outputs are updated
+    with a function set command repeating the current configuration.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void );
+
+   /*!
+    @function
+    @abstract   Writes a general purpose output.
+    @discussion Sets the level of an output of the second shift register that
+    is not used by the LCD. The output is updated with the next LCD write,
+    call flushBacklight to update it right away.
+
+    @param      pin[in] output of the second shift register (0, .., 7).
+    @param      level[in] HIGH or LOW.
+    */
+   void gpioWrite ( uint8_t pin, uint8_t level );
+
+private:
+
+   /*!
+    @method
+    @abstract   Initializes the LCD class
+    @discussion Initializes the LCD class and the shift register pins.
+    */
+   void init(uint8_t data, uint8_t clk, uint8_t strobe, uint8_t Rs);
+
+   /*!
+    @method
+    @abstract   Loads and latches a 16 bit word.
+    @discussion The latch pulse is the LCD enable pulse, the word is on the
+    outputs for the whole pulse.
+    @param      control[in] word of the second shift register.
+    @param      data[in] word of the first shift register (LCD data lines).
+    */
+   void loadSR(uint8_t control, uint8_t data);
+
+
+   fio_bit      _strobe;           // shift register strobe pin
+   fio_register _strobe_reg;       // SR strobe pin MCU register
+   fio_bit      _data;             // shift register data pin
+   fio_register _data_reg;         // SR data pin MCU register
+   fio_bit      _clk;              // shift register clock pin
+   fio_register _clk_reg;          // SR clock pin MCU register
+   uint8_t      _Rs;               // LCD expander word for Register Select pin
+   uint8_t      _gpioMask;         // General purpose outputs levels
+   uint8_t      _backlightPinMask; // Backlight IO pin mask
+   uint8_t      _backlightStsMask; // Backlight status mask
+   unsigned long _lastSend;        // micros() of the last LCD write
+   bool         _initialised;      // begin has been called
+
+};
+
+#endif
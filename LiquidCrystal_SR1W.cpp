@@ -55,6 +55,10 @@ void LiquidCrystal_SR1W::init(uint8_t srdata, t_sr1w_circuitType circuitType, t_
    
 	_circuitType = circuitType;
    
+	// Safe delays until calibrate is called
+	_dataDelay = SR1W_DELAY_US;
+	_latchDelay = (circuitType == HW_CLEAR) ? 2 * SR1W_DELAY_US : SR1W_DELAY_US;
+   
 	_blPolarity = blpol;
    
 	_displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
@@ -68,7 +72,7 @@ void LiquidCrystal_SR1W::init(uint8_t srdata, t_sr1w_circuitType circuitType, t_
 // clearSR
 uint8_t LiquidCrystal_SR1W::clearSR()
 {
-	uint8_t numDelays = 0;
+	uint8_t totalDelay = 0;
    
 	// Store these as local variables for extra performance (and smaller compiled sketch size)
 	fio_register srRegister = _srRegister;
@@ -79,9 +83,33 @@ uint8_t LiquidCrystal_SR1W::clearSR()
    
 	// We need to delay to make sure the Data and Latch/EN capacitors are fully discharged
 	// This also triggers the EN pin because of the falling edge.
-	SR1W_DELAY();
+	SR1W_DELAY((_latchDelay > _dataDelay) ? _latchDelay : _dataDelay);
    
-	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	if (!FIO_IRQ_OFF_FITS(SR1W_CLEAR_CYCLES))
+	{
+		// One critical section per clock pulse. A longer LOW time between the
+		// pulses only discharges the Data capacitor further, a '0' is shifted in
+		// regardless.
+		for (int8_t i = 7; i>=0; i--)
+		{
+			FIO_ATOMIC_BLOCK
+			{
+				fio_bit reg_val = *srRegister;
+				*srRegister = reg_val | srMask;
+				if (i > 0)
+				{
+					*srRegister = reg_val & ~srMask;
+				}
+			}
+		}
+		
+		// Give the Data capacitor a chance to fully charge
+		SR1W_DELAY(_dataDelay);
+		
+		return totalDelay;
+	}
+	
+	FIO_ATOMIC_BLOCK
 	{
 		// Pre-calculate these values for extra performance and to make sure the clock pulse is as quick as possible
 		fio_bit reg_val = *srRegister;
@@ -103,16 +131,16 @@ uint8_t LiquidCrystal_SR1W::clearSR()
 	}
    
 	// Give the Data capacitor a chance to fully charge
-	SR1W_DELAY();
+	SR1W_DELAY(_dataDelay);
    
-	return numDelays;
+	return totalDelay;
 }
 
 //
 // loadSR
 uint8_t LiquidCrystal_SR1W::loadSR(uint8_t val)
 {
-	uint8_t numDelays = 0;
+	uint8_t totalDelay = 0;
    
 	// Store these as local variables for extra performance (and smaller compiled sketch size)
 	fio_register srRegister = _srRegister;
@@ -129,12 +157,12 @@ uint8_t LiquidCrystal_SR1W::loadSR(uint8_t val)
 			if (previousBit == 0)
 			{
 				// We need to make sure the Data capacitor has fully recharged
-				SR1W_DELAY();
+				SR1W_DELAY(_dataDelay);
 			}
          
 			previousBit = 1;
          
-			ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+			FIO_ATOMIC_BLOCK
 			{
 				// Pre-calculate these values to make sure the clock pulse is as quick as possible
 				fio_bit reg_val = *srRegister;
@@ -152,7 +180,7 @@ uint8_t LiquidCrystal_SR1W::loadSR(uint8_t val)
 			SR1W_ATOMIC_WRITE_LOW(srRegister, srMask);
          
 			// We need to make sure the Data capacitor has fully discharged
-			SR1W_DELAY();
+			SR1W_DELAY(_dataDelay);
          
 			previousBit = 0;
          
@@ -165,24 +193,50 @@ uint8_t LiquidCrystal_SR1W::loadSR(uint8_t val)
    
 	// For SW_CLEAR, we need to delay to make sure the Latch/EN capacitor is fully charged.
 	//   This triggers the Latch pin because of the rising edge.
-	// For HW_CLEAR, we need to delay to give the hardware time to perform the clear.
-	//   This also gives the Data capacitor a chance to fully charge
-	SR1W_DELAY();
+	// For HW_CLEAR, we need to delay to give the hardware time to perform the clear:
+	//   the NPN base capacitor charges to pull /CLR LOW and has to discharge again to
+	//   release it before the next nibble/byte is shifted in, hence the default of two
+	//   RC times. This also gives the Data capacitor a chance to fully charge.
+	SR1W_DELAY(_latchDelay);
    
-   if (_circuitType == SW_CLEAR)
+	if (_circuitType == SW_CLEAR)
 	{
 		// Clear the shift register to get ready for the next nibble/byte
 		// This also discharges the Latch/EN capacitor which finally triggers the EN pin because of the falling edge.
-		numDelays += clearSR();
-   }
-	else
-	{
-		// For some reason HW_CLEAR isn't totally stable unless we delay a little bit more.
-		// TODO... figure this out...
-		SR1W_DELAY();
+		totalDelay += clearSR();
 	}
    
-	return numDelays;
+	return totalDelay;
+}
+
+//
+// testDelays
+bool LiquidCrystal_SR1W::testDelays(uint8_t sensePin)
+{
+	// QA (bit 0) alternates, it is shifted in after a '0' and after a '1'
+	// to check both the recharge and the discharge of the Data capacitor,
+	// the EN bit has to be shifted right for the outputs to be latched.
+	static const uint8_t patterns[] = { 0x81, 0x82, 0xD5, 0xAA, 0xFF, 0x80 };
+	bool passed = true;
+   
+	// Start from a cleared shift register whatever the previous test left
+	uint8_t dataDelay = _dataDelay;
+	uint8_t latchDelay = _latchDelay;
+	_dataDelay = SR1W_DELAY_US;
+	_latchDelay = 2 * SR1W_DELAY_US;
+	clearSR();
+	_dataDelay = dataDelay;
+	_latchDelay = latchDelay;
+   
+	for (uint8_t n = 0; (n < SR1W_CAL_REPEAT) && passed; n++)
+	{
+		for (uint8_t i = 0; (i < sizeof(patterns)) && passed; i++)
+		{
+			loadSR(patterns[i]);
+			passed = ((digitalRead(sensePin) == HIGH) == ((patterns[i] & 0x01) != 0));
+		}
+	}
+	return passed;
 }
 
 // PUBLIC METHODS
@@ -194,7 +248,7 @@ uint8_t LiquidCrystal_SR1W::loadSR(uint8_t val)
 // send
 bool LiquidCrystal_SR1W::send(uint8_t value, uint8_t mode)
 {
-	uint8_t numDelays = 0;
+	uint8_t totalDelay = 0;
    
 	uint8_t data;
    
@@ -210,7 +264,7 @@ bool LiquidCrystal_SR1W::send(uint8_t value, uint8_t mode)
 		if (value & _BV(6)) data |= SR1W_D6_MASK;
 		if (value & _BV(7)) data |= SR1W_D7_MASK;
       
-		numDelays += loadSR(data);
+		totalDelay += loadSR(data);
 	}
    
 	// lower nibble
@@ -223,16 +277,69 @@ bool LiquidCrystal_SR1W::send(uint8_t value, uint8_t mode)
 	if (value & _BV(2)) data |= SR1W_D6_MASK;
 	if (value & _BV(3)) data |= SR1W_D7_MASK;
    
-	numDelays += loadSR(data);
+	totalDelay += loadSR(data);
    
 	// Make sure we wait at least 40 uS between bytes.
-	unsigned int totalDelay = numDelays * SR1W_DELAY_US;
 	if (totalDelay < 40)
 		delayMicroseconds(40 - totalDelay);
 
 	return true;
 }
 
+//
+// calibrate
+bool LiquidCrystal_SR1W::calibrate ( uint8_t sensePin )
+{
+	uint8_t defaultData = SR1W_DELAY_US;
+	uint8_t defaultLatch = (_circuitType == HW_CLEAR) ? 2 * SR1W_DELAY_US : SR1W_DELAY_US;
+	uint8_t delay;
+   
+	pinMode(sensePin, INPUT);
+   
+	// The board has to work with the default delays to start with
+	_dataDelay = defaultData;
+	_latchDelay = defaultLatch;
+	if (!testDelays(sensePin))
+	{
+		return false;
+	}
+   
+	// Shortest Data capacitor delay with the default Latch/EN delay
+	for (delay = 1; delay < defaultData; delay++)
+	{
+		_dataDelay = delay;
+		if (testDelays(sensePin))
+		{
+			break;
+		}
+	}
+	_dataDelay = delay + SR1W_CAL_MARGIN_US;
+	if (_dataDelay > defaultData)
+	{
+		_dataDelay = defaultData;
+	}
+   
+	// Shortest Latch/EN delay with the delay found above
+	for (delay = 1; delay < defaultLatch; delay++)
+	{
+		_latchDelay = delay;
+		if (testDelays(sensePin))
+		{
+			break;
+		}
+	}
+	_latchDelay = delay + SR1W_CAL_MARGIN_US;
+	if (_latchDelay > defaultLatch)
+	{
+		_latchDelay = defaultLatch;
+	}
+   
+	// Leave the shift register in a known state
+	clearSR();
+   
+	return true;
+}
+
 //
 // setBacklight
 void LiquidCrystal_SR1W::setBacklight ( uint8_t value )
@@ -249,6 +356,16 @@ void LiquidCrystal_SR1W::setBacklight ( uint8_t value )
 		_blMask = 0;
 	}
    
+	if ( !_deferredBacklight )
+	{
+		flushBacklight();
+	}
+}
+
+//
+// flushBacklight
+void LiquidCrystal_SR1W::flushBacklight ( void )
+{
 	// Send a dummy (non-existant) command to allow the backlight PIN to be latched.
 	// The seems to be safe because the LCD appears to treat this as a NOP.
 	send(0, COMMAND);
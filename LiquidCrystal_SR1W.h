@@ -118,7 +118,7 @@
 //
 //
 // Default Shift Register Bits - Shifted MSB first:
-// Bit #0 (QA) - not used
+// Bit #0 (QA) - not used (can be wired to an input pin for calibrate())
 // Bit #1 (QB) - connects to LCD data input D7
 // Bit #2 (QC) - connects to LCD data input D6
 // Bit #3 (QD) - connects to LCD data input D5
@@ -276,9 +276,15 @@
 //   takes between 2.376uS and 4.36uS to fully charge or discharge
 //	 the 2.2n capacitor (1.98n - 2.42n with a 10% tolerance).
 //	We round this up to a 5uS delay to provide an additional safety margin.
+//  It is the default, calibrate() measures the delays of the actual board.
 
 #define SR1W_DELAY_US		5
-#define SR1W_DELAY()		{ delayMicroseconds(SR1W_DELAY_US); numDelays++; }
+#define SR1W_DELAY(us)		{ delayMicroseconds(us); totalDelay += (us); }
+
+// Number of times each test pattern has to be read back correctly by
+// calibrate() and margin added to the shortest delays that passed.
+#define SR1W_CAL_REPEAT		8
+#define SR1W_CAL_MARGIN_US	1
 
 // 1-wire SR output bit constants
 // ---------------------------------------------------------------------------
@@ -292,8 +298,12 @@
 #define SR1W_RS_MASK		0x40
 #define SR1W_EN_MASK		0x80	// This cannot be changed. It has to be the first thing shifted in.
 
-#define SR1W_ATOMIC_WRITE_LOW(reg, mask)	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { *reg &= ~mask; }
-#define SR1W_ATOMIC_WRITE_HIGH(reg, mask)	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { *reg |= mask; }
+#define SR1W_ATOMIC_WRITE_LOW(reg, mask)	FIO_ATOMIC_BLOCK { *reg &= ~mask; }
+#define SR1W_ATOMIC_WRITE_HIGH(reg, mask)	FIO_ATOMIC_BLOCK { *reg |= mask; }
+
+// Interrupts off time of the clearSR burst, it is split in one critical
+// section per clock pulse when it exceeds FIO_MAX_IRQ_OFF_US.
+#define SR1W_CLEAR_CYCLES	32
 
 
 typedef enum { SW_CLEAR, HW_CLEAR } t_sr1w_circuitType;
@@ -343,6 +353,34 @@ public:
     */
    void setBacklight ( uint8_t mode );
    
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Writes the current backlight state to the shift register by sending a NOP command. Only needed in
+    deferred backlight mode when no other transfer is pending.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void );
+   
+   /*!
+    @function
+    @abstract   Calibrates the RC delays of the circuit.
+    @discussion Finds the shortest Data capacitor and Latch/EN (SW_CLEAR) or
+    clear circuit (HW_CLEAR) delays that reliably load the shift register,
+    and uses them plus a small margin instead of the worst case default
+    (SR1W_DELAY_US). The unused shift register output (QA) has to be wired
+    to sensePin: test patterns alternating its value are loaded and read
+    back, a missed latch or a bit shifted wrong breaks the alternation.
+    
+    The patterns are also written to the LCD, call it before begin, which
+    initialises the LCD again.
+    
+    @param      sensePin[in] digital IO connected to the shift register QA.
+    @result     true if the board passed, false if it did not even with the
+    default delays, which are kept then.
+    */
+   bool calibrate ( uint8_t sensePin );
+   
 private:
    
    /*!
@@ -366,11 +404,20 @@ private:
     */
    uint8_t loadSR (uint8_t val);
    
+   /*!
+    * @method
+    * @abstract loads the calibration patterns and checks them on sensePin
+    */
+   bool testDelays (uint8_t sensePin);
+   
    fio_register _srRegister; // Serial PIN
    fio_bit _srMask;
    
    t_sr1w_circuitType _circuitType;
    
+   uint8_t _dataDelay;  // Data capacitor charge/discharge time (us)
+   uint8_t _latchDelay; // Latch/EN capacitor or HW clear circuit time (us)
+   
    uint8_t _blPolarity;
    uint8_t _blMask;
 };
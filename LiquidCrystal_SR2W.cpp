@@ -68,14 +68,14 @@ void LiquidCrystal_SR2W::loadSR(uint8_t val)
    
    
 	// clock out SR data byte
-	fio_shiftOut(_srDataRegister, _srDataMask, _srClockRegister, _srClockMask, val, MSBFIRST);
+	fio_shiftOut<MSBFIRST>(_srDataRegister, _srDataMask, _srClockRegister, _srClockMask, val);
    
  	
 	// strobe LCD enable which can now be toggled by the data line
-	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	FIO_ATOMIC_BLOCK
 	{
 		fio_digitalWrite_HIGH(_srDataRegister, _srDataMask);
-		waitUsec (1);         // enable pulse must be >450ns               
+		fio_delay_ns<LCD_T_PWEH> ( );  // enable pulse must be >450ns               
 		fio_digitalWrite_SWITCHTO(_srDataRegister, _srDataMask, LOW);
 	} // end critical section
 }
@@ -130,6 +130,16 @@ void LiquidCrystal_SR2W::setBacklight ( uint8_t value )
 		_blMask = 0;
 	}
    
+	if ( !_deferredBacklight )
+	{
+		flushBacklight();
+	}
+}
+
+//
+// flushBacklight
+void LiquidCrystal_SR2W::flushBacklight ( void )
+{
 	// send dummy data of blMask to set BL pin
 	// Note: loadSR() will strobe the data line trying to pulse EN
 	// but E will not strobe because the EN output bit is not set.
@@ -176,6 +176,15 @@ public:
     */
    void setBacklight ( uint8_t mode );
    
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Writes the current backlight state to the shift register. Only needed in
+    deferred backlight mode when no other transfer is pending.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void );
+   
 private:
    
    /*!
@@ -128,6 +128,15 @@
 #define D6 2
 #define D7 3
 
+/*!
+ @defined 
+ @abstract   Execution time of a command or data write in latch as enable
+ mode.
+ @discussion 37us, plus the resolution of micros() (4us on 16MHz AVRs) as
+ the wait is measured with it.
+ */
+#define SR3W_EXEC_TIME 41
+
 
 
 LiquidCrystal_SR3W::LiquidCrystal_SR3W(uint8_t data, uint8_t clk, uint8_t strobe)
@@ -159,15 +168,39 @@ LiquidCrystal_SR3W::LiquidCrystal_SR3W(uint8_t data, uint8_t clk, uint8_t strobe
 }
 
 
+void LiquidCrystal_SR3W::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   _initialised = true;
+   LCD::begin ( cols, lines, dotsize );
+}
+
+
 bool LiquidCrystal_SR3W::send(uint8_t value, uint8_t mode)
 {
    
+   // Is it a command or data, merge the control lines once for both nibbles
+   // ----------------------------------------------------------------------
+   uint8_t control = ( mode == LCD_DATA ) ? ( _Rs | _backlightStsMask ) 
+                                          : _backlightStsMask;
+   
+   if ( _strobeEnable )
+   {
+      // The loads are too fast to cover the execution time, wait for what
+      // remains of it from the previous write
+      while ( ( micros ( ) - _lastSend ) < SR3W_EXEC_TIME );
+   }
+   
    if ( mode != FOUR_BITS )
    {
-      write4bits( (value >> 4), mode ); // upper nibble
+      write4bits( (value >> 4), control ); // upper nibble
    }   
-   write4bits( (value & 0x0F), mode); // lower nibble
+   write4bits( (value & 0x0F), control); // lower nibble
 
+   if ( _strobeEnable )
+   {
+      _lastSend = micros ( );
+      return true;
+   }
 
 #if (F_CPU <= 16000000)
    // No need to use the delay routines on AVR since the time taken to write
@@ -207,7 +240,32 @@ void LiquidCrystal_SR3W::setBacklight ( uint8_t value )
       {
          _backlightStsMask = _backlightPinMask & LCD_NOBACKLIGHT;
       }
-      loadSR( _backlightStsMask );
+      if ( !_deferredBacklight )
+      {
+         flushBacklight ( );
+      }
+   }
+}
+
+//
+// flushBacklight
+void LiquidCrystal_SR3W::flushBacklight ( void )
+{
+   if ( _backlightPinMask != 0x0 )
+   {
+      if ( _strobeEnable )
+      {
+         // Every strobe is an LCD write, repeat the function set as a no-op.
+         // begin latches the backlight state once the LCD is initialised.
+         if ( _initialised )
+         {
+            send ( LCD_FUNCTIONSET | _displayfunction, COMMAND );
+         }
+      }
+      else
+      {
+         loadSR( _backlightStsMask );
+      }
    }
 }
 
@@ -231,55 +289,62 @@ int LiquidCrystal_SR3W::init(uint8_t data, uint8_t clk, uint8_t strobe,
    _backlightStsMask = LCD_NOBACKLIGHT;
    _polarity = POSITIVE;
    
-   _En = ( 1 << En );
+   _strobeEnable = ( En == SR3W_EN_STROBE );
+   _En = _strobeEnable ? 0 : ( 1 << En );
    _Rw = ( 1 << Rw );
+   _lastSend = 0;
+   _initialised = false;
    _Rs = ( 1 << Rs );
    
-   // Initialise pin mapping
-   _data_pins[0] = ( 1 << d4 );
-   _data_pins[1] = ( 1 << d5 );
-   _data_pins[2] = ( 1 << d6 );
-   _data_pins[3] = ( 1 << d7 );
+   // Initialise pin mapping, one expander word per nibble value
+   mapNibbles ( _nibbleMap, d4, d5, d6, d7 );
    
    _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
    
    return (1);
 }
 
-void LiquidCrystal_SR3W::write4bits(uint8_t value, uint8_t mode)
+void LiquidCrystal_SR3W::write4bits(uint8_t value, uint8_t control)
 {
-   uint8_t pinMapValue = 0;
+   // Map the value to LCD pin mapping and add the control lines
+   // ----------------------------------------------------------
+   uint8_t pinMapValue = _nibbleMap[value & 0x0F] | control;
    
-   // Map the value to LCD pin mapping
-   // --------------------------------
-   for ( uint8_t i = 0; i < 4; i++ )
+   if ( _strobeEnable )
    {
-      if ( ( value & 0x1 ) == 1 )
-      {
-         pinMapValue |= _data_pins[i];
-      }
-      value = ( value >> 1 );
+      loadSR ( pinMapValue ); // The strobe is the enable pulse
+   }
+   else
+   {
+      loadSR ( pinMapValue | _En );  // Send with enable high
+      loadSR ( pinMapValue); // Send with enable low
    }
-   
-   // Is it a command or data
-   // -----------------------
-   mode = ( mode == LCD_DATA ) ? _Rs : 0;
-   
-   pinMapValue |= mode | _backlightStsMask;
-   loadSR ( pinMapValue | _En );  // Send with enable high
-   loadSR ( pinMapValue); // Send with enable low
 }
 
 
 void LiquidCrystal_SR3W::loadSR(uint8_t value) 
 {
    // Load the shift register with information
-   fio_shiftOut(_data_reg, _data, _clk_reg, _clk, value, MSBFIRST);
+   fio_shiftOut<MSBFIRST>(_data_reg, _data, _clk_reg, _clk, value);
    
    // Strobe the data into the latch
-   ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+   if ( _strobeEnable )
+   {
+      // The outputs change on the rising edge and are stable for the whole
+      // enable pulse, the LCD reads them on the falling edge.
+      FIO_ATOMIC_BLOCK
+      {
+         fio_digitalWrite_HIGH(_strobe_reg, _strobe);
+         fio_delay_ns<LCD_T_PWEH> ( );
+         fio_digitalWrite_SWITCHTO(_strobe_reg, _strobe, LOW);
+      }
+   }
+   else
    {
-      fio_digitalWrite_HIGH(_strobe_reg, _strobe);
-      fio_digitalWrite_SWITCHTO(_strobe_reg, _strobe, LOW);
+      FIO_ATOMIC_BLOCK
+      {
+         fio_digitalWrite_HIGH(_strobe_reg, _strobe);
+         fio_digitalWrite_SWITCHTO(_strobe_reg, _strobe, LOW);
+      }
    }
 }
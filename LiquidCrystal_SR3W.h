@@ -49,6 +49,14 @@
 //
 // NOTE: Rw is not used by the driver so it can be connected to GND.
 //
+// Latch as enable wiring: the LCD E can be connected to the strobe line
+// instead of a shift register output by using the token SR3W_EN_STROBE for
+// the En pin. Each nibble is then a single load and strobe instead of two,
+// the strobe is held HIGH for the LCD enable pulse width so the outputs,
+// updated on its rising edge, are stable long before the LCD reads them on
+// the falling edge. As every strobe is an LCD write, backlight changes are
+// latched with a function set command repeating the current configuration.
+//
 // The functionality provided by this class and its base class is identical
 // to the original functionality of the Arduino LiquidCrystal library.
 //
@@ -62,6 +70,9 @@
 #include "LCD.h"
 #include "FastIO.h"
 
+// latch as enable indicator constant
+// ---------------------------------------------------------------------------
+#define SR3W_EN_STROBE  204
 
 class LiquidCrystal_SR3W : public LCD 
 {
@@ -101,7 +112,8 @@ public:
     @param      strobe[in] digital IO connected to shiftregister strobe pin.
     @param      data[in] digital IO connected to shiftregister data pin.
     @param      clk[in] digital IO connected to shiftregister clock pin.
-    @param      En[in] LCD En (Enable) pin connected to SR output pin.
+    @param      En[in] LCD En (Enable) pin connected to SR output pin, or
+    SR3W_EN_STROBE if it is connected to the shiftregister strobe.
     @param      Rw[in] LCD Rw (Read/write) pin connected to SR output pin.
     @param      Rs[in] LCD Rs (Reg Select) pin connected to SR output pin.
     @param      d4[in] LCD data 4 pin map to the SR output pin.
@@ -118,6 +130,20 @@ public:
                       uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
                       uint8_t backlighPin, t_backlighPol pol);
    
+   /*!
+    @function
+    @abstract   LCD initialization and associated HW.
+    @discussion Initializes the LCD to a given size (col, row). This methods
+    initializes the LCD, therefore, it MUST be called prior to using any other
+    method from this class or parent class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+   
    /*!
     @function
     @abstract   Send a particular value to the LCD.
@@ -155,6 +181,15 @@ public:
     */
    void setBacklight ( uint8_t value );
    
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Writes the current backlight state to the shift register. Only needed in
+    deferred backlight mode when no other transfer is pending.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void );
+   
 private:
    
    /*!
@@ -171,10 +206,10 @@ private:
     @abstract   Writes an 4 bit value to the LCD.
     @discussion Writes 4 bits (the least significant) to the LCD control data lines.
     @param      value[in] Value to write to the LCD
-    @param      more[in]  Value to distinguish between command and data.
-    COMMAND == command, DATA == data.
+    @param      control[in] Expander word of the control lines (RS and
+    backlight) to write with the data.
     */
-   void write4bits(uint8_t value, uint8_t mode);
+   void write4bits(uint8_t value, uint8_t control);
    
    /*!
     @function
@@ -194,9 +229,12 @@ private:
    uint8_t      _En;               // LCD expander word for enable pin
    uint8_t      _Rw;               // LCD expander word for R/W pin
    uint8_t      _Rs;               // LCD expander word for Register Select pin
-   uint8_t      _data_pins[4];     // LCD data lines
+   uint8_t      _nibbleMap[16];    // Nibble to LCD data lines mapping
    uint8_t      _backlightPinMask; // Backlight IO pin mask
    uint8_t      _backlightStsMask; // Backlight status mask
+   bool         _strobeEnable;     // LCD En connected to the strobe
+   bool         _initialised;      // begin has been called
+   unsigned long _lastSend;        // micros() of the last LCD write
    
 };
 
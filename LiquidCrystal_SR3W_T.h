@@ -0,0 +1,231 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SR3W_T.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using a 3 wire latching shift register with its
+// wiring to the LCD fixed at compile time.
+//
+// @brief
+// This is the compile time configured version of the LiquidCrystal_SR3W
+// class. The shift register outputs connected to the LCD are template
+// parameters, the pin masks and the nibble mapping are therefore constants
+// folded by the compiler into the code. When the data lines are wired to
+// consecutive outputs (D4..D7 on Qn..Qn+3) the mapping is a single shift.
+// The MCU pins driving the shift register are still passed to the
+// constructor.
+//
+// Usage:
+//    LiquidCrystal_SR3W_T<4, 5, 6, 0, 1, 2, 3, 7> lcd ( 2, 3, 4 );
+//
+// The LiquidCrystal_SR3W class keeps the runtime pin configuration.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef _LIQUIDCRYSTAL_SR3W_T_H_
+#define _LIQUIDCRYSTAL_SR3W_T_H_
+
+#include <inttypes.h>
+#include "LCD.h"
+#include "FastIO.h"
+
+/*!
+ @class
+ @abstract    LiquidCrystal_SR3W_T
+ @discussion  3 wire shift register LCD driver with the shift register to LCD
+ mapping fixed at compile time.
+ @templatefield EN   shift register output connected to the LCD Enable.
+ @templatefield RW   shift register output connected to the LCD Rw (kept LOW).
+ @templatefield RS   shift register output connected to the LCD Register select.
+ @templatefield D4   shift register output connected to the LCD D4.
+ @templatefield D5   shift register output connected to the LCD D5.
+ @templatefield D6   shift register output connected to the LCD D6.
+ @templatefield D7   shift register output connected to the LCD D7.
+ @templatefield BL   shift register output controlling the backlight, any
+ value above 7 for no backlight control.
+ @templatefield POL  backlight polarity (POSITIVE, NEGATIVE).
+ */
+template <uint8_t EN, uint8_t RW, uint8_t RS,
+          uint8_t D4, uint8_t D5, uint8_t D6, uint8_t D7,
+          uint8_t BL = 0xFF, t_backlighPol POL = POSITIVE>
+class LiquidCrystal_SR3W_T : public LCD
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the IO driving the
+    shift register. The constructor does not initialize the LCD.
+
+    @param      data[in] pin connected to the data pin of the shift register
+    @param      clk[in] pin connected to the clock pin of the shift register
+    @param      strobe[in] pin connected to the strobe pin of the shift register
+    */
+   LiquidCrystal_SR3W_T ( uint8_t data, uint8_t clk, uint8_t strobe )
+   {
+      _data       = fio_pinToBit ( data );
+      _clk        = fio_pinToBit ( clk );
+      _strobe     = fio_pinToBit ( strobe );
+      _data_reg   = fio_pinToOutputRegister ( data );
+      _clk_reg    = fio_pinToOutputRegister ( clk );
+      _strobe_reg = fio_pinToOutputRegister ( strobe );
+
+      _backlightStsMask = 0;
+      _polarity = POL;
+      _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   }
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual bool send ( uint8_t value, uint8_t mode )
+   {
+      uint8_t control = ( mode == LCD_DATA ) ? ( RS_MASK | _backlightStsMask )
+                                             : _backlightStsMask;
+
+      if ( mode != FOUR_BITS )
+      {
+         write4bits ( mapNibble ( value >> 4 ) | control ); // upper nibble
+      }
+      write4bits ( mapNibble ( value ) | control );        // lower nibble
+
+#if (F_CPU <= 16000000)
+      // No need to use the delay routines on AVR since the time taken to write
+      // on AVR with SR pin mapping even with fio is longer than LCD command
+      // execution.
+      waitUsec ( 37 ); //goes away on AVRs
+#else
+      delayMicroseconds ( 37 ); // commands & data writes need > 37us to complete
+#endif
+      return true;
+   }
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    @discussion Switch-on/off the LCD backlight. Has no effect if the class
+    has been instantiated without backlight control pin.
+
+    @param      value: backlight mode (HIGH|LOW)
+    */
+   void setBacklight ( uint8_t value )
+   {
+      if ( BL_MASK != 0x0 )
+      {
+         if ( ( ( POL == POSITIVE ) && ( value > 0 ) ) ||
+              ( ( POL == NEGATIVE ) && ( value == 0 ) ) )
+         {
+            _backlightStsMask = BL_MASK;
+         }
+         else
+         {
+            _backlightStsMask = 0;
+         }
+         if ( !_deferredBacklight )
+         {
+            loadSR ( _backlightStsMask );
+         }
+      }
+   }
+
+   /*!
+    @function
+    @abstract   Latches the backlight state on the device.
+    @discussion Loads the current backlight state into the shift register.
+    Only needed in deferred backlight mode when no other transfer is pending.
+    @see setDeferredBacklight.
+    */
+   void flushBacklight ( void )
+   {
+      if ( BL_MASK != 0x0 )
+      {
+         loadSR ( _backlightStsMask );
+      }
+   }
+
+private:
+   // Shift register words of the LCD lines, compile time constants
+   static const uint8_t EN_MASK = ( 1 << EN );
+   static const uint8_t RS_MASK = ( 1 << RS );
+   static const uint8_t BL_MASK = ( BL < 8 ) ? ( 1 << ( BL & 0x07 ) ) : 0;
+   static const bool    SHIFT_MAP = ( D5 == D4 + 1 ) && ( D6 == D4 + 2 ) &&
+                                    ( D7 == D4 + 3 );
+
+   /*!
+    @method
+    @abstract   Maps a nibble to the LCD data lines.
+    @discussion Reduces to a shift when the data lines are wired to
+    consecutive outputs of the shift register.
+
+    @param      value[in] nibble to map (least significant 4 bits).
+    @result     shift register word with the nibble on the data lines.
+    */
+   static inline uint8_t mapNibble ( uint8_t value )
+   {
+      if ( SHIFT_MAP )
+      {
+         return ( (uint8_t)( ( value & 0x0F ) << D4 ) );
+      }
+      return ( ( ( value & 0x01 ) ? ( 1 << D4 ) : 0 ) |
+               ( ( value & 0x02 ) ? ( 1 << D5 ) : 0 ) |
+               ( ( value & 0x04 ) ? ( 1 << D6 ) : 0 ) |
+               ( ( value & 0x08 ) ? ( 1 << D7 ) : 0 ) );
+   }
+
+   /*!
+    @method
+    @abstract   Writes a nibble to the LCD.
+    @discussion Loads the shift register twice to pulse the Enable line with
+    the already mapped nibble and control lines.
+    */
+   void write4bits ( uint8_t pinMapValue )
+   {
+      loadSR ( pinMapValue | EN_MASK );  // Send with enable high
+      loadSR ( pinMapValue );            // Send with enable low
+   }
+
+   /*!
+    @method
+    @abstract   Loads a byte into the shift register and latches it.
+    */
+   void loadSR ( uint8_t value )
+   {
+      // Load the shift register with information
+      fio_shiftOut<MSBFIRST> ( _data_reg, _data, _clk_reg, _clk, value );
+
+      // Strobe the data into the latch
+      FIO_ATOMIC_BLOCK
+      {
+         fio_digitalWrite_HIGH ( _strobe_reg, _strobe );
+         fio_digitalWrite_SWITCHTO ( _strobe_reg, _strobe, LOW );
+      }
+   }
+
+   fio_register _data_reg;    // Serial Data pin
+   fio_bit      _data;
+   fio_register _clk_reg;     // Clock Pin
+   fio_bit      _clk;
+   fio_register _strobe_reg;  // Strobe pin
+   fio_bit      _strobe;
+   uint8_t      _backlightStsMask; // Backlight status mask
+};
+
+#endif
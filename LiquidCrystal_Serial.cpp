@@ -0,0 +1,178 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_Serial.cpp
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using a serial LCD backpack.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK. @see LiquidCrystal_Serial.h.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include <inttypes.h>
+#include "LiquidCrystal_Serial.h"
+
+// Ring buffer index mask
+#define SERIAL_LCD_TX_MASK  ( SERIAL_LCD_TX_LENGTH - 1 )
+
+#if ( SERIAL_LCD_TX_LENGTH & SERIAL_LCD_TX_MASK ) || ( SERIAL_LCD_TX_LENGTH > 128 )
+#error "SERIAL_LCD_TX_LENGTH must be a power of 2, up to 128"
+#endif
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_Serial::LiquidCrystal_Serial ( Stream &stream,
+                                             bool writeThrough ) :
+   _stream ( stream )
+{
+   config ( SERIAL_LCD_COMMAND, SERIAL_LCD_SETUP, writeThrough );
+}
+
+LiquidCrystal_Serial::LiquidCrystal_Serial ( Stream &stream,
+                                             uint8_t commandPrefix,
+                                             uint8_t setupPrefix,
+                                             bool writeThrough ) :
+   _stream ( stream )
+{
+   config ( commandPrefix, setupPrefix, writeThrough );
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_Serial::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   _numlines = lines;
+   _cols = cols;
+
+   // The backpack has initialised the LCD, a function set would change its
+   // interface: display on, clear and entry mode only
+   _displaycontrol = LCD_DISPLAYON | LCD_CURSOROFF | LCD_BLINKOFF;
+   display ( );
+   clear ( );
+
+   _displaymode = LCD_ENTRYLEFT | LCD_ENTRYSHIFTDECREMENT;
+   send ( LCD_ENTRYMODESET | _displaymode, COMMAND );
+
+   backlight ( );
+}
+
+//
+// setBacklight
+void LiquidCrystal_Serial::setBacklight ( uint8_t value )
+{
+   queue ( _setupPrefix );
+   queue ( SERIAL_LCD_BACKLIGHT +
+           (uint8_t)( ( (uint16_t)value * SERIAL_LCD_BACKLIGHT_STEPS ) / 255 ) );
+   poll ( );
+}
+
+//
+// poll
+uint8_t LiquidCrystal_Serial::poll ( void )
+{
+   int room = SERIAL_LCD_TX_LENGTH;   // write through
+
+   // No availableForWrite on Print before 1.8, always write through
+#if (ARDUINO >= 10800)
+   if ( !_writeThrough )
+   {
+      room = _stream.availableForWrite ( );
+   }
+#endif
+
+   while ( ( _tail != _head ) && ( room > 0 ) )
+   {
+      _stream.write ( _tx[_tail] );
+      _tail = ( _tail + 1 ) & SERIAL_LCD_TX_MASK;
+      room--;
+   }
+   return ( ( _head - _tail ) & SERIAL_LCD_TX_MASK );
+}
+
+//
+// flush
+void LiquidCrystal_Serial::flush ( void )
+{
+   while ( _tail != _head )
+   {
+      _stream.write ( _tx[_tail] );
+      _tail = ( _tail + 1 ) & SERIAL_LCD_TX_MASK;
+   }
+   _stream.flush ( );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// config
+void LiquidCrystal_Serial::config ( uint8_t commandPrefix, uint8_t setupPrefix,
+                                    bool writeThrough )
+{
+   _commandPrefix = commandPrefix;
+   _setupPrefix   = setupPrefix;
+   _writeThrough  = writeThrough;
+   _head          = 0;
+   _tail          = 0;
+
+   // The backpack times the commands, nothing to wait for
+   _homeClearExec = 0;
+}
+
+//
+// queue
+void LiquidCrystal_Serial::queue ( uint8_t value )
+{
+   uint8_t next = ( _head + 1 ) & SERIAL_LCD_TX_MASK;
+
+   // Full: make room handing the oldest byte to the stream
+   if ( next == _tail )
+   {
+      _stream.write ( _tx[_tail] );
+      _tail = ( _tail + 1 ) & SERIAL_LCD_TX_MASK;
+   }
+   _tx[_head] = value;
+   _head = next;
+}
+
+// low level data pushing commands
+//----------------------------------------------------------------------------
+
+//
+// send - queue either command or data
+bool LiquidCrystal_Serial::send(uint8_t value, uint8_t mode)
+{
+   // The backpack drives the LCD interface itself
+   if ( mode == FOUR_BITS )
+   {
+      return true;
+   }
+
+   if ( mode == COMMAND )
+   {
+      queue ( _commandPrefix );
+   }
+   queue ( value );
+   poll ( );
+
+   return true;
+}
@@ -0,0 +1,204 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_Serial.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK but using a serial LCD backpack.
+//
+// @brief
+// This is a basic implementation of the LiquidCrystal library of the
+// Arduino SDK for SerLCD style serial backpacks: text is sent as is, LCD
+// commands are sent after a command prefix byte (0xFE) and the backpack
+// settings, such as the backlight, after a setup prefix byte (0x7C). The
+// backpack initialises the LCD, setCursor and the display control methods
+// map to their HD44780 commands.
+//
+// The backpack is written through any Stream (HardwareSerial,
+// SoftwareSerial, ...). The bytes are queued in a transmit ring buffer and
+// moved to the stream as long as its availableForWrite reports free space,
+// so print returns without waiting for the UART. poll has to be called from
+// loop to move the rest of the queue, flush waits until all of it has been
+// handed over to the stream.
+//
+// print only returns without waiting while the update fits in the ring
+// buffer and the free space of the stream: once the ring buffer is full every
+// further byte waits for the stream. The default ring buffer holds a full
+// 16x2 redraw (32 characters and 2 set cursor commands), raise
+// SERIAL_LCD_TX_LENGTH for larger displays.
+//
+// Streams that do not report their free space (availableForWrite always 0,
+// such as SoftwareSerial, which sends each byte as it is written) have to be
+// declared as write through: the bytes then go straight to the stream.
+//
+//    LiquidCrystal_Serial lcd ( Serial1 );
+//    Serial1.begin ( 9600 );
+//    lcd.begin ( 16, 2 );
+//    lcd.print ( value );
+//    ...
+//    lcd.poll ( );   // in loop
+//
+//    SoftwareSerial lcdSerial ( 2, 3 );
+//    LiquidCrystal_Serial lcd ( lcdSerial, true );
+//
+// The prefix bytes can not be printed as characters.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_Serial_h
+#define LiquidCrystal_Serial_h
+
+#include <inttypes.h>
+#include <Stream.h>
+
+#include "LCD.h"
+
+/*!
+ @defined
+ @abstract   Size of the transmit ring buffer.
+ @discussion Power of 2, up to 128 bytes. Holds SERIAL_LCD_TX_LENGTH - 1
+ bytes, print blocks on updates that do not fit.
+ */
+#ifndef SERIAL_LCD_TX_LENGTH
+#define SERIAL_LCD_TX_LENGTH   64
+#endif
+
+/*!
+ @defined
+ @abstract   Default prefix bytes of the backpack.
+ @discussion SERIAL_LCD_COMMAND is followed by an LCD command, SERIAL_LCD_SETUP
+ by a backpack setting.
+ */
+#define SERIAL_LCD_COMMAND     0xFE
+#define SERIAL_LCD_SETUP       0x7C
+
+/*!
+ @defined
+ @abstract   Backlight settings of the backpack.
+ @discussion Setting values SERIAL_LCD_BACKLIGHT (off) to SERIAL_LCD_BACKLIGHT
+ + SERIAL_LCD_BACKLIGHT_STEPS (full brightness).
+ */
+#define SERIAL_LCD_BACKLIGHT        128
+#define SERIAL_LCD_BACKLIGHT_STEPS  29
+
+
+class LiquidCrystal_Serial : public LCD
+{
+public:
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the stream of the
+    backpack with the default prefix bytes. The constructor does not
+    initialize the LCD.
+
+    @param      stream[in] stream the backpack is connected to.
+    @param      writeThrough[in] true for streams that do not report their
+    free space with availableForWrite: the bytes are not queued.
+    */
+   LiquidCrystal_Serial ( Stream &stream, bool writeThrough = false );
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the stream and the
+    prefix bytes of the backpack. The constructor does not initialize the LCD.
+
+    @param      stream[in] stream the backpack is connected to.
+    @param      commandPrefix[in] prefix of the LCD commands.
+    @param      setupPrefix[in] prefix of the backpack settings.
+    @param      writeThrough[in] true for streams that do not report their
+    free space with availableForWrite: the bytes are not queued.
+    */
+   LiquidCrystal_Serial ( Stream &stream, uint8_t commandPrefix,
+                          uint8_t setupPrefix, bool writeThrough = false );
+
+   /*!
+    @function
+    @abstract   LCD initialization.
+    @discussion Initializes the LCD to a given size (col, row): the display is
+    switched on and cleared, the LCD itself is initialised by the backpack.
+    The stream has to be set up (baud rate) before calling this method.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] not used, the font is set by the backpack.
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Queues a character, or a command and its prefix, for the
+    backpack.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual bool send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    @discussion Sets the backlight brightness of the backpack.
+
+    @param      value: backlight brightness, 0 (off) .. 255 (full).
+    */
+   void setBacklight ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Moves queued bytes to the stream.
+    @discussion Writes as much of the queue as the stream can take without
+    blocking, all of it for write through streams. To be called from loop.
+    @result     number of bytes still queued.
+    */
+   uint8_t poll ( void );
+
+   /*!
+    @function
+    @abstract   Writes all the queued bytes to the stream.
+    @discussion Blocks until the whole queue has been handed over to the
+    stream and flushes the stream.
+    */
+   void flush ( void );
+
+private:
+
+   /*!
+    @method
+    @abstract   Queues a byte.
+    @discussion If the queue is full the oldest byte is written to the stream
+    first, waiting for the stream if needed.
+    */
+   void queue ( uint8_t value );
+
+   /*!
+    @method
+    @abstract   Sets the class variables.
+    */
+   void config ( uint8_t commandPrefix, uint8_t setupPrefix,
+                 bool writeThrough );
+
+   Stream &_stream;                    // Stream of the backpack
+   uint8_t _commandPrefix;             // LCD command prefix
+   uint8_t _setupPrefix;               // Backpack setting prefix
+   bool    _writeThrough;              // Stream without availableForWrite
+   uint8_t _tx[SERIAL_LCD_TX_LENGTH];  // Transmit ring buffer
+   uint8_t _head;                      // Ring write index
+   uint8_t _tail;                      // Ring read index
+};
+
+#endif
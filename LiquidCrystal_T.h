@@ -0,0 +1,377 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_T.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK using the parallel port of the LCD with its wiring fixed
+// at compile time.
+//
+// @brief
+// This is the compile time configured version of the LiquidCrystal class for
+// fixed hardware such as the LCD keypad shields. The Arduino pins connected
+// to the LCD are template parameters and are resolved to AVR ports and bits
+// by the compiler, the data lines sharing a port are grouped at compile time
+// and written with straight line port accesses. No pin information is kept
+// in the instances.
+//
+// Usage:
+//    LiquidCrystal_T<8, 9, 4, 5, 6, 7> lcd;                // 4 bit: RS, EN, D4..D7
+//    LiquidCrystal_T<8, 9, 0, 1, 2, 3, 4, 5, 6, 7> lcd8;   // 8 bit: RS, EN, D0..D7
+//
+// The LCD Rw line has to be tied to GND. The backlight is not handled by the
+// class, drive it directly from the sketch.
+//
+// Requires a C++11 compiler (Arduino IDE 1.6.6 or later) and one of the
+// supported AVR variants: ATmega48/88/168/328 (UNO, Nano, Pro Mini),
+// ATmega1280/2560 (MEGA) and ATmega32U4 (Leonardo, Micro). Use the
+// LiquidCrystal class on any other board.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_T_h
+#define LiquidCrystal_T_h
+
+#include <inttypes.h>
+
+#include "LCD.h"
+#include "FastIO.h"
+
+#if ( __cplusplus < 201103L )
+#error "LiquidCrystal_T requires a C++11 compiler, use LiquidCrystal instead"
+#endif
+
+/*!
+ @defined
+ @abstract   Command execution time on the LCD.
+ @discussion This defines how long a command takes to execute by the LCD.
+ The time is expressed in micro-seconds.
+ */
+#ifndef EXEC_TIME
+#define EXEC_TIME 37
+#endif
+
+// Pin to port tables: one byte per Arduino pin, port index (PORTA = 0 ..
+// PORTL = 10, no PORTI) in the high nibble and port bit in the low nibble.
+// ---------------------------------------------------------------------------
+#if defined (__AVR_ATmega48__) || defined (__AVR_ATmega48P__) || \
+    defined (__AVR_ATmega88__) || defined (__AVR_ATmega88P__) || \
+    defined (__AVR_ATmega168__) || defined (__AVR_ATmega168P__) || \
+    defined (__AVR_ATmega328__) || defined (__AVR_ATmega328P__)
+// 0..7: PD0..PD7, 8..13: PB0..PB5, 14..19 (A0..A5): PC0..PC5
+#define LCD_T_PIN_TABLE \
+   "\x30\x31\x32\x33\x34\x35\x36\x37\x10\x11\x12\x13\x14\x15" \
+   "\x20\x21\x22\x23\x24\x25"
+
+#elif defined (__AVR_ATmega1280__) || defined (__AVR_ATmega2560__)
+#define LCD_T_PIN_TABLE \
+   "\x40\x41\x44\x45\x65\x43\x73\x74\x75\x76\x14\x15\x16\x17" \
+   "\x81\x80\x71\x70\x33\x32\x31\x30" \
+   "\x00\x01\x02\x03\x04\x05\x06\x07" \
+   "\x27\x26\x25\x24\x23\x22\x21\x20" \
+   "\x37\x62\x61\x60" \
+   "\xA7\xA6\xA5\xA4\xA3\xA2\xA1\xA0" \
+   "\x13\x12\x11\x10" \
+   "\x50\x51\x52\x53\x54\x55\x56\x57" \
+   "\x90\x91\x92\x93\x94\x95\x96\x97"
+
+#elif defined (__AVR_ATmega32U4__)
+#define LCD_T_PIN_TABLE \
+   "\x32\x33\x31\x30\x34\x26\x37\x46\x14\x15\x16\x17\x36\x27" \
+   "\x13\x11\x12\x10\x57\x56\x55\x54\x51\x50" \
+   "\x34\x37\x14\x15\x16\x36\x35"
+
+#else
+#error "LiquidCrystal_T: unsupported board, use LiquidCrystal instead"
+#endif
+
+/*!
+ @function
+ @abstract   Port index of an Arduino pin.
+ @result     PORTA = 0 .. PORTL = 10, 0xFF for an invalid pin.
+ */
+constexpr uint8_t lcd_pinPort ( uint8_t pin )
+{
+   return ( ( pin < sizeof ( LCD_T_PIN_TABLE ) - 1 )
+            ? (uint8_t)LCD_T_PIN_TABLE[pin] >> 4 : 0xFF );
+}
+
+/*!
+ @function
+ @abstract   Port bit of an Arduino pin.
+ */
+constexpr uint8_t lcd_pinBit ( uint8_t pin )
+{
+   return ( (uint8_t)LCD_T_PIN_TABLE[pin] & 0x07 );
+}
+
+/*!
+ @function
+ @abstract   Data memory address of the PORTx register of a port index.
+ @discussion PORTA..PORTG are in the IO space, PORTH..PORTL (MEGA) are only
+ reachable as memory.
+ */
+constexpr uint16_t lcd_portAddr ( uint8_t port )
+{
+   return ( ( port < 7 ) ? 0x22 + 3 * port : 0x102 + 3 * ( port - 7 ) );
+}
+
+/*!
+ @defined
+ @abstract   Access to an AVR register from its data memory address.
+ */
+#define LCD_T_SFR(addr) ( *(volatile uint8_t *)( addr ) )
+
+/*!
+ @class
+ @abstract    LCD_PortGroup_T
+ @discussion  Compile time description of the data lines wired to one port:
+ port mask, data lines, and whether the lines are in order so that they are
+ mapped with a shift.
+ @templatefield PORT   port index.
+ @templatefield LINE   data line of the first pin of the list.
+ @templatefield PINS   Arduino pins of the data lines from LINE onwards.
+ */
+template <uint8_t PORT, uint8_t LINE, uint8_t... PINS>
+struct LCD_PortGroup_T
+{
+   static const uint8_t MASK     = 0;
+   static const uint8_t LINES    = 0;
+   static const int8_t  DELTA    = -128;
+   static const bool    IN_ORDER = true;
+
+   static inline uint8_t map ( uint8_t value ) { return ( 0 ); }
+};
+
+template <uint8_t PORT, uint8_t LINE, uint8_t PIN, uint8_t... PINS>
+struct LCD_PortGroup_T<PORT, LINE, PIN, PINS...>
+{
+   typedef LCD_PortGroup_T<PORT, LINE + 1, PINS...> Next;
+
+   static const bool    IN_PORT  = ( lcd_pinPort ( PIN ) == PORT );
+   static const uint8_t MASK     = ( IN_PORT ? ( 1 << lcd_pinBit ( PIN ) ) : 0 ) |
+                                   Next::MASK;
+   static const uint8_t LINES    = ( IN_PORT ? ( 1 << LINE ) : 0 ) | Next::LINES;
+
+   // Port bit - data line of the first line in the port
+   static const int8_t  DELTA    = IN_PORT ? (int8_t)lcd_pinBit ( PIN ) - LINE
+                                           : Next::DELTA;
+   static const bool    IN_ORDER = ( !IN_PORT || ( Next::DELTA == -128 ) ||
+                                     ( Next::DELTA == DELTA ) ) && Next::IN_ORDER;
+
+   static inline uint8_t map ( uint8_t value )
+   {
+      return ( ( ( IN_PORT && ( value & ( 1 << LINE ) ) )
+                 ? ( 1 << lcd_pinBit ( PIN ) ) : 0 ) | Next::map ( value ) );
+   }
+};
+
+
+/*!
+ @class
+ @abstract    LiquidCrystal_T
+ @discussion  Parallel LCD driver with the pins fixed at compile time.
+ @templatefield RS   Arduino pin connected to the LCD Register select.
+ @templatefield EN   Arduino pin connected to the LCD Enable.
+ @templatefield D    Arduino pins of the data lines: D4..D7 for 4 bit mode or
+ D0..D7 for 8 bit mode.
+ */
+template <uint8_t RS, uint8_t EN, uint8_t... D>
+class LiquidCrystal_T : public LCD
+{
+   static_assert ( ( sizeof... ( D ) == 4 ) || ( sizeof... ( D ) == 8 ),
+                   "LiquidCrystal_T needs 4 or 8 data pins" );
+   static_assert ( ( lcd_pinPort ( RS ) != 0xFF ) && ( lcd_pinPort ( EN ) != 0xFF ),
+                   "LiquidCrystal_T: invalid RS or EN pin" );
+   static_assert ( LCD_PortGroup_T<0xFF, 0, D...>::LINES == 0,
+                   "LiquidCrystal_T: invalid data pin" );
+
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Sets the LCD pins as outputs driven LOW. The constructor does
+    not initialize the LCD.
+    */
+   LiquidCrystal_T ( )
+   {
+      setOutput<RS> ( );
+      setOutput<EN> ( );
+      initPort<0> ( ); initPort<1> ( ); initPort<2> ( ); initPort<3> ( );
+      initPort<4> ( ); initPort<5> ( ); initPort<6> ( ); initPort<7> ( );
+      initPort<8> ( ); initPort<9> ( ); initPort<10> ( );
+
+      if ( sizeof... ( D ) == 4 )
+      {
+         _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+      }
+      else
+      {
+         _displayfunction = LCD_8BITMODE | LCD_1LINE | LCD_5x8DOTS;
+      }
+   }
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual bool send ( uint8_t value, uint8_t mode )
+   {
+      writePin<RS> ( mode == LCD_DATA );
+
+      if ( ( mode != FOUR_BITS ) && ( sizeof... ( D ) == 4 ) )
+      {
+         writeData ( value >> 4 );
+      }
+      writeData ( value );
+
+      delayMicroseconds ( EXEC_TIME ); // wait for the command to execute
+      return true;
+   }
+
+private:
+   /*!
+    @method
+    @abstract   Sets a pin as OUTPUT driven LOW.
+    */
+   template <uint8_t PIN>
+   static inline void setOutput ( void )
+   {
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+      {
+         LCD_T_SFR ( lcd_portAddr ( lcd_pinPort ( PIN ) ) ) &= ~( 1 << lcd_pinBit ( PIN ) );
+         LCD_T_SFR ( lcd_portAddr ( lcd_pinPort ( PIN ) ) - 1 ) |= ( 1 << lcd_pinBit ( PIN ) );
+      }
+   }
+
+   /*!
+    @method
+    @abstract   Sets the data lines of a port as OUTPUTs driven LOW.
+    */
+   template <uint8_t PORT>
+   static inline void initPort ( void )
+   {
+      typedef LCD_PortGroup_T<PORT, 0, D...> Group;
+
+      if ( Group::MASK != 0 )
+      {
+         ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+         {
+            LCD_T_SFR ( lcd_portAddr ( PORT ) ) &= ~Group::MASK;
+            LCD_T_SFR ( lcd_portAddr ( PORT ) - 1 ) |= Group::MASK;
+         }
+      }
+   }
+
+   /*!
+    @method
+    @abstract   Writes a single pin.
+    @discussion Compiles to a single sbi/cbi instruction for the ports in
+    the IO space.
+    */
+   template <uint8_t PIN>
+   static inline void writePin ( bool high )
+   {
+      const uint16_t addr = lcd_portAddr ( lcd_pinPort ( PIN ) );
+      const uint8_t  mask = ( 1 << lcd_pinBit ( PIN ) );
+
+      if ( addr < 0x40 )
+      {
+         if ( high ) LCD_T_SFR ( addr ) |= mask;
+         else        LCD_T_SFR ( addr ) &= ~mask;
+      }
+      else
+      {
+         ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+         {
+            if ( high ) LCD_T_SFR ( addr ) |= mask;
+            else        LCD_T_SFR ( addr ) &= ~mask;
+         }
+      }
+   }
+
+   /*!
+    @method
+    @abstract   Writes the data lines wired to a port.
+    @discussion Lines in order are mapped with a shift, a whole port is
+    written with a single store. Ports without data lines compile to nothing.
+    */
+   template <uint8_t PORT>
+   static inline void writePort ( uint8_t value )
+   {
+      typedef LCD_PortGroup_T<PORT, 0, D...> Group;
+      const uint16_t addr = lcd_portAddr ( PORT );
+      uint8_t bits;
+
+      if ( Group::MASK == 0 )
+      {
+         return;
+      }
+
+      if ( Group::IN_ORDER )
+      {
+         bits = ( Group::DELTA >= 0 )
+                ? (uint8_t)( ( value & Group::LINES ) << ( Group::DELTA & 0x07 ) )
+                : (uint8_t)( ( value & Group::LINES ) >> ( -Group::DELTA & 0x07 ) );
+      }
+      else
+      {
+         bits = Group::map ( value );
+      }
+
+      if ( Group::MASK == 0xFF )
+      {
+         LCD_T_SFR ( addr ) = bits;
+      }
+      else if ( ( ( Group::MASK & ( Group::MASK - 1 ) ) == 0 ) && ( addr < 0x40 ) )
+      {
+         // Single line in the port
+         if ( bits ) LCD_T_SFR ( addr ) |= Group::MASK;
+         else        LCD_T_SFR ( addr ) &= ~Group::MASK;
+      }
+      else
+      {
+         ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+         {
+            LCD_T_SFR ( addr ) = ( LCD_T_SFR ( addr ) & ~Group::MASK ) | bits;
+         }
+      }
+   }
+
+   /*!
+    @method
+    @abstract   Writes a nibble or a byte to the LCD.
+    @discussion Writes the data lines port by port and pulses the Enable line.
+    */
+   static inline void writeData ( uint8_t value )
+   {
+      writePort<0> ( value ); writePort<1> ( value ); writePort<2> ( value );
+      writePort<3> ( value ); writePort<4> ( value ); writePort<5> ( value );
+      writePort<6> ( value ); writePort<7> ( value ); writePort<8> ( value );
+      writePort<9> ( value ); writePort<10> ( value );
+
+      fio_delay_ns<LCD_T_AS> ( );       // RS set-up time to enable rise
+      writePin<EN> ( true );
+      fio_delay_ns<LCD_T_PWEH> ( );     // enable pulse must be > 450ns
+      writePin<EN> ( false );
+      fio_delay_ns<LCD_T_CYCE - LCD_T_PWEH> ( ); // enable cycle, covers hold times
+   }
+};
+
+#endif
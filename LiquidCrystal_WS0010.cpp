@@ -0,0 +1,341 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_WS0010.cpp
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK for the Winstar WS0010 character OLEDs, with the
+// graphics mode of the controller.
+//
+// @brief
+// @see LiquidCrystal_WS0010.h.
+//
+// ---------------------------------------------------------------------------
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include <inttypes.h>
+#include "LiquidCrystal_WS0010.h"
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#endif
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// Mode/power command: graphics or character mode, internal power on
+#define WS0010_MODE_POWER   0x17
+#define WS0010_GRAPHICS     0x08
+
+// Graphics address commands
+#define WS0010_SET_GXA      0x80   // column, 0 .. 99
+#define WS0010_SET_GYA      0x40   // 8 row page, 0 .. 1
+
+// Font range
+#define WS0010_FONT_FIRST   0x20
+#define WS0010_FONT_LAST    0x7E
+
+// 5x7 font, one byte per column, bit 0 top row
+static const uint8_t font5x7[] PROGMEM =
+{
+   0x00, 0x00, 0x00, 0x00, 0x00,   // ' '
+   0x00, 0x00, 0x5F, 0x00, 0x00,   // !
+   0x00, 0x07, 0x00, 0x07, 0x00,   // "
+   0x14, 0x7F, 0x14, 0x7F, 0x14,   // #
+   0x24, 0x2A, 0x7F, 0x2A, 0x12,   // $
+   0x23, 0x13, 0x08, 0x64, 0x62,   // %
+   0x36, 0x49, 0x55, 0x22, 0x50,   // &
+   0x00, 0x05, 0x03, 0x00, 0x00,   // '
+   0x00, 0x1C, 0x22, 0x41, 0x00,   // (
+   0x00, 0x41, 0x22, 0x1C, 0x00,   // )
+   0x14, 0x08, 0x3E, 0x08, 0x14,   // *
+   0x08, 0x08, 0x3E, 0x08, 0x08,   // +
+   0x00, 0x50, 0x30, 0x00, 0x00,   // ,
+   0x08, 0x08, 0x08, 0x08, 0x08,   // -
+   0x00, 0x60, 0x60, 0x00, 0x00,   // .
+   0x20, 0x10, 0x08, 0x04, 0x02,   // /
+   0x3E, 0x51, 0x49, 0x45, 0x3E,   // 0
+   0x00, 0x42, 0x7F, 0x40, 0x00,   // 1
+   0x42, 0x61, 0x51, 0x49, 0x46,   // 2
+   0x21, 0x41, 0x45, 0x4B, 0x31,   // 3
+   0x18, 0x14, 0x12, 0x7F, 0x10,   // 4
+   0x27, 0x45, 0x45, 0x45, 0x39,   // 5
+   0x3C, 0x4A, 0x49, 0x49, 0x30,   // 6
+   0x01, 0x71, 0x09, 0x05, 0x03,   // 7
+   0x36, 0x49, 0x49, 0x49, 0x36,   // 8
+   0x06, 0x49, 0x49, 0x29, 0x1E,   // 9
+   0x00, 0x36, 0x36, 0x00, 0x00,   // :
+   0x00, 0x56, 0x36, 0x00, 0x00,   // ;
+   0x08, 0x14, 0x22, 0x41, 0x00,   // <
+   0x14, 0x14, 0x14, 0x14, 0x14,   // =
+   0x00, 0x41, 0x22, 0x14, 0x08,   // >
+   0x02, 0x01, 0x51, 0x09, 0x06,   // ?
+   0x32, 0x49, 0x79, 0x41, 0x3E,   // @
+   0x7E, 0x11, 0x11, 0x11, 0x7E,   // A
+   0x7F, 0x49, 0x49, 0x49, 0x36,   // B
+   0x3E, 0x41, 0x41, 0x41, 0x22,   // C
+   0x7F, 0x41, 0x41, 0x22, 0x1C,   // D
+   0x7F, 0x49, 0x49, 0x49, 0x41,   // E
+   0x7F, 0x09, 0x09, 0x09, 0x01,   // F
+   0x3E, 0x41, 0x49, 0x49, 0x7A,   // G
+   0x7F, 0x08, 0x08, 0x08, 0x7F,   // H
+   0x00, 0x41, 0x7F, 0x41, 0x00,   // I
+   0x20, 0x40, 0x41, 0x3F, 0x01,   // J
+   0x7F, 0x08, 0x14, 0x22, 0x41,   // K
+   0x7F, 0x40, 0x40, 0x40, 0x40,   // L
+   0x7F, 0x02, 0x0C, 0x02, 0x7F,   // M
+   0x7F, 0x04, 0x08, 0x10, 0x7F,   // N
+   0x3E, 0x41, 0x41, 0x41, 0x3E,   // O
+   0x7F, 0x09, 0x09, 0x09, 0x06,   // P
+   0x3E, 0x41, 0x51, 0x21, 0x5E,   // Q
+   0x7F, 0x09, 0x19, 0x29, 0x46,   // R
+   0x46, 0x49, 0x49, 0x49, 0x31,   // S
+   0x01, 0x01, 0x7F, 0x01, 0x01,   // T
+   0x3F, 0x40, 0x40, 0x40, 0x3F,   // U
+   0x1F, 0x20, 0x40, 0x20, 0x1F,   // V
+   0x3F, 0x40, 0x38, 0x40, 0x3F,   // W
+   0x63, 0x14, 0x08, 0x14, 0x63,   // X
+   0x07, 0x08, 0x70, 0x08, 0x07,   // Y
+   0x61, 0x51, 0x49, 0x45, 0x43,   // Z
+   0x00, 0x7F, 0x41, 0x41, 0x00,   // [
+   0x02, 0x04, 0x08, 0x10, 0x20,   // backslash
+   0x00, 0x41, 0x41, 0x7F, 0x00,   // ]
+   0x04, 0x02, 0x01, 0x02, 0x04,   // ^
+   0x40, 0x40, 0x40, 0x40, 0x40,   // _
+   0x00, 0x01, 0x02, 0x04, 0x00,   // `
+   0x20, 0x54, 0x54, 0x54, 0x78,   // a
+   0x7F, 0x48, 0x44, 0x44, 0x38,   // b
+   0x38, 0x44, 0x44, 0x44, 0x20,   // c
+   0x38, 0x44, 0x44, 0x48, 0x7F,   // d
+   0x38, 0x54, 0x54, 0x54, 0x18,   // e
+   0x08, 0x7E, 0x09, 0x01, 0x02,   // f
+   0x0C, 0x52, 0x52, 0x52, 0x3E,   // g
+   0x7F, 0x08, 0x04, 0x04, 0x78,   // h
+   0x00, 0x44, 0x7D, 0x40, 0x00,   // i
+   0x20, 0x40, 0x44, 0x3D, 0x00,   // j
+   0x7F, 0x10, 0x28, 0x44, 0x00,   // k
+   0x00, 0x41, 0x7F, 0x40, 0x00,   // l
+   0x7C, 0x04, 0x18, 0x04, 0x78,   // m
+   0x7C, 0x08, 0x04, 0x04, 0x78,   // n
+   0x38, 0x44, 0x44, 0x44, 0x38,   // o
+   0x7C, 0x14, 0x14, 0x14, 0x08,   // p
+   0x08, 0x14, 0x14, 0x18, 0x7C,   // q
+   0x7C, 0x08, 0x04, 0x04, 0x08,   // r
+   0x48, 0x54, 0x54, 0x54, 0x20,   // s
+   0x04, 0x3F, 0x44, 0x40, 0x20,   // t
+   0x3C, 0x40, 0x40, 0x20, 0x7C,   // u
+   0x1C, 0x20, 0x40, 0x20, 0x1C,   // v
+   0x3C, 0x40, 0x30, 0x40, 0x3C,   // w
+   0x44, 0x28, 0x10, 0x28, 0x44,   // x
+   0x0C, 0x50, 0x50, 0x50, 0x3C,   // y
+   0x44, 0x64, 0x54, 0x4C, 0x44,   // z
+   0x00, 0x08, 0x36, 0x41, 0x00,   // {
+   0x00, 0x00, 0x7F, 0x00, 0x00,   // |
+   0x00, 0x41, 0x36, 0x08, 0x00,   // }
+   0x08, 0x04, 0x08, 0x10, 0x08    // ~
+};
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+
+LiquidCrystal_WS0010::LiquidCrystal_WS0010(uint8_t rs, uint8_t enable,
+                                           uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3,
+                                           uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7) :
+   LiquidCrystal ( rs, enable, d0, d1, d2, d3, d4, d5, d6, d7 )
+{
+   _graphics = false;
+}
+
+LiquidCrystal_WS0010::LiquidCrystal_WS0010(uint8_t rs, uint8_t rw, uint8_t enable,
+                                           uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3,
+                                           uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7) :
+   LiquidCrystal ( rs, rw, enable, d0, d1, d2, d3, d4, d5, d6, d7 )
+{
+   _graphics = false;
+}
+
+LiquidCrystal_WS0010::LiquidCrystal_WS0010(uint8_t rs, uint8_t rw, uint8_t enable,
+                                           uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3) :
+   LiquidCrystal ( rs, rw, enable, d0, d1, d2, d3 )
+{
+   _graphics = false;
+}
+
+LiquidCrystal_WS0010::LiquidCrystal_WS0010(uint8_t rs, uint8_t enable,
+                                           uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3) :
+   LiquidCrystal ( rs, enable, d0, d1, d2, d3 )
+{
+   _graphics = false;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_WS0010::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   LCD::begin ( cols, lines, dotsize );
+
+   // Character mode, internal DC/DC on
+   send ( WS0010_MODE_POWER, COMMAND );
+   _graphics = false;
+}
+
+//
+// graphicsMode
+void LiquidCrystal_WS0010::graphicsMode ( void )
+{
+   send ( WS0010_MODE_POWER | WS0010_GRAPHICS, COMMAND );
+   _graphics = true;
+
+   // The graphics RAM content is unknown, rewrite all of it blank
+   for ( uint8_t x = 0; x < WS0010_GFX_WIDTH; x++ )
+   {
+      _gfx[x] = 0;
+      markDirty ( x );
+   }
+   update ( );
+}
+
+//
+// textMode
+void LiquidCrystal_WS0010::textMode ( void )
+{
+   send ( WS0010_MODE_POWER, COMMAND );
+   _graphics = false;
+   clear ( );
+}
+
+//
+// clearGraphics
+void LiquidCrystal_WS0010::clearGraphics ( void )
+{
+   for ( uint8_t x = 0; x < WS0010_GFX_WIDTH; x++ )
+   {
+      setColumn ( x, 0 );
+   }
+}
+
+//
+// setPixel
+void LiquidCrystal_WS0010::setPixel ( uint8_t x, uint8_t y, bool on )
+{
+   if ( ( x < WS0010_GFX_WIDTH ) && ( y < WS0010_GFX_HEIGHT ) )
+   {
+      uint16_t bit = ( 1 << y );
+
+      setColumn ( x, on ? ( _gfx[x] | bit ) : ( _gfx[x] & ~bit ) );
+   }
+}
+
+//
+// getPixel
+bool LiquidCrystal_WS0010::getPixel ( uint8_t x, uint8_t y )
+{
+   return ( ( x < WS0010_GFX_WIDTH ) && ( y < WS0010_GFX_HEIGHT ) &&
+            ( _gfx[x] & ( 1 << y ) ) );
+}
+
+//
+// setColumn
+void LiquidCrystal_WS0010::setColumn ( uint8_t x, uint16_t pixels )
+{
+   // Only actual changes are sent by update
+   if ( ( x < WS0010_GFX_WIDTH ) && ( _gfx[x] != pixels ) )
+   {
+      _gfx[x] = pixels;
+      markDirty ( x );
+   }
+}
+
+//
+// drawChar
+uint8_t LiquidCrystal_WS0010::drawChar ( uint8_t x, uint8_t y, char c )
+{
+   uint16_t mask = ( (uint16_t)0xFF << y );
+   const uint8_t *glyph;
+
+   if ( y >= WS0010_GFX_HEIGHT )
+   {
+      return ( x );
+   }
+   if ( ( c < WS0010_FONT_FIRST ) || ( c > WS0010_FONT_LAST ) )
+   {
+      c = '?';
+   }
+   glyph = &font5x7[( c - WS0010_FONT_FIRST ) * 5];
+
+   // Glyph columns and a blank spacing column, over an 8 row background
+   for ( uint8_t i = 0; ( i < WS0010_GFX_CHAR_WIDTH ) && ( x < WS0010_GFX_WIDTH );
+         i++, x++ )
+   {
+      uint16_t bits = ( i < 5 ) ? pgm_read_byte ( glyph + i ) : 0;
+
+      setColumn ( x, ( _gfx[x] & ~mask ) | ( bits << y ) );
+   }
+   return ( x );
+}
+
+//
+// drawText
+uint8_t LiquidCrystal_WS0010::drawText ( uint8_t x, uint8_t y, const char *str )
+{
+   while ( ( *str != '\0' ) && ( x < WS0010_GFX_WIDTH ) )
+   {
+      x = drawChar ( x, y, *str++ );
+   }
+   return ( x );
+}
+
+//
+// update
+void LiquidCrystal_WS0010::update ( void )
+{
+   if ( !_graphics )
+   {
+      return;
+   }
+
+   // One address set per run of changed columns and 8 row page, the address
+   // increments after each data write
+   for ( uint8_t page = 0; page < ( WS0010_GFX_HEIGHT / 8 ); page++ )
+   {
+      uint8_t x = 0;
+
+      while ( x < WS0010_GFX_WIDTH )
+      {
+         if ( !isDirty ( x ) )
+         {
+            x++;
+            continue;
+         }
+
+         send ( WS0010_SET_GXA | x, COMMAND );
+         send ( WS0010_SET_GYA | page, COMMAND );
+
+         while ( ( x < WS0010_GFX_WIDTH ) && isDirty ( x ) )
+         {
+            send ( (uint8_t)( _gfx[x] >> ( page * 8 ) ), LCD_DATA );
+            x++;
+         }
+      }
+   }
+
+   for ( uint8_t i = 0; i < sizeof ( _dirty ); i++ )
+   {
+      _dirty[i] = 0;
+   }
+}
@@ -0,0 +1,214 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_WS0010.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK for the Winstar WS0010 character OLEDs, with the
+// graphics mode of the controller.
+//
+// @brief
+// The WS0010 is HD44780 compatible in character mode, this class drives it
+// through the parallel port of the display (4 bit and 8 bit) as LiquidCrystal
+// does. In graphics mode the display is a WS0010_GFX_WIDTH x 16 pixel matrix
+// (100 x 16 on the 16x2 modules, 80 x 16 on the 16x1 / 8x2 ones).
+//
+// Drawing is done in a local framebuffer, one 16 bit word per pixel column
+// (bit 0 top row). update sends the columns changed since the previous
+// update, each run of changed columns as one address set followed by the
+// bytes of the run with the controller incrementing the address, so a trend
+// plot scrolling one column only rewrites the columns that moved.
+//
+// Text can be drawn on the graphics with a 5x7 font at any row, to mix
+// labels and plots on the same screen:
+//
+//    LiquidCrystal_WS0010 oled ( 12, 11, 5, 4, 3, 2 );
+//    oled.begin ( 16, 2 );
+//    oled.graphicsMode ( );
+//    oled.drawText ( 0, 0, "T 21.5" );
+//    for ( uint8_t x = 40; x < 100; x++ ) oled.setPixel ( x, 15 - sample[x] );
+//    oled.update ( );
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library in
+// character mode.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_WS0010_h
+#define LiquidCrystal_WS0010_h
+
+#include <inttypes.h>
+
+#include "LiquidCrystal.h"
+
+/*!
+ @defined
+ @abstract   Width of the graphics mode in pixels.
+ @discussion 100 for the 16 character modules, 80 for the 8 character ones.
+ */
+#ifndef WS0010_GFX_WIDTH
+#define WS0010_GFX_WIDTH     100
+#endif
+
+/*!
+ @defined
+ @abstract   Height of the graphics mode in pixels.
+ */
+#define WS0010_GFX_HEIGHT    16
+
+/*!
+ @defined
+ @abstract   Width of a character drawn on the graphics, spacing included.
+ */
+#define WS0010_GFX_CHAR_WIDTH 6
+
+
+class LiquidCrystal_WS0010 : public LiquidCrystal
+{
+public:
+   /*!
+    @method
+    @abstract   8 bit LCD constructors.
+    @discussion Defines the pin assignment that the LCD will have.
+    The constructor does not initialize the LCD.
+    */
+   LiquidCrystal_WS0010(uint8_t rs, uint8_t enable,
+                        uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3,
+                        uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7);
+   LiquidCrystal_WS0010(uint8_t rs, uint8_t rw, uint8_t enable,
+                        uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3,
+                        uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7);
+
+   /*!
+    @method
+    @abstract   4 bit LCD constructors.
+    @discussion Defines the pin assignment that the LCD will have.
+    The constructor does not initialize the LCD.
+    */
+   LiquidCrystal_WS0010(uint8_t rs, uint8_t rw, uint8_t enable,
+                        uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3);
+   LiquidCrystal_WS0010(uint8_t rs, uint8_t enable,
+                        uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3);
+
+   /*!
+    @function
+    @abstract   LCD initialization.
+    @discussion Initializes the LCD to a given size (col, row) in character
+    mode with the internal power on. This methods initializes the LCD,
+    therefore, it MUST be called prior to using any other method from this
+    class or parent class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+   /*!
+    @function
+    @abstract   Switches the display to graphics mode.
+    @discussion Clears the framebuffer and the display. Text printed with
+    print is not shown in graphics mode, @see drawText.
+    */
+   void graphicsMode ( void );
+
+   /*!
+    @function
+    @abstract   Switches the display back to character mode.
+    @discussion The display is cleared.
+    */
+   void textMode ( void );
+
+   /*!
+    @function
+    @abstract   Clears the framebuffer.
+    @discussion Sent to the display by the next update.
+    */
+   void clearGraphics ( void );
+
+   /*!
+    @function
+    @abstract   Sets or clears a pixel of the framebuffer.
+    @param      x[in] column (0 .. WS0010_GFX_WIDTH - 1).
+    @param      y[in] row (0 .. 15), 0 is the top row.
+    @param      on[in] pixel lit (true) or off (false).
+    */
+   void setPixel ( uint8_t x, uint8_t y, bool on = true );
+
+   /*!
+    @function
+    @abstract   Reads a pixel of the framebuffer.
+    @param      x[in] column (0 .. WS0010_GFX_WIDTH - 1).
+    @param      y[in] row (0 .. 15).
+    @result     true if the pixel is lit.
+    */
+   bool getPixel ( uint8_t x, uint8_t y );
+
+   /*!
+    @function
+    @abstract   Sets a whole pixel column of the framebuffer.
+    @discussion Handy for bar graphs and scrolling plots.
+    @param      x[in] column (0 .. WS0010_GFX_WIDTH - 1).
+    @param      pixels[in] pixels of the column, bit 0 is the top row.
+    */
+   void setColumn ( uint8_t x, uint16_t pixels );
+
+   /*!
+    @function
+    @abstract   Draws a character on the framebuffer.
+    @discussion The character (5x7 font, ASCII 0x20 to 0x7E) is drawn over an
+    8 pixel high and WS0010_GFX_CHAR_WIDTH wide background starting at row y,
+    the part falling outside the display is clipped.
+    @param      x[in] left column of the character.
+    @param      y[in] top row of the character (0 .. 15).
+    @param      c[in] character.
+    @result     column following the character.
+    */
+   uint8_t drawChar ( uint8_t x, uint8_t y, char c );
+
+   /*!
+    @function
+    @abstract   Draws a string on the framebuffer.
+    @discussion @see drawChar.
+    @param      x[in] left column of the string.
+    @param      y[in] top row of the string (0 .. 15).
+    @param      str[in] null terminated string.
+    @result     column following the string.
+    */
+   uint8_t drawText ( uint8_t x, uint8_t y, const char *str );
+
+   /*!
+    @function
+    @abstract   Sends the framebuffer changes to the display.
+    @discussion Writes the columns changed since the last update, a run of
+    changed columns per address set. Only done in graphics mode.
+    */
+   void update ( void );
+
+private:
+
+   /*!
+    @method
+    @abstract   Marks a column as changed.
+    */
+   void markDirty ( uint8_t x ) { _dirty[x >> 3] |= ( 1 << ( x & 0x07 ) ); }
+
+   /*!
+    @method
+    @abstract   Checks if a column has changed.
+    */
+   bool isDirty ( uint8_t x ) { return ( _dirty[x >> 3] & ( 1 << ( x & 0x07 ) ) ); }
+
+   uint16_t _gfx[WS0010_GFX_WIDTH];            // Framebuffer, column major
+   uint8_t  _dirty[( WS0010_GFX_WIDTH + 7 ) / 8]; // Changed columns
+   bool     _graphics;                         // Graphics mode on
+};
+
+#endif
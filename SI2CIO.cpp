@@ -36,36 +36,41 @@
 
 #include <inttypes.h>
 
-/*#define SCL_PIN 6
-#define SCL_PORT PORTD
-#define SDA_PIN 7
-#define SDA_PORT PORTD*/
-
 //#define I2C_FASTMODE 1 
 //#define I2C_SLOWMODE 1 
 
-#define SCL_PIN 0
-#define SCL_PORT PORTB
-#define SDA_PIN 1
-#define SDA_PORT PORTB
-
-
 #include "SI2CIO.h"
 #include "SoftI2CMaster.h"
 
 
 // CLASS VARIABLES
 // ---------------------------------------------------------------------------
+// Bus of the default constructor: SCL on PB0, SDA on PB1. Other buses are
+// generated the same way in the sketch, e.g.
+// SOFTI2C_BUS(lcdBus, PORTD, 7, PORTD, 6) for SCL on PD6, SDA on PD7.
+SOFTI2C_BUS(si2cDefaultBus, PORTB, 1, PORTB, 0)
 
 
 // CONSTRUCTOR
 // ---------------------------------------------------------------------------
 SI2CIO::SI2CIO ( )
 {
+   _bus         = &si2cDefaultBus;
+   _i2cAddr     = 0x0;
+   _dirMask     = 0xFF;    // mark all as INPUTs
+   _shadow      = 0x0;     // no values set
+   _initialised = false;
+   _deferred    = false;
+}
+
+SI2CIO::SI2CIO ( const t_softI2CBus &bus )
+{
+   _bus         = &bus;
    _i2cAddr     = 0x0;
    _dirMask     = 0xFF;    // mark all as INPUTs
    _shadow      = 0x0;     // no values set
    _initialised = false;
+   _deferred    = false;
 }
 
 // PUBLIC METHODS
@@ -78,13 +83,13 @@ int SI2CIO::begin (  uint8_t i2cAddr )
    // convert to 8 bit addresses for mapping as needed by the bitbang library
    _i2cAddr = ( i2cAddr << 1 );
    
-   i2c_init();
+   _bus->init();
       
-   _initialised = i2c_start(_i2cAddr | I2C_READ);
+   _initialised = _bus->start(_i2cAddr | I2C_READ);
 
-   _shadow = i2c_read(true);
+   _shadow = _bus->read(true);
    
-   i2c_stop();
+   _bus->stop();
    
    return ( _initialised );
 }
@@ -132,11 +137,11 @@ uint8_t SI2CIO::read ( void )
    
    if ( _initialised )
    {
-      i2c_start(_i2cAddr | I2C_READ);
+      _bus->start(_i2cAddr | I2C_READ);
  
-	  retVal = (_dirMask & i2c_read(true));
+	  retVal = (_dirMask & _bus->read(true));
 	  
-	  i2c_stop();
+	  _bus->stop();
    }
    return ( retVal );
 }
@@ -153,11 +158,11 @@ int SI2CIO::write ( uint8_t value )
       // outputs updating the output shadow of the device
       _shadow = ( value & ~(_dirMask) );
    
-      status = i2c_start(_i2cAddr | I2C_WRITE);
+      status = _bus->start(_i2cAddr | I2C_WRITE);
  
-	  status &= i2c_write(_shadow);
+	  status &= _bus->write(_shadow);
       
-	  i2c_stop();
+	  _bus->stop();
    }
    return ( (status == 0) );
 }
@@ -183,29 +188,56 @@ uint8_t SI2CIO::digitalRead ( uint8_t pin )
 // digitalWrite
 int SI2CIO::digitalWrite ( uint8_t pin, uint8_t level )
 {
-   uint8_t writeVal;
    int status = 0;
    
    // Check if initialised and that the pin is within range of the device
    // -------------------------------------------------------------------
    if ( ( _initialised ) && ( pin <= 7 ) )
    {
-      // Only write to HIGH the port if the port has been configured as
-      // an OUTPUT pin. Add the new state of the pin to the shadow
-      writeVal = ( 1 << pin ) & ~_dirMask;
-      if ( level == HIGH )
+      status = writeMasked ( ( 1 << pin ), ( level == HIGH ) ? 0xFF : 0x00 );
+   }
+   return ( status );
+}
+
+//
+// writeMasked
+int SI2CIO::writeMasked ( uint8_t mask, uint8_t values )
+{
+   int status = 0;
+   
+   if ( _initialised )
+   {
+      // Only write to HIGH the ports that have been configured as OUTPUT
+      // pins. Update the pins in the mask in the shadow
+      mask &= ~_dirMask;
+      _shadow = ( _shadow & ~mask ) | ( values & mask );
+      
+      if ( _deferred )
       {
-         _shadow |= writeVal; 
+         status = 1;
       }
-      else 
+      else
       {
-         _shadow &= ~writeVal;
+         status = this->write ( _shadow );
       }
-      status = this->write ( _shadow );
    }
    return ( status );
 }
 
+//
+// setDeferredCommit
+void SI2CIO::setDeferredCommit ( bool deferred )
+{
+   _deferred = deferred;
+}
+
+//
+// commit
+int SI2CIO::commit ( void )
+{
+   return ( this->write ( _shadow ) );
+}
+
 //
 // PRIVATE METHODS
 // ---------------------------------------------------------------------------
@@ -31,6 +31,7 @@
 #if defined (__AVR__)
 
 #include <inttypes.h>
+#include "SoftI2CMaster.h"
 
 #define _SI2CIO_VERSION "1.0.0"
 
@@ -51,6 +52,16 @@ public:
     */
    SI2CIO ( );
    
+   /*!
+    @method     
+    @abstract   Constructor method
+    @discussion Class constructor for a device on a given software I2C bus.
+    The bus is generated with SOFTI2C_BUS, the default constructor uses the
+    bus of the library (SCL on PB0, SDA on PB1).
+    @param      bus[in] software I2C bus of the device.
+    */
+   SI2CIO ( const t_softI2CBus &bus );
+   
    /*!
     @method
     @abstract   Initializes the device.
@@ -138,13 +149,51 @@ public:
     */   
    int digitalWrite ( uint8_t pin, uint8_t level );
    
+   /*!
+    @method
+    @abstract   Writes a set of pins of the device at once.
+    @discussion Updates the level of all the pins in mask with the values of
+    the corresponding bits in values, in a single transaction. Pins not in
+    mask keep their current level. As with digitalWrite, only pins configured
+    as OUTPUT are changed.
+    
+    @param      mask[in] pins to update, bit n represents pin n.
+    @param      values[in] levels of the pins to update.
+    @result     1 on success, 0 otherwise.
+    */
+   int writeMasked ( uint8_t mask, uint8_t values );
+   
+   /*!
+    @method
+    @abstract   Enables or disables the deferred commit mode.
+    @discussion In deferred commit mode digitalWrite and writeMasked only
+    update the output shadow of the device, the changes are written to the
+    device by calling commit. This allows any number of pin changes to be
+    sent in a single transaction.
+    
+    @param      deferred[in] true to defer the writes, false to write straight
+    away (default).
+    */
+   void setDeferredCommit ( bool deferred );
+   
+   /*!
+    @method
+    @abstract   Writes the pending pin changes to the device.
+    @discussion Writes the output shadow of the device. @see setDeferredCommit.
+    
+    @result     1 on success, 0 otherwise.
+    */
+   int commit ( void );
+   
    
    
 private:
+   const t_softI2CBus *_bus; // Software I2C bus
    uint8_t _shadow;      // Shadow output
    uint8_t _dirMask;     // Direction mask
    uint8_t _i2cAddr;     // I2C address
    bool    _initialised; // Initialised object
+   bool    _deferred;    // Writes deferred until commit
    
 };
 
@@ -0,0 +1,299 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file SI2CLanes.cpp
+// This file implements parallel software I2C buses sharing one SCL line.
+//
+// @brief
+// The lines are driven open drain: the output registers are cleared and a
+// line is pulled low by setting its direction bit, released (pulled up) by
+// clearing it. @see SI2CLanes.h.
+//
+// ---------------------------------------------------------------------------
+
+#if defined (__AVR__)
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include <inttypes.h>
+
+#include "SI2CLanes.h"
+#include "FastIO.h"
+
+
+// CONSTRUCTOR
+// ---------------------------------------------------------------------------
+SI2CLanes::SI2CLanes ( uint8_t scl, const uint8_t *sda, uint8_t lanes,
+                       uint8_t *queues, uint16_t size )
+{
+   uint8_t port = digitalPinToPort ( sda[0] );
+
+   _lanes     = ( lanes > SI2C_LANES_MAX ) ? SI2C_LANES_MAX : lanes;
+   _queue     = queues;
+   _queueLen  = ( _lanes == 0 ) ? 0 :
+                ( ( size / _lanes > 255 ) ? 255 : size / _lanes );
+   _sclBit    = digitalPinToBitMask ( scl );
+   _sclDdr    = portModeRegister ( digitalPinToPort ( scl ) );
+   _sclIn     = portInputRegister ( digitalPinToPort ( scl ) );
+   _sclOut    = portOutputRegister ( digitalPinToPort ( scl ) );
+   _sdaDdr    = portModeRegister ( port );
+   _sdaIn     = portInputRegister ( port );
+   _sdaOut    = portOutputRegister ( port );
+   _sdaMask   = 0;
+   _samePort  = true;
+
+   for ( uint8_t lane = 0; lane < _lanes; lane++ )
+   {
+      _sdaBit[lane] = digitalPinToBitMask ( sda[lane] );
+      _sdaMask     |= _sdaBit[lane];
+      _addr[lane]   = 0;
+      _len[lane]    = 0;
+
+      if ( digitalPinToPort ( sda[lane] ) != port )
+      {
+         _samePort = false;
+      }
+   }
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+uint8_t SI2CLanes::begin ( void )
+{
+   uint8_t idle = 0;
+
+   if ( _samePort )
+   {
+      // Release all the lines, clear the outputs for the open drain drive
+      FIO_ATOMIC_BLOCK
+      {
+         *_sdaDdr &= ~_sdaMask;
+         *_sdaOut &= ~_sdaMask;
+         *_sclDdr &= ~_sclBit;
+         *_sclOut &= ~_sclBit;
+      }
+      delayMicroseconds ( SI2C_LANES_HALF_US );
+
+      if ( *_sclIn & _sclBit )
+      {
+         for ( uint8_t lane = 0; lane < _lanes; lane++ )
+         {
+            if ( *_sdaIn & _sdaBit[lane] )
+            {
+               idle |= ( 1 << lane );
+            }
+         }
+      }
+   }
+   return ( idle );
+}
+
+//
+// queue
+void SI2CLanes::queue ( uint8_t lane, uint8_t i2cAddr, const uint8_t *buf,
+                        uint8_t len )
+{
+   if ( ( lane < _lanes ) && ( _queueLen != 0 ) )
+   {
+      uint8_t *queue = &_queue[lane * _queueLen];
+
+      // convert to 8 bit addresses, write transaction
+      i2cAddr <<= 1;
+
+      // The queue of a lane goes to a single device, keep the bytes in one
+      // transaction when they fit in the queue
+      if ( ( ( _len[lane] != 0 ) && ( _addr[lane] != i2cAddr ) ) ||
+           ( ( len <= _queueLen ) && ( _len[lane] + len > _queueLen ) ) )
+      {
+         flush ( );
+      }
+      _addr[lane] = i2cAddr;
+
+      for ( uint8_t i = 0; i < len; i++ )
+      {
+         if ( _len[lane] == _queueLen )
+         {
+            flush ( );
+         }
+         queue[_len[lane]++] = buf[i];
+      }
+   }
+}
+
+//
+// flush
+uint8_t SI2CLanes::flush ( void )
+{
+   uint8_t values[SI2C_LANES_MAX];
+   uint8_t sda   = 0;
+   uint8_t count = 0;
+   uint8_t ack;
+   uint8_t result = 0;
+
+   // Lanes with something to send, the transactions last as long as the
+   // longest queue
+   for ( uint8_t lane = 0; lane < _lanes; lane++ )
+   {
+      if ( _len[lane] != 0 )
+      {
+         sda |= _sdaBit[lane];
+         if ( _len[lane] > count )
+         {
+            count = _len[lane];
+         }
+      }
+   }
+
+   if ( ( sda == 0 ) || !_samePort )
+   {
+      return ( 0 );
+   }
+
+   start ( sda );
+   ack = write ( sda, _addr );
+
+   for ( uint8_t i = 0; i < count; i++ )
+   {
+      // Shorter queues repeat their last byte
+      for ( uint8_t lane = 0; lane < _lanes; lane++ )
+      {
+         if ( _len[lane] != 0 )
+         {
+            values[lane] = _queue[lane * _queueLen + ( ( i < _len[lane] ) ? i : _len[lane] - 1 )];
+         }
+      }
+      ack &= write ( sda, values );
+   }
+
+   stop ( sda );
+
+   // Map the acknowledged SDA lines back to lanes and empty the queues
+   for ( uint8_t lane = 0; lane < _lanes; lane++ )
+   {
+      if ( ( _len[lane] != 0 ) && ( ack & _sdaBit[lane] ) )
+      {
+         result |= ( 1 << lane );
+      }
+      _len[lane] = 0;
+   }
+   return ( result );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// start
+void SI2CLanes::start ( uint8_t sda )
+{
+   // SDA falls while SCL is high
+   sdaWrite ( sda, sda );
+   delayMicroseconds ( SI2C_LANES_HALF_US );
+   sclLow ( );
+}
+
+//
+// stop
+void SI2CLanes::stop ( uint8_t sda )
+{
+   // SDA rises while SCL is high
+   sdaWrite ( sda, sda );
+   delayMicroseconds ( SI2C_LANES_HALF_US );
+   sclRelease ( );
+   delayMicroseconds ( SI2C_LANES_HALF_US );
+   sdaWrite ( sda, 0 );
+   delayMicroseconds ( SI2C_LANES_HALF_US );
+}
+
+//
+// write
+uint8_t SI2CLanes::write ( uint8_t sda, const uint8_t *values )
+{
+   uint8_t low[8];
+   uint8_t ack;
+
+   // Transpose the bytes of the lanes into one SDA port word per bit, MSB
+   // first, so that each bit is a single port write
+   for ( uint8_t bit = 0; bit < 8; bit++ )
+   {
+      uint8_t mask = ( 0x80 >> bit );
+
+      low[bit] = 0;
+      for ( uint8_t lane = 0; lane < _lanes; lane++ )
+      {
+         if ( !( values[lane] & mask ) )
+         {
+            low[bit] |= _sdaBit[lane];
+         }
+      }
+      low[bit] &= sda;
+   }
+
+   for ( uint8_t bit = 0; bit < 8; bit++ )
+   {
+      sdaWrite ( sda, low[bit] );
+      delayMicroseconds ( SI2C_LANES_HALF_US );
+      sclRelease ( );
+      delayMicroseconds ( SI2C_LANES_HALF_US );
+      sclLow ( );
+   }
+
+   // Acknowledge bit, the devices pull their SDA line low
+   sdaWrite ( sda, 0 );
+   delayMicroseconds ( SI2C_LANES_HALF_US );
+   sclRelease ( );
+   ack = ~( *_sdaIn ) & sda;
+   delayMicroseconds ( SI2C_LANES_HALF_US );
+   sclLow ( );
+
+   return ( ack );
+}
+
+//
+// sdaWrite
+void SI2CLanes::sdaWrite ( uint8_t sda, uint8_t low )
+{
+   FIO_ATOMIC_BLOCK
+   {
+      *_sdaDdr = ( *_sdaDdr & ~sda ) | low;
+   }
+}
+
+//
+// sclRelease
+void SI2CLanes::sclRelease ( void )
+{
+   FIO_ATOMIC_BLOCK
+   {
+      *_sclDdr &= ~_sclBit;
+   }
+
+   // Wait for clock stretching devices
+   while ( !( *_sclIn & _sclBit ) );
+}
+
+//
+// sclLow
+void SI2CLanes::sclLow ( void )
+{
+   FIO_ATOMIC_BLOCK
+   {
+      *_sclDdr |= _sclBit;
+   }
+}
+
+#endif // defined (__AVR__)
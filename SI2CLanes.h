@@ -0,0 +1,198 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file SI2CLanes.h
+// This file implements parallel software I2C buses sharing one SCL line.
+//
+// @brief
+// Up to 8 software I2C buses (lanes) with their SDA lines on the same AVR
+// port and a common SCL line. Every bit is clocked on all the lanes at once
+// with a single write to the SDA port, each lane carrying its own byte
+// stream, so N devices are written in the time it takes to write one.
+//
+// The lanes are write only. Writes are queued per lane and sent by flush,
+// one transaction per lane, all the transactions in lock-step: lanes with
+// a shorter queue repeat their last byte, which leaves the outputs of an IO
+// expander unchanged. Lanes with nothing queued are not addressed, their SDA
+// stays released.
+//
+// The queues are a buffer given by the caller, split evenly between the
+// lanes, so only the lanes in use take RAM:
+//
+//    uint8_t queues[4 * SI2C_LANES_QUEUE];
+//    SI2CLanes lanes ( 6, sda, 4, queues, sizeof ( queues ) );
+//
+// ---------------------------------------------------------------------------
+#ifndef _SI2CLANES_H_
+#define _SI2CLANES_H_
+
+#if defined (__AVR__)
+
+#include <inttypes.h>
+
+/*!
+ @defined
+ @abstract   Maximum number of lanes.
+ @discussion One per bit of the SDA port.
+ */
+#define SI2C_LANES_MAX       8
+
+/*!
+ @defined
+ @abstract   Recommended size of the queue of each lane.
+ @discussion When a lane queue is full all the lanes are flushed, a write
+ longer than the queue is no longer sent in parallel with the other lanes.
+ 80 bytes are a 20 character row of an LCD on a PCF8574 (4 bytes per
+ character).
+ */
+#ifndef SI2C_LANES_QUEUE
+#define SI2C_LANES_QUEUE     80
+#endif
+
+/*!
+ @defined
+ @abstract   Half of the SCL period in us.
+ @discussion 5us gives slightly less than 100kHz with the code overhead,
+ 2us can be used with 400kHz devices.
+ */
+#ifndef SI2C_LANES_HALF_US
+#define SI2C_LANES_HALF_US   5
+#endif
+
+/*!
+ @class
+ @abstract    SI2CLanes
+ @discussion  Software I2C buses written in lock-step through a shared SCL.
+ */
+class SI2CLanes
+{
+public:
+   /*!
+    @method
+    @abstract   Constructor method
+    @discussion Class constructor. Lane n uses sda[n] as SDA line, all the SDA
+    pins have to be on the same port.
+    @param      scl[in] pin of the shared SCL line.
+    @param      sda[in] pins of the SDA lines of the lanes.
+    @param      lanes[in] number of lanes (1..SI2C_LANES_MAX).
+    @param      queues[in] buffer of the lane queues, lanes * SI2C_LANES_QUEUE
+    bytes are recommended. It has to stay allocated while the object is used.
+    @param      size[in] size of the buffer, each lane queue holds size / lanes
+    bytes (up to 255).
+    */
+   SI2CLanes ( uint8_t scl, const uint8_t *sda, uint8_t lanes,
+               uint8_t *queues, uint16_t size );
+
+   /*!
+    @method
+    @abstract   Initializes the lanes.
+    @discussion Releases SCL and the SDA lines. Can be called once per device
+    on the lanes.
+    @result     mask of the lanes (bit n for lane n) with SDA and SCL high,
+    0 if the SDA pins are not on the same port.
+    */
+   uint8_t begin ( void );
+
+   /*!
+    @method
+    @abstract   Queues bytes for a device on a lane.
+    @discussion The bytes are written to the device by the next flush, in a
+    single transaction. All the lanes are flushed first if the lane has bytes
+    queued for another device, and whenever the queue of the lane fills up:
+    more bytes than the lane queue holds are written in several transactions.
+    @param      lane[in] lane of the device.
+    @param      i2cAddr[in] I2C address of the device (7 bit).
+    @param      buf[in] bytes to write.
+    @param      len[in] number of bytes.
+    */
+   void queue ( uint8_t lane, uint8_t i2cAddr, const uint8_t *buf, uint8_t len );
+
+   /*!
+    @method
+    @abstract   Writes the queued bytes of all the lanes.
+    @discussion Sends a start condition, the address and the queued bytes of
+    every lane with a non empty queue, clocking all of them at once.
+    @result     mask of the lanes written and acknowledged by their device.
+    */
+   uint8_t flush ( void );
+
+   /*!
+    @method
+    @abstract   Number of lanes.
+    */
+   uint8_t lanes ( void ) { return _lanes; }
+
+private:
+   /*!
+    @method
+    @abstract   Start condition on a set of lanes.
+    @param      sda[in] SDA port mask of the lanes.
+    */
+   void start ( uint8_t sda );
+
+   /*!
+    @method
+    @abstract   Stop condition on a set of lanes.
+    @param      sda[in] SDA port mask of the lanes.
+    */
+   void stop ( uint8_t sda );
+
+   /*!
+    @method
+    @abstract   Writes a byte on each lane of a set.
+    @param      sda[in] SDA port mask of the lanes.
+    @param      values[in] byte of each lane.
+    @result     SDA port mask of the lanes that acknowledged.
+    */
+   uint8_t write ( uint8_t sda, const uint8_t *values );
+
+   /*!
+    @method
+    @abstract   Drives the SDA lines of a set.
+    @param      sda[in] SDA port mask of the lanes.
+    @param      low[in] SDA port mask of the lines to pull low, the others
+    are released.
+    */
+   void sdaWrite ( uint8_t sda, uint8_t low );
+
+   /*!
+    @method
+    @abstract   Releases SCL and waits for it to be high (clock stretching).
+    */
+   void sclRelease ( void );
+
+   /*!
+    @method
+    @abstract   Pulls SCL low.
+    */
+   void sclLow ( void );
+
+   volatile uint8_t *_sdaDdr;             // SDA port direction register
+   volatile uint8_t *_sdaIn;              // SDA port input register
+   volatile uint8_t *_sdaOut;             // SDA port output register
+   volatile uint8_t *_sclDdr;             // SCL direction register
+   volatile uint8_t *_sclIn;              // SCL input register
+   volatile uint8_t *_sclOut;             // SCL output register
+   uint8_t _sclBit;                       // SCL port mask
+   uint8_t _sdaBit[SI2C_LANES_MAX];       // SDA port mask of each lane
+   uint8_t _sdaMask;                      // SDA port mask of all the lanes
+   uint8_t _lanes;                        // Number of lanes
+   bool    _samePort;                     // SDA lines on the same port
+   uint8_t _addr[SI2C_LANES_MAX];         // 8 bit I2C address of each lane
+   uint8_t _len[SI2C_LANES_MAX];          // Queued bytes of each lane
+   uint8_t *_queue;                       // Lane queues, _queueLen bytes each
+   uint8_t _queueLen;                     // Size of the queue of a lane
+};
+
+#else
+#error "ONLY SUPPORTED ON AVR PROCESSORS"
+#endif // defined (__AVR__)
+
+#endif
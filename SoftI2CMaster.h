@@ -42,9 +42,21 @@
  *   until issuing a stop condition. So use this option with care!
  * - I2C_TIMEOUT = 0..10000 mssec in order to return from the I2C functions
  *   in case of a I2C bus lockup (i.e., SCL constantly low). 0 means no timeout
+ *
+ * Several buses on independent pins: instead of defining SDA_PIN, ...,
+ * generate one set of functions per bus with SOFTI2C_BUS in exactly one
+ * source file, e.g. for SDA on PD7 and SCL on PD6:
+ * SOFTI2C_BUS(lcdBus, PORTD, 7, PORTD, 6)
+ * This defines lcdBus_init, lcdBus_start, lcdBus_rep_start,
+ * lcdBus_start_wait, lcdBus_stop, lcdBus_write and lcdBus_read, the same
+ * assembler routines as the i2c_* functions with the port and bit of the
+ * bus built in, and lcdBus, a t_softI2CBus table of these functions.
+ * Other source files can declare it with SOFTI2C_BUS_EXTERN(lcdBus).
  */
 
 /* Changelog:
+ * Version 1.2:
+ * - added SOFTI2C_BUS to generate the functions of several buses
  * Version 1.1: 
  * - removed I2C_CLOCK_STRETCHING
  * - added I2C_TIMEOUT time in msec (0..10000) until timeout or 0 if no timeout
@@ -60,38 +72,6 @@
 
 #if defined (__AVR__)
 
-// Init function. Needs to be called once in the beginning.
-// Returns false if SDA or SCL are low, which probably means 
-// a I2C bus lockup or that the lines are not pulled up.
-boolean __attribute__ ((noinline)) i2c_init(void);
-
-// Start transfer function: <addr> is the 8-bit I2C address (including the R/W
-// bit). 
-// Return: true if the slave replies with an "acknowledge", false otherwise
-bool __attribute__ ((noinline)) i2c_start(uint8_t addr); 
-
-// Similar to start function, but wait for an ACK! Be careful, this can 
-// result in an infinite loop!
-void  __attribute__ ((noinline)) i2c_start_wait(uint8_t addr);
-
-// Repeated start function: After having claimed the bus with a start condition,
-// you can address another or the same chip again without an intervening 
-// stop condition.
-// Return: true if the slave replies with an "acknowledge", false otherwise
-bool __attribute__ ((noinline)) i2c_rep_start(uint8_t addr);
-
-// Issue a stop condition, freeing the bus.
-void __attribute__ ((noinline)) i2c_stop(void) asm("ass_i2c_stop");
-
-// Write one byte to the slave chip that had been addressed
-// by the previous start call. <value> is the byte to be sent.
-// Return: true if the slave replies with an "acknowledge", false otherwise
-bool __attribute__ ((noinline)) i2c_write(uint8_t value) asm("ass_i2c_write");
-
-// Read one byte. If <last> is true, we send a NAK after having received 
-// the byte in order to terminate the read sequence. 
-uint8_t __attribute__ ((noinline)) i2c_read(bool last);
-
 // You can set I2C_CPUFREQ independently of F_CPU if you 
 // change the CPU frequency on the fly. If do not define it,
 // it will use the value of F_CPU
@@ -163,347 +143,425 @@ uint8_t __attribute__ ((noinline)) i2c_read(bool last);
 #define I2C_READ    1
 #define I2C_WRITE   0
 
-// map the IO register back into the IO address space
-#define SDA_DDR       	(_SFR_IO_ADDR(SDA_PORT) - 1)
-#define SCL_DDR       	(_SFR_IO_ADDR(SCL_PORT) - 1)
-#define SDA_OUT       	_SFR_IO_ADDR(SDA_PORT)
-#define SCL_OUT       	_SFR_IO_ADDR(SCL_PORT)
-#define SDA_IN		(_SFR_IO_ADDR(SDA_PORT) - 2)
-#define SCL_IN		(_SFR_IO_ADDR(SCL_PORT) - 2)
-
 #ifndef __tmp_reg__
 #define __tmp_reg__ 0
 #endif
 
- 
-// Internal delay functions.
-void __attribute__ ((noinline)) i2c_delay_half(void) asm("ass_i2c_delay_half");
-void __attribute__ ((noinline)) i2c_wait_scl_high(void) asm("ass_i2c_wait_scl_high");
+// map the IO register of a given port back into the IO address space
+#define SOFTI2C_DDR(port)	(_SFR_IO_ADDR(port) - 1)
+#define SOFTI2C_OUT(port)	_SFR_IO_ADDR(port)
+#define SOFTI2C_IN(port)	(_SFR_IO_ADDR(port) - 2)
 
-void  i2c_delay_half(void)
-{ // function call 3 cycles => 3C
-#if I2C_DELAY_COUNTER < 1
-  __asm__ __volatile__ (" ret");
-  // 7 cycles for call and return
+// Table of the functions of a bus, generated by SOFTI2C_BUS. It lets a
+// driver work with any bus, the routines themselves keep the port and bit
+// of their bus as immediate operands.
+typedef struct
+{
+  boolean (*init)(void);
+  bool    (*start)(uint8_t addr);
+  bool    (*rep_start)(uint8_t addr);
+  void    (*stop)(void);
+  bool    (*write)(uint8_t value);
+  uint8_t (*read)(bool last);
+} t_softI2CBus;
+
+// Declares the table of a bus generated in another source file.
+#define SOFTI2C_BUS_EXTERN(bus) extern const t_softI2CBus bus;
+
+// Generates the functions of a bus named <bus> and its table <bus>. Use it
+// once per bus, in a single source file. The assembler names of the
+// routines and their local labels carry the name of the bus, so that
+// several buses can be linked together. The functions are:
+//
+// boolean bus_init(void): Init function. Needs to be called once in the
+// beginning. Returns false if SDA or SCL are low, which probably means
+// a I2C bus lockup or that the lines are not pulled up.
+//
+// bool bus_start(uint8_t addr): Start transfer function: <addr> is the
+// 8-bit I2C address (including the R/W bit).
+// Return: true if the slave replies with an "acknowledge", false otherwise
+//
+// void bus_start_wait(uint8_t addr): Similar to start function, but wait
+// for an ACK! Be careful, this can result in an infinite loop!
+//
+// bool bus_rep_start(uint8_t addr): Repeated start function: After having
+// claimed the bus with a start condition, you can address another or the
+// same chip again without an intervening stop condition.
+// Return: true if the slave replies with an "acknowledge", false otherwise
+//
+// void bus_stop(void): Issue a stop condition, freeing the bus.
+//
+// bool bus_write(uint8_t value): Write one byte to the slave chip that had
+// been addressed by the previous start call. <value> is the byte to be sent.
+// Return: true if the slave replies with an "acknowledge", false otherwise
+//
+// uint8_t bus_read(bool last): Read one byte. If <last> is true, we send a
+// NAK after having received the byte in order to terminate the read
+// sequence.
+#define SOFTI2C_BUS(bus, sdaPort, sdaPin, sclPort, sclPin) \
+  SOFTI2C_DECLARE(bus) \
+  SOFTI2C_DEFINE_DELAY_HALF(bus) \
+  SOFTI2C_DEFINE_WAIT_SCL_HIGH(bus, sclPort, sclPin) \
+  SOFTI2C_DEFINE_INIT(bus, sdaPort, sdaPin, sclPort, sclPin) \
+  SOFTI2C_DEFINE_START(bus, sdaPort, sdaPin, sclPort, sclPin) \
+  SOFTI2C_DEFINE_REP_START(bus, sdaPort, sdaPin, sclPort, sclPin) \
+  SOFTI2C_DEFINE_START_WAIT(bus, sdaPort, sdaPin, sclPort, sclPin) \
+  SOFTI2C_DEFINE_STOP(bus, sdaPort, sdaPin, sclPort, sclPin) \
+  SOFTI2C_DEFINE_WRITE(bus, sdaPort, sdaPin, sclPort, sclPin) \
+  SOFTI2C_DEFINE_READ(bus, sdaPort, sdaPin, sclPort, sclPin) \
+  SOFTI2C_BUS_EXTERN(bus) \
+  const t_softI2CBus bus = { bus##_init, bus##_start, bus##_rep_start, \
+                             bus##_stop, bus##_write, bus##_read };
+
+// Operands of the routines
+#define SOFTI2C_OPERANDS(sdaPort, sdaPin, sclPort, sclPin) \
+  [SCLDDR] "I" (SOFTI2C_DDR(sclPort)), [SCLPIN] "I" (sclPin), \
+  [SCLIN] "I" (SOFTI2C_IN(sclPort)), [SCLOUT] "I" (SOFTI2C_OUT(sclPort)), \
+  [SDADDR] "I" (SOFTI2C_DDR(sdaPort)), [SDAPIN] "I" (sdaPin), \
+  [SDAIN] "I" (SOFTI2C_IN(sdaPort)), [SDAOUT] "I" (SOFTI2C_OUT(sdaPort))
+
+// Call of a routine of the same bus
+#define SOFTI2C_CALL(bus, routine) " rcall    ass_" #bus "_" #routine " \n\t"
+
+// Local label of a bus routine
+#define SOFTI2C_LABEL(bus, label) "_L" #bus "_" #label
+
+// T/2 delays that are only needed if there is a delay loop
+#if I2C_DELAY_COUNTER >= 1
+#define SOFTI2C_DELAY(bus) SOFTI2C_CALL(bus, delay_half)
 #else
-  __asm__ __volatile__ 
-    (
-     " ldi      r25, %[DELAY]           ;load delay constant   ;; 4C \n\t"
-     "_Lidelay: \n\t"
-     " dec r25                          ;decrement counter     ;; 4C+xC \n\t"
-     " brne _Lidelay                                           ;;5C+(x-1)2C+xC\n\t"
-     " ret                                                     ;; 9C+(x-1)2C+xC = 7C+xC" 
-     : : [DELAY] "M" I2C_DELAY_COUNTER : "r25");
-  // 7 cycles + 3 times x cycles
+#define SOFTI2C_DELAY(bus) ""
 #endif
-}
 
-void i2c_wait_scl_high(void)
-{
-#if I2C_TIMEOUT <= 0
-  __asm__ __volatile__ 
-    ("_Li2c_wait_stretch: \n\t"
-     " sbis	%[SCLIN],%[SCLPIN]	;wait for SCL high \n\t" 
-     " rjmp	_Li2c_wait_stretch \n\t"
-     " cln                              ;signal: no timeout \n\t"
-     " ret "
-     : : [SCLIN] "I" (SCL_IN), [SCLPIN] "I" (SCL_PIN));
+#if I2C_NOINTERRUPT
+#define SOFTI2C_CLI " cli                              ;clear IRQ bit \n\t"
+#define SOFTI2C_SEI " sei                              ;enable interrupts again!\n\t"
 #else
-  __asm__ __volatile__ 
-    ( " ldi     r27, %[HISTRETCH]       ;load delay counter \n\t"
-      " ldi     r26, %[LOSTRETCH] \n\t"
-      "_Lwait_stretch: \n\t"
-      " clr     __tmp_reg__             ;do next loop 255 times \n\t"
-      "_Lwait_stretch_inner_loop: \n\t"
-      " rcall   _Lcheck_scl_level       ;call check function   ;; 12C \n\t"
-      " brpl    _Lstretch_done          ;done if N=0           ;; +1 = 13C\n\t"
-      " dec     __tmp_reg__             ;dec inner loop counter;; +1 = 14C\n\t"
-      " brne    _Lwait_stretch_inner_loop                      ;; +2 = 16C\n\t"
-      " sbiw    r26,1                   ;dec outer loop counter \n\t"
-      " brne    _Lwait_stretch          ;continue with outer loop \n\t"
-      " sen                             ;timeout -> set N-bit=1 \n\t"
-      " rjmp _Lwait_return              ;and return with N=1\n\t"
-      "_Lstretch_done:                  ;SCL=1 sensed \n\t"            
-      " cln                             ;OK -> clear N-bit \n\t"
-      " rjmp _Lwait_return              ; and return with N=0 \n\t"
-
-      "_Lcheck_scl_level:                                      ;; call = 3C\n\t"
-      " cln                                                    ;; +1C = 4C \n\t"
-      " sbic	%[SCLIN],%[SCLPIN]      ;skip if SCL still low ;; +2C = 6C \n\t"
-      " rjmp    _Lscl_high                                     ;; +0C = 6C \n\t"
-      " sen                                                    ;; +1 = 7C\n\t "
-      "_Lscl_high: "
-      " nop                                                    ;; +1C = 8C \n\t"
-      " ret                             ;return N-Bit=1 if low ;; +4 = 12C\n\t"
-
-      "_Lwait_return:"
-      : : [SCLIN] "I" (SCL_IN), [SCLPIN] "I" (SCL_PIN), 
-	[HISTRETCH] "M" (I2C_MAX_STRETCH>>8), 
-	[LOSTRETCH] "M" (I2C_MAX_STRETCH&0xFF)
-      : "r26", "r27");
+#define SOFTI2C_CLI ""
+#define SOFTI2C_SEI ""
 #endif
+
+#define SOFTI2C_DECLARE(bus) \
+  boolean __attribute__ ((noinline)) bus##_init(void); \
+  bool __attribute__ ((noinline)) bus##_start(uint8_t addr); \
+  void __attribute__ ((noinline)) bus##_start_wait(uint8_t addr); \
+  bool __attribute__ ((noinline)) bus##_rep_start(uint8_t addr); \
+  void __attribute__ ((noinline)) bus##_stop(void) asm("ass_" #bus "_stop"); \
+  bool __attribute__ ((noinline)) bus##_write(uint8_t value) asm("ass_" #bus "_write"); \
+  uint8_t __attribute__ ((noinline)) bus##_read(bool last); \
+  void __attribute__ ((noinline)) bus##_delay_half(void) asm("ass_" #bus "_delay_half"); \
+  void __attribute__ ((noinline)) bus##_wait_scl_high(void) asm("ass_" #bus "_wait_scl_high");
+
+// Internal delay function.
+#if I2C_DELAY_COUNTER < 1
+#define SOFTI2C_DEFINE_DELAY_HALF(bus) \
+void bus##_delay_half(void) \
+{ /* function call 3 cycles => 3C */ \
+  __asm__ __volatile__ (" ret"); \
+  /* 7 cycles for call and return */ \
+}
+#else
+#define SOFTI2C_DEFINE_DELAY_HALF(bus) \
+void bus##_delay_half(void) \
+{ /* function call 3 cycles => 3C */ \
+  __asm__ __volatile__ \
+    ( \
+     " ldi      r25, %[DELAY]           ;load delay constant   ;; 4C \n\t" \
+     SOFTI2C_LABEL(bus, idelay) ": \n\t" \
+     " dec r25                          ;decrement counter     ;; 4C+xC \n\t" \
+     " brne " SOFTI2C_LABEL(bus, idelay) "                     ;;5C+(x-1)2C+xC\n\t" \
+     " ret                                                     ;; 9C+(x-1)2C+xC = 7C+xC" \
+     : : [DELAY] "M" I2C_DELAY_COUNTER : "r25"); \
+  /* 7 cycles + 3 times x cycles */ \
 }
+#endif
 
+// Internal clock stretching function.
+#if I2C_TIMEOUT <= 0
+#define SOFTI2C_DEFINE_WAIT_SCL_HIGH(bus, sclPort, sclPin) \
+void bus##_wait_scl_high(void) \
+{ \
+  __asm__ __volatile__ \
+    (SOFTI2C_LABEL(bus, wait_stretch) ": \n\t" \
+     " sbis	%[SCLIN],%[SCLPIN]	;wait for SCL high \n\t" \
+     " rjmp	" SOFTI2C_LABEL(bus, wait_stretch) " \n\t" \
+     " cln                              ;signal: no timeout \n\t" \
+     " ret " \
+     : : [SCLIN] "I" (SOFTI2C_IN(sclPort)), [SCLPIN] "I" (sclPin)); \
+}
+#else
+#define SOFTI2C_DEFINE_WAIT_SCL_HIGH(bus, sclPort, sclPin) \
+void bus##_wait_scl_high(void) \
+{ \
+  __asm__ __volatile__ \
+    ( " ldi     r27, %[HISTRETCH]       ;load delay counter \n\t" \
+      " ldi     r26, %[LOSTRETCH] \n\t" \
+      SOFTI2C_LABEL(bus, wait_stretch) ": \n\t" \
+      " clr     __tmp_reg__             ;do next loop 255 times \n\t" \
+      SOFTI2C_LABEL(bus, wait_stretch_inner_loop) ": \n\t" \
+      " rcall   " SOFTI2C_LABEL(bus, check_scl_level) " ;call check function ;; 12C \n\t" \
+      " brpl    " SOFTI2C_LABEL(bus, stretch_done) " ;done if N=0 ;; +1 = 13C\n\t" \
+      " dec     __tmp_reg__             ;dec inner loop counter;; +1 = 14C\n\t" \
+      " brne    " SOFTI2C_LABEL(bus, wait_stretch_inner_loop) " ;; +2 = 16C\n\t" \
+      " sbiw    r26,1                   ;dec outer loop counter \n\t" \
+      " brne    " SOFTI2C_LABEL(bus, wait_stretch) " ;continue with outer loop \n\t" \
+      " sen                             ;timeout -> set N-bit=1 \n\t" \
+      " rjmp    " SOFTI2C_LABEL(bus, wait_return) " ;and return with N=1\n\t" \
+      SOFTI2C_LABEL(bus, stretch_done) ":                  ;SCL=1 sensed \n\t" \
+      " cln                             ;OK -> clear N-bit \n\t" \
+      " rjmp    " SOFTI2C_LABEL(bus, wait_return) " ; and return with N=0 \n\t" \
+      \
+      SOFTI2C_LABEL(bus, check_scl_level) ":                   ;; call = 3C\n\t" \
+      " cln                                                    ;; +1C = 4C \n\t" \
+      " sbic	%[SCLIN],%[SCLPIN]      ;skip if SCL still low ;; +2C = 6C \n\t" \
+      " rjmp    " SOFTI2C_LABEL(bus, scl_high) "               ;; +0C = 6C \n\t" \
+      " sen                                                    ;; +1 = 7C\n\t " \
+      SOFTI2C_LABEL(bus, scl_high) ": " \
+      " nop                                                    ;; +1C = 8C \n\t" \
+      " ret                             ;return N-Bit=1 if low ;; +4 = 12C\n\t" \
+      \
+      SOFTI2C_LABEL(bus, wait_return) ":" \
+      : : [SCLIN] "I" (SOFTI2C_IN(sclPort)), [SCLPIN] "I" (sclPin), \
+	[HISTRETCH] "M" (I2C_MAX_STRETCH>>8), \
+	[LOSTRETCH] "M" (I2C_MAX_STRETCH&0xFF) \
+      : "r26", "r27"); \
+}
+#endif
 
-boolean i2c_init(void)
-{
-  __asm__ __volatile__ 
-    (" cbi      %[SDADDR],%[SDAPIN]     ;release SDA \n\t" 
-     " cbi      %[SCLDDR],%[SCLPIN]     ;release SCL \n\t" 
-     " cbi      %[SDAOUT],%[SDAPIN]     ;clear SDA output value \n\t" 
-     " cbi      %[SCLOUT],%[SCLPIN]     ;clear SCL output value \n\t" 
-     " clr      r24                     ;set return value to false \n\t"
-     " clr      r25                     ;set return value to false \n\t"
-     " sbis     %[SDAIN],%[SDAPIN]      ;check for SDA high\n\t"
-     " ret                              ;if low return with false \n\t"  
-     " sbis     %[SCLIN],%[SCLPIN]      ;check for SCL high \n\t"
-     " ret                              ;if low return with false \n\t" 
-     " ldi      r24,1                   ;set return value to true \n\t"
-     " ret "
-     : :
-       [SCLDDR] "I"  (SCL_DDR), [SCLPIN] "I" (SCL_PIN), 
-       [SCLIN] "I" (SCL_IN), [SCLOUT] "I" (SCL_OUT),
-       [SDADDR] "I"  (SDA_DDR), [SDAPIN] "I" (SDA_PIN), 
-       [SDAIN] "I" (SDA_IN), [SDAOUT] "I" (SDA_OUT)); 
-  return true;
+#define SOFTI2C_DEFINE_INIT(bus, sdaPort, sdaPin, sclPort, sclPin) \
+boolean bus##_init(void) \
+{ \
+  __asm__ __volatile__ \
+    (" cbi      %[SDADDR],%[SDAPIN]     ;release SDA \n\t" \
+     " cbi      %[SCLDDR],%[SCLPIN]     ;release SCL \n\t" \
+     " cbi      %[SDAOUT],%[SDAPIN]     ;clear SDA output value \n\t" \
+     " cbi      %[SCLOUT],%[SCLPIN]     ;clear SCL output value \n\t" \
+     " clr      r24                     ;set return value to false \n\t" \
+     " clr      r25                     ;set return value to false \n\t" \
+     " sbis     %[SDAIN],%[SDAPIN]      ;check for SDA high\n\t" \
+     " ret                              ;if low return with false \n\t" \
+     " sbis     %[SCLIN],%[SCLPIN]      ;check for SCL high \n\t" \
+     " ret                              ;if low return with false \n\t" \
+     " ldi      r24,1                   ;set return value to true \n\t" \
+     " ret " \
+     : : SOFTI2C_OPERANDS(sdaPort, sdaPin, sclPort, sclPin)); \
+  return true; \
 }
 
-bool  i2c_start(uint8_t addr)
-{
-  __asm__ __volatile__ 
-    (
-#if I2C_NOINTERRUPT
-     " cli                              ;clear IRQ bit \n\t"
-#endif
-     " sbis     %[SCLIN],%[SCLPIN]      ;check for clock stretching slave\n\t"
-     " rcall    ass_i2c_wait_scl_high   ;wait until SCL=H\n\t" 
-     " sbi      %[SDADDR],%[SDAPIN]     ;force SDA low  \n\t" 
-     " rcall    ass_i2c_delay_half      ;wait T/2 \n\t"
-     " rcall    ass_i2c_write           ;now write address \n\t"
-     " ret"
-     : : [SDADDR] "I"  (SDA_DDR), [SDAPIN] "I" (SDA_PIN),
-       [SCLIN] "I" (SCL_IN),[SCLPIN] "I" (SCL_PIN)); 
-  return true; // we never return here!
+#define SOFTI2C_DEFINE_START(bus, sdaPort, sdaPin, sclPort, sclPin) \
+bool bus##_start(uint8_t addr) \
+{ \
+  __asm__ __volatile__ \
+    ( \
+     SOFTI2C_CLI \
+     " sbis     %[SCLIN],%[SCLPIN]      ;check for clock stretching slave\n\t" \
+     SOFTI2C_CALL(bus, wait_scl_high) \
+     " sbi      %[SDADDR],%[SDAPIN]     ;force SDA low  \n\t" \
+     SOFTI2C_CALL(bus, delay_half) \
+     SOFTI2C_CALL(bus, write) \
+     " ret" \
+     : : SOFTI2C_OPERANDS(sdaPort, sdaPin, sclPort, sclPin)); \
+  return true; /* we never return here! */ \
 }
 
-bool  i2c_rep_start(uint8_t addr)
-{
-  __asm__ __volatile__ 
+#define SOFTI2C_DEFINE_REP_START(bus, sdaPort, sdaPin, sclPort, sclPin) \
+bool bus##_rep_start(uint8_t addr) \
+{ \
+  __asm__ __volatile__ \
+    ( \
+     SOFTI2C_CLI \
+     " sbi	%[SCLDDR],%[SCLPIN]	;force SCL low \n\t" \
+     SOFTI2C_CALL(bus, delay_half) \
+     " cbi	%[SDADDR],%[SDAPIN]	;release SDA \n\t" \
+     SOFTI2C_CALL(bus, delay_half) \
+     " cbi	%[SCLDDR],%[SCLPIN]	;release SCL \n\t" \
+     SOFTI2C_CALL(bus, delay_half) \
+     " sbis     %[SCLIN],%[SCLPIN]      ;check for clock stretching slave\n\t" \
+     SOFTI2C_CALL(bus, wait_scl_high) \
+     " sbi 	%[SDADDR],%[SDAPIN]	;force SDA low \n\t" \
+     SOFTI2C_CALL(bus, delay_half) \
+     SOFTI2C_CALL(bus, write) \
+     " ret" \
+     : : SOFTI2C_OPERANDS(sdaPort, sdaPin, sclPort, sclPin)); \
+  return true; /* just to fool the compiler */ \
+}
 
-    (
-#if I2C_NOINTERRUPT
-     " cli \n\t"
-#endif
-     " sbi	%[SCLDDR],%[SCLPIN]	;force SCL low \n\t" 
-     " rcall 	ass_i2c_delay_half	;delay  T/2 \n\t" 
-     " cbi	%[SDADDR],%[SDAPIN]	;release SDA \n\t" 
-     " rcall	ass_i2c_delay_half	;delay T/2 \n\t" 
-     " cbi	%[SCLDDR],%[SCLPIN]	;release SCL \n\t" 
-     " rcall 	ass_i2c_delay_half	;delay  T/2 \n\t" 
-     " sbis     %[SCLIN],%[SCLPIN]      ;check for clock stretching slave\n\t"
-     " rcall    ass_i2c_wait_scl_high   ;wait until SCL=H\n\t" 
-     " sbi 	%[SDADDR],%[SDAPIN]	;force SDA low \n\t" 
-     " rcall 	ass_i2c_delay_half	;delay	T/2 \n\t" 
-     " rcall    ass_i2c_write       \n\t"
-     " ret"
-     : : [SCLDDR] "I"  (SCL_DDR), [SCLPIN] "I" (SCL_PIN),[SCLIN] "I" (SCL_IN),
-         [SDADDR] "I"  (SDA_DDR), [SDAPIN] "I" (SDA_PIN)); 
-  return true; // just to fool the compiler
+#define SOFTI2C_DEFINE_START_WAIT(bus, sdaPort, sdaPin, sclPort, sclPin) \
+void bus##_start_wait(uint8_t addr) \
+{ \
+ __asm__ __volatile__ \
+   ( \
+    " push	r24                     ;save original parameter \n\t" \
+    SOFTI2C_LABEL(bus, start_wait1) ": \n\t" \
+    " pop       r24                     ;restore original parameter\n\t" \
+    " push      r24                     ;and save again \n\t" \
+    SOFTI2C_CLI \
+    " sbis     %[SCLIN],%[SCLPIN]      ;check for clock stretching slave\n\t" \
+    SOFTI2C_CALL(bus, wait_scl_high) \
+    " sbi 	%[SDADDR],%[SDAPIN]	;force SDA low \n\t" \
+    SOFTI2C_CALL(bus, delay_half) \
+    SOFTI2C_CALL(bus, write) \
+    " tst	r24		        ;if device not busy -> done \n\t" \
+    " brne	" SOFTI2C_LABEL(bus, start_wait_done) " \n\t" \
+    SOFTI2C_CALL(bus, stop) \
+    " rjmp	" SOFTI2C_LABEL(bus, start_wait1) " ;device busy, poll ack again \n\t" \
+    SOFTI2C_LABEL(bus, start_wait_done) ": \n\t" \
+    " pop       __tmp_reg__             ;pop off orig argument \n\t" \
+    " ret " \
+    : : SOFTI2C_OPERANDS(sdaPort, sdaPin, sclPort, sclPin)); \
 }
 
-void  i2c_start_wait(uint8_t addr)
-{
- __asm__ __volatile__ 
-   (
-    " push	r24                     ;save original parameter \n\t"
-    "_Li2c_start_wait1: \n\t"
-    " pop       r24                     ;restore original parameter\n\t"
-    " push      r24                     ;and save again \n\t"
-#if I2C_NOINTERRUPT
-    " cli                               ;disable interrupts \n\t"
-#endif
-    " sbis     %[SCLIN],%[SCLPIN]      ;check for clock stretching slave\n\t"
-    " rcall    ass_i2c_wait_scl_high   ;wait until SCL=H\n\t" 
-    " sbi 	%[SDADDR],%[SDAPIN]	;force SDA low \n\t" 
-    " rcall 	ass_i2c_delay_half	;delay T/2 \n\t" 
-    " rcall 	ass_i2c_write	        ;write address \n\t" 
-    " tst	r24		        ;if device not busy -> done \n\t" 
-    " brne	_Li2c_start_wait_done \n\t" 
-    " rcall	ass_i2c_stop	        ;terminate write & enable IRQ \n\t" 
-    " rjmp	_Li2c_start_wait1	;device busy, poll ack again \n\t" 
-    "_Li2c_start_wait_done: \n\t"
-    " pop       __tmp_reg__             ;pop off orig argument \n\t"
-    " ret "
-    : : [SDADDR] "I"  (SDA_DDR), [SDAPIN] "I" (SDA_PIN),
-      [SCLIN] "I" (SCL_IN),[SCLPIN] "I" (SCL_PIN)); 
+#define SOFTI2C_DEFINE_STOP(bus, sdaPort, sdaPin, sclPort, sclPin) \
+void bus##_stop(void) \
+{ \
+  __asm__ __volatile__ \
+    ( \
+     " sbi      %[SCLDDR],%[SCLPIN]     ;force SCL low \n\t" \
+     " sbi      %[SDADDR],%[SDAPIN]     ;force SDA low \n\t" \
+     SOFTI2C_CALL(bus, delay_half) \
+     " cbi      %[SCLDDR],%[SCLPIN]     ;release SCL \n\t" \
+     SOFTI2C_CALL(bus, delay_half) \
+     " sbis     %[SCLIN],%[SCLPIN]      ;check for clock stretching slave\n\t" \
+     SOFTI2C_CALL(bus, wait_scl_high) \
+     " cbi      %[SDADDR],%[SDAPIN]     ;release SDA \n\t" \
+     SOFTI2C_CALL(bus, delay_half) \
+     SOFTI2C_SEI \
+     : : SOFTI2C_OPERANDS(sdaPort, sdaPin, sclPort, sclPin)); \
 }
 
-void  i2c_stop(void)
-{
-  __asm__ __volatile__ 
-    (
-     " sbi      %[SCLDDR],%[SCLPIN]     ;force SCL low \n\t" 
-     " sbi      %[SDADDR],%[SDAPIN]     ;force SDA low \n\t" 
-     " rcall    ass_i2c_delay_half      ;T/2 delay \n\t"
-     " cbi      %[SCLDDR],%[SCLPIN]     ;release SCL \n\t" 
-     " rcall    ass_i2c_delay_half      ;T/2 delay \n\t"
-     " sbis     %[SCLIN],%[SCLPIN]      ;check for clock stretching slave\n\t"
-     " rcall    ass_i2c_wait_scl_high   ;wait until SCL=H\n\t" 
-     " cbi      %[SDADDR],%[SDAPIN]     ;release SDA \n\t" 
-     " rcall    ass_i2c_delay_half \n\t"
-#if I2C_NOINTERRUPT
-     " sei                              ;enable interrupts again!\n\t"
-#endif
-     : : [SCLDDR] "I"  (SCL_DDR), [SCLPIN] "I" (SCL_PIN), [SCLIN] "I" (SCL_IN),
-         [SDADDR] "I"  (SDA_DDR), [SDAPIN] "I" (SDA_PIN)); 
+#define SOFTI2C_DEFINE_WRITE(bus, sdaPort, sdaPin, sclPort, sclPin) \
+bool bus##_write(uint8_t value) \
+{ \
+  __asm__ __volatile__ \
+    ( \
+     " sec                              ;set carry flag \n\t" \
+     " rol      r24                     ;shift in carry and shift out MSB \n\t" \
+     " rjmp " SOFTI2C_LABEL(bus, write_first) " \n\t" \
+     SOFTI2C_LABEL(bus, write_bit) ":\n\t" \
+     " lsl      r24                     ;left shift into carry ;; 1C\n\t" \
+     SOFTI2C_LABEL(bus, write_first) ":\n\t" \
+     " breq     " SOFTI2C_LABEL(bus, get_ack) " ;jump if TXreg is empty;; +1 = 2C \n\t" \
+     " sbi      %[SCLDDR],%[SCLPIN]     ;force SCL low         ;; +2 = 4C \n\t" \
+     " nop \n\t" \
+     " nop \n\t" \
+     " nop \n\t" \
+     " brcc     " SOFTI2C_LABEL(bus, write_low) "              ;;+1/+2=5/6C\n\t" \
+     " nop                                                     ;; +1 = 7C \n\t" \
+     " cbi %[SDADDR],%[SDAPIN]	        ;release SDA           ;; +2 = 9C \n\t" \
+     " rjmp      " SOFTI2C_LABEL(bus, write_high) "            ;; +2 = 11C \n\t" \
+     SOFTI2C_LABEL(bus, write_low) ": \n\t" \
+     " sbi	%[SDADDR],%[SDAPIN]	;force SDA low         ;; +2 = 9C \n\t" \
+     " rjmp	" SOFTI2C_LABEL(bus, write_high) "             ;;+2 = 11C \n\t" \
+     SOFTI2C_LABEL(bus, write_high) ": \n\t" \
+     SOFTI2C_DELAY(bus) /* delay T/2 ;;+X = 11C+X */ \
+     " cbi	%[SCLDDR],%[SCLPIN]	;release SCL           ;;+2 = 13C+X\n\t" \
+     " cln                              ;clear N-bit           ;;+1 = 14C+X\n\t" \
+     " nop \n\t" \
+     " nop \n\t" \
+     " nop \n\t" \
+     " sbis	%[SCLIN],%[SCLPIN]	;check for SCL high    ;;+2 = 16C+X\n\t" \
+     SOFTI2C_CALL(bus, wait_scl_high) \
+     " brpl     " SOFTI2C_LABEL(bus, delay_scl_high) "        ;;+2 = 18C+X\n\t" \
+     SOFTI2C_LABEL(bus, write_return_false) ": \n\t" \
+     " clr      r24                     ; return false because of timeout \n\t" \
+     " rjmp     " SOFTI2C_LABEL(bus, write_return) " \n\t" \
+     SOFTI2C_LABEL(bus, delay_scl_high) ": \n\t" \
+     SOFTI2C_DELAY(bus) /* delay T/2 ;;+X= 18C+2X */ \
+     " rjmp	" SOFTI2C_LABEL(bus, write_bit) " \n\t" \
+     "              ;; +2 = 20C +2X for one bit-loop \n\t" \
+     SOFTI2C_LABEL(bus, get_ack) ": \n\t" \
+     " sbi	%[SCLDDR],%[SCLPIN]	;force SCL low ;; +2 = 5C \n\t" \
+     " nop \n\t" \
+     " nop \n\t" \
+     " cbi	%[SDADDR],%[SDAPIN]	;release SDA ;;+2 = 7C \n\t" \
+     SOFTI2C_DELAY(bus) /* delay T/2 ;; +X = 7C+X */ \
+     " clr	r25                                            ;; 17C+2X \n\t" \
+     " clr	r24		        ;return 0              ;; 14C + X \n\t" \
+     " cbi	%[SCLDDR],%[SCLPIN]	;release SCL ;; +2 = 9C+X\n\t" \
+     SOFTI2C_LABEL(bus, ack_wait) ": \n\t" \
+     " cln                              ; clear N-bit          ;; 10C + X\n\t" \
+     " nop \n\t" \
+     " sbis	%[SCLIN],%[SCLPIN]	;wait SCL high         ;; 12C + X \n\t" \
+     SOFTI2C_CALL(bus, wait_scl_high) \
+     " brmi     " SOFTI2C_LABEL(bus, write_return_false) "    ;; 13C + X \n\t " \
+     " sbis	%[SDAIN],%[SDAPIN]      ;if SDA hi -> return 0 ;; 15C + X \n\t" \
+     " ldi	r24,1                   ;return true           ;; 16C + X \n\t" \
+     SOFTI2C_DELAY(bus) /* delay T/2 ;; 16C + 2X */ \
+     SOFTI2C_LABEL(bus, write_return) ": \n\t" \
+     " nop \n\t " \
+     " nop \n\t " \
+     " sbi	%[SCLDDR],%[SCLPIN]	;force SCL low so SCL=H is short\n\t" \
+     " ret \n\t" \
+     "              ;; + 4 = 17C + 2X for acknowldge bit" \
+     :: SOFTI2C_OPERANDS(sdaPort, sdaPin, sclPort, sclPin)); \
+  return true; /* fooling the compiler */ \
 }
 
-bool i2c_write(uint8_t value)
-{
-  __asm__ __volatile__ 
-    (
-     " sec                              ;set carry flag \n\t"
-     " rol      r24                     ;shift in carry and shift out MSB \n\t"
-     " rjmp _Li2c_write_first \n\t"
-     "_Li2c_write_bit:\n\t"
-     " lsl      r24                     ;left shift into carry ;; 1C\n\t"
-     "_Li2c_write_first:\n\t"
-     " breq     _Li2c_get_ack           ;jump if TXreg is empty;; +1 = 2C \n\t"
-     " sbi      %[SCLDDR],%[SCLPIN]     ;force SCL low         ;; +2 = 4C \n\t"
-     " nop \n\t"
-     " nop \n\t"
-     " nop \n\t"
-     " brcc     _Li2c_write_low                                ;;+1/+2=5/6C\n\t"
-     " nop                                                     ;; +1 = 7C \n\t"
-     " cbi %[SDADDR],%[SDAPIN]	        ;release SDA           ;; +2 = 9C \n\t"
-     " rjmp      _Li2c_write_high                              ;; +2 = 11C \n\t"
-     "_Li2c_write_low: \n\t"
-     " sbi	%[SDADDR],%[SDAPIN]	;force SDA low         ;; +2 = 9C \n\t"
-     " rjmp	_Li2c_write_high                               ;;+2 = 11C \n\t"
-     "_Li2c_write_high: \n\t"
-#if I2C_DELAY_COUNTER >= 1
-     " rcall 	ass_i2c_delay_half	;delay T/2             ;;+X = 11C+X\n\t"
-#endif
-     " cbi	%[SCLDDR],%[SCLPIN]	;release SCL           ;;+2 = 13C+X\n\t"
-     " cln                              ;clear N-bit           ;;+1 = 14C+X\n\t"
-     " nop \n\t"
-     " nop \n\t"
-     " nop \n\t"
-     " sbis	%[SCLIN],%[SCLPIN]	;check for SCL high    ;;+2 = 16C+X\n\t"
-     " rcall    ass_i2c_wait_scl_high \n\t"
-     " brpl     _Ldelay_scl_high                              ;;+2 = 18C+X\n\t"
-     "_Li2c_write_return_false: \n\t"
-     " clr      r24                     ; return false because of timeout \n\t"
-     " rjmp     _Li2c_write_return \n\t"
-     "_Ldelay_scl_high: \n\t"
-#if I2C_DELAY_COUNTER >= 1
-     " rcall	ass_i2c_delay_half	;delay T/2             ;;+X= 18C+2X\n\t"
-#endif
-     " rjmp	_Li2c_write_bit \n\t"
-     "              ;; +2 = 20C +2X for one bit-loop \n\t"
-     "_Li2c_get_ack: \n\t"
-     " sbi	%[SCLDDR],%[SCLPIN]	;force SCL low ;; +2 = 5C \n\t"
-     " nop \n\t"
-     " nop \n\t"
-     " cbi	%[SDADDR],%[SDAPIN]	;release SDA ;;+2 = 7C \n\t"
-#if I2C_DELAY_COUNTER >= 1
-     " rcall	ass_i2c_delay_half	;delay T/2 ;; +X = 7C+X \n\t"
-#endif
-     " clr	r25                                            ;; 17C+2X \n\t"
-     " clr	r24		        ;return 0              ;; 14C + X \n\t"
-     " cbi	%[SCLDDR],%[SCLPIN]	;release SCL ;; +2 = 9C+X\n\t"
-     "_Li2c_ack_wait: \n\t"
-     " cln                              ; clear N-bit          ;; 10C + X\n\t" 
-     " nop \n\t"
-     " sbis	%[SCLIN],%[SCLPIN]	;wait SCL high         ;; 12C + X \n\t"
-     " rcall    ass_i2c_wait_scl_high \n\t"
-     " brmi     _Li2c_write_return_false                       ;; 13C + X \n\t "
-     " sbis	%[SDAIN],%[SDAPIN]      ;if SDA hi -> return 0 ;; 15C + X \n\t"
-     " ldi	r24,1                   ;return true           ;; 16C + X \n\t"
-#if I2C_DELAY_COUNTER >= 1
-     " rcall	ass_i2c_delay_half	;delay T/2             ;; 16C + 2X \n\t"
-#endif
-     "_Li2c_write_return: \n\t"
-     " nop \n\t "
-     " nop \n\t "
-     " sbi	%[SCLDDR],%[SCLPIN]	;force SCL low so SCL=H is short\n\t"
-     " ret \n\t"
-     "              ;; + 4 = 17C + 2X for acknowldge bit"
-     ::
-      [SCLDDR] "I"  (SCL_DDR), [SCLPIN] "I" (SCL_PIN), [SCLIN] "I" (SCL_IN),
-      [SDADDR] "I"  (SDA_DDR), [SDAPIN] "I" (SDA_PIN), [SDAIN] "I" (SDA_IN)); 
-  return true; // fooling the compiler
+#define SOFTI2C_DEFINE_READ(bus, sdaPort, sdaPin, sclPort, sclPin) \
+uint8_t bus##_read(bool last) \
+{ \
+  __asm__ __volatile__ \
+    ( \
+     " ldi	r23,0x01 \n\t" \
+     SOFTI2C_LABEL(bus, read_bit) ": \n\t" \
+     " sbi	%[SCLDDR],%[SCLPIN]	;force SCL low         ;; 2C \n\t" \
+     " cbi	%[SDADDR],%[SDAPIN]	;release SDA(prev. ACK);; 4C \n\t" \
+     " nop \n\t" \
+     " nop \n\t" \
+     " nop \n\t" \
+     SOFTI2C_DELAY(bus) /* delay T/2 ;; 4C+X */ \
+     " cbi	%[SCLDDR],%[SCLPIN]	;release SCL           ;; 6C + X \n\t" \
+     SOFTI2C_DELAY(bus) /* delay T/2 ;; 6C + 2X */ \
+     " cln                              ; clear N-bit          ;; 7C + 2X \n\t" \
+     " nop \n\t " \
+     " nop \n\t " \
+     " nop \n\t " \
+     " sbis     %[SCLIN], %[SCLPIN]     ;check for SCL high    ;; 9C +2X \n\t" \
+     SOFTI2C_CALL(bus, wait_scl_high) \
+     " brmi     " SOFTI2C_LABEL(bus, read_return) " ;return if timeout ;; 10C + 2X\n\t" \
+     " clc		  	        ;clear carry flag      ;; 11C + 2X\n\t" \
+     " sbic	%[SDAIN],%[SDAPIN]	;if SDA is high        ;; 11C + 2X\n\t" \
+     " sec			        ;set carry flag        ;; 12C + 2X\n\t" \
+     " rol	r23		        ;store bit             ;; 13C + 2X\n\t" \
+     " brcc	" SOFTI2C_LABEL(bus, read_bit) " ;while receiv reg not full \n\t" \
+     "                         ;; 15C + 2X for one bit loop \n\t" \
+     \
+     SOFTI2C_LABEL(bus, put_ack) ": \n\t" \
+     " sbi	%[SCLDDR],%[SCLPIN]	;force SCL low         ;; 2C \n\t" \
+     " cpi	r24,0                                          ;; 3C \n\t" \
+     " breq	" SOFTI2C_LABEL(bus, put_ack_low) " ;if (ack=0) ;; 5C \n\t" \
+     " cbi	%[SDADDR],%[SDAPIN]	;release SDA \n\t" \
+     " rjmp	" SOFTI2C_LABEL(bus, put_ack_high) " \n\t" \
+     SOFTI2C_LABEL(bus, put_ack_low) ":                ;else \n\t" \
+     " sbi	%[SDADDR],%[SDAPIN]	;force SDA low         ;; 7C \n\t" \
+     SOFTI2C_LABEL(bus, put_ack_high) ": \n\t" \
+     " nop \n\t " \
+     " nop \n\t " \
+     " nop \n\t " \
+     SOFTI2C_DELAY(bus) /* delay T/2 ;; 7C + X */ \
+     " cbi	%[SCLDDR],%[SCLPIN]	;release SCL           ;; 9C +X \n\t" \
+     " cln                              ;clear N               ;; +1 = 10C\n\t" \
+     " nop \n\t " \
+     " nop \n\t " \
+     " sbis	%[SCLIN],%[SCLPIN]	;wait SCL high         ;; 12C + X\n\t" \
+     SOFTI2C_CALL(bus, wait_scl_high) \
+     SOFTI2C_DELAY(bus) /* delay T/2 ;; 11C + 2X */ \
+     SOFTI2C_LABEL(bus, read_return) ": \n\t" \
+     " nop \n\t " \
+     " nop \n\t " \
+     "sbi	%[SCLDDR],%[SCLPIN]	;force SCL low so SCL=H is short\n\t" \
+     " mov	r24,r23                                        ;; 12C + 2X \n\t" \
+     " clr	r25                                            ;; 13 C + 2X\n\t" \
+     " ret                                                     ;; 17C + X" \
+     :: SOFTI2C_OPERANDS(sdaPort, sdaPin, sclPort, sclPin)); \
+  return ' '; /* fool the compiler! */ \
 }
 
-uint8_t i2c_read(bool last)
-{
-  __asm__ __volatile__ 
-    (
-     " ldi	r23,0x01 \n\t"
-     "_Li2c_read_bit: \n\t"
-     " sbi	%[SCLDDR],%[SCLPIN]	;force SCL low         ;; 2C \n\t" 
-     " cbi	%[SDADDR],%[SDAPIN]	;release SDA(prev. ACK);; 4C \n\t" 
-     " nop \n\t"
-     " nop \n\t"
-     " nop \n\t"
-#if I2C_DELAY_COUNTER >= 1
-     " rcall	ass_i2c_delay_half	;delay T/2             ;; 4C+X \n\t" 
-#endif
-     " cbi	%[SCLDDR],%[SCLPIN]	;release SCL           ;; 6C + X \n\t" 
-#if I2C_DELAY_COUNTER >= 1
-     " rcall	ass_i2c_delay_half	;delay T/2             ;; 6C + 2X \n\t" 
-#endif
-     " cln                              ; clear N-bit          ;; 7C + 2X \n\t"
-     " nop \n\t "
-     " nop \n\t "
-     " nop \n\t "
-     " sbis     %[SCLIN], %[SCLPIN]     ;check for SCL high    ;; 9C +2X \n\t" 
-     " rcall    ass_i2c_wait_scl_high \n\t"
-     " brmi     _Li2c_read_return       ;return if timeout     ;; 10C + 2X\n\t"
-     " clc		  	        ;clear carry flag      ;; 11C + 2X\n\t" 
-     " sbic	%[SDAIN],%[SDAPIN]	;if SDA is high        ;; 11C + 2X\n\t" 
-     " sec			        ;set carry flag        ;; 12C + 2X\n\t" 
-     " rol	r23		        ;store bit             ;; 13C + 2X\n\t" 
-     " brcc	_Li2c_read_bit	        ;while receiv reg not full \n\t"
-     "                         ;; 15C + 2X for one bit loop \n\t" 
-     
-     "_Li2c_put_ack: \n\t" 
-     " sbi	%[SCLDDR],%[SCLPIN]	;force SCL low         ;; 2C \n\t" 
-     " cpi	r24,0                                          ;; 3C \n\t" 
-     " breq	_Li2c_put_ack_low	;if (ack=0) ;; 5C \n\t" 
-     " cbi	%[SDADDR],%[SDAPIN]	;release SDA \n\t" 
-     " rjmp	_Li2c_put_ack_high \n\t" 
-     "_Li2c_put_ack_low:                ;else \n\t" 
-     " sbi	%[SDADDR],%[SDAPIN]	;force SDA low         ;; 7C \n\t" 
-     "_Li2c_put_ack_high: \n\t" 
-     " nop \n\t "
-     " nop \n\t "
-     " nop \n\t "
-#if I2C_DELAY_COUNTER >= 1
-     " rcall	ass_i2c_delay_half	;delay T/2             ;; 7C + X \n\t" 
-#endif
-     " cbi	%[SCLDDR],%[SCLPIN]	;release SCL           ;; 9C +X \n\t" 
-     " cln                              ;clear N               ;; +1 = 10C\n\t"
-     " nop \n\t "
-     " nop \n\t "
-     " sbis	%[SCLIN],%[SCLPIN]	;wait SCL high         ;; 12C + X\n\t" 
-     " rcall    ass_i2c_wait_scl_high \n\t"
-#if I2C_DELAY_COUNTER >= 1
-     " rcall	ass_i2c_delay_half	;delay T/2             ;; 11C + 2X\n\t" 
+// Buses configured the version 1.1 way with SDA_PIN, SDA_PORT, SCL_PIN and
+// SCL_PORT get the i2c_* functions.
+#if defined (SDA_PORT) && defined (SCL_PORT)
+SOFTI2C_BUS(i2c, SDA_PORT, SDA_PIN, SCL_PORT, SCL_PIN)
 #endif
-     "_Li2c_read_return: \n\t"
-     " nop \n\t "
-     " nop \n\t "
-     "sbi	%[SCLDDR],%[SCLPIN]	;force SCL low so SCL=H is short\n\t"
-     " mov	r24,r23                                        ;; 12C + 2X \n\t"
-     " clr	r25                                            ;; 13 C + 2X\n\t"
-     " ret                                                     ;; 17C + X"
-     ::
-      [SCLDDR] "I"  (SCL_DDR), [SCLPIN] "I" (SCL_PIN), [SCLIN] "I" (SCL_IN),
-      [SDADDR] "I"  (SDA_DDR), [SDAPIN] "I" (SDA_PIN), [SDAIN] "I" (SDA_IN) 
-     ); 
-  return ' '; // fool the compiler!
-}
 
 #else
 #error "ONLY SUPPORTED ON AVR PROCESSORS"
@@ -0,0 +1,424 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file TwiAsync.cpp
+// This file implements an interrupt driven, non blocking TWI master for AVR
+// microcontrollers.
+//
+// @brief
+// Transactions are stored in the ring buffer as the SLA byte, the length and
+// the data. The interrupt sends them back to back using repeated starts and
+// only releases the bus with a stop condition once the ring buffer is empty.
+//
+// @version API 1.0.0
+//
+// ---------------------------------------------------------------------------
+#include "TwiAsync.h"
+
+#if defined (TWI_ASYNC)
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include <util/twi.h>
+
+// CONSTANT DEFINITIONS
+// ---------------------------------------------------------------------------
+#define TWIA_RING_MASK   (TWI_ASYNC_BUFFER_SIZE - 1)
+
+// Bus state machine
+#define TWIA_IDLE        0
+#define TWIA_TX          1
+#define TWIA_RX          2
+
+// Wire compatible error codes
+#define TWIA_ERR_LENGTH  1
+#define TWIA_ERR_ADDR    2
+#define TWIA_ERR_DATA    3
+#define TWIA_ERR_OTHER   4
+
+// TWCR values
+#define TWIA_CR_START    (_BV(TWEN) | _BV(TWIE) | _BV(TWINT) | _BV(TWSTA))
+#define TWIA_CR_NEXT     (_BV(TWEN) | _BV(TWIE) | _BV(TWINT))
+#define TWIA_CR_ACK      (_BV(TWEN) | _BV(TWIE) | _BV(TWINT) | _BV(TWEA))
+#define TWIA_CR_STOP     (_BV(TWEN) | _BV(TWINT) | _BV(TWSTO))
+
+#if (TWI_ASYNC_BUFFER_SIZE & TWIA_RING_MASK) || (TWI_ASYNC_BUFFER_SIZE > 32768)
+#error "TWI_ASYNC_BUFFER_SIZE MUST BE A POWER OF 2 NO LARGER THAN 32768"
+#endif
+
+// Pins of the TWI peripheral to enable the internal pull-ups
+#if defined (__AVR_ATmega1280__) || defined (__AVR_ATmega2560__)
+#define TWIA_PORT        PORTD
+#define TWIA_SCL         0
+#define TWIA_SDA         1
+#elif defined (__AVR_ATmega32U4__)
+#define TWIA_PORT        PORTD
+#define TWIA_SCL         0
+#define TWIA_SDA         1
+#elif defined (__AVR_ATmega644P__) || defined (__AVR_ATmega1284P__)
+#define TWIA_PORT        PORTC
+#define TWIA_SCL         0
+#define TWIA_SDA         1
+#else
+#define TWIA_PORT        PORTC
+#define TWIA_SCL         5
+#define TWIA_SDA         4
+#endif
+
+TwoWireAsync WireAsync;
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+TwoWireAsync::TwoWireAsync ( )
+{
+   _head      = 0;
+   _tail      = 0;
+   _state     = TWIA_IDLE;
+   _status    = 0;
+   _remaining = 0;
+   _sla       = 0;
+   _rxLen     = 0;
+   _rxCount   = 0;
+   _rxIndex   = 0;
+   _txAddr    = 0;
+   _txLen     = 0;
+   _callback  = NULL;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void TwoWireAsync::begin ( void )
+{
+   waitIdle ( );
+
+   TWIA_PORT |= _BV(TWIA_SCL) | _BV(TWIA_SDA);
+   setClock ( TWI_ASYNC_FREQ );
+   TWCR = _BV(TWEN);
+}
+
+//
+// setClock
+void TwoWireAsync::setClock ( uint32_t freq )
+{
+   TWSR &= ~(_BV(TWPS0) | _BV(TWPS1));
+   TWBR = ((F_CPU / freq) - 16) / 2;
+}
+
+//
+// beginTransmission
+void TwoWireAsync::beginTransmission ( uint8_t address )
+{
+   _txAddr = address;
+   _txLen  = 0;
+}
+
+//
+// write
+size_t TwoWireAsync::write ( uint8_t value )
+{
+   if ( _txLen >= TWI_ASYNC_TX_LENGTH )
+   {
+      return 0;
+   }
+   _txBuf[_txLen++] = value;
+   return 1;
+}
+
+//
+// write
+size_t TwoWireAsync::write ( const uint8_t *data, size_t len )
+{
+   size_t i;
+
+   for ( i = 0; i < len; i++ )
+   {
+      if ( write ( data[i] ) == 0 )
+      {
+         break;
+      }
+   }
+   return i;
+}
+
+//
+// endTransmission
+uint8_t TwoWireAsync::endTransmission ( void )
+{
+   uint16_t head;
+   uint8_t  i;
+
+   if ( _txLen + 2 > TWIA_RING_MASK )
+   {
+      return TWIA_ERR_LENGTH;
+   }
+
+   // Wait for the interrupt to free enough room in the ring buffer
+   while ( room ( ) < (uint16_t)(_txLen + 2) )
+   {
+      if ( !(SREG & _BV(SREG_I)) && (TWCR & _BV(TWINT)) )
+      {
+         service ( );
+      }
+   }
+
+   // Store the transaction and publish it with a single write of _head
+   head = _head;
+   _ring[head] = _txAddr << 1;
+   head = (head + 1) & TWIA_RING_MASK;
+   _ring[head] = _txLen;
+   head = (head + 1) & TWIA_RING_MASK;
+   for ( i = 0; i < _txLen; i++ )
+   {
+      _ring[head] = _txBuf[i];
+      head = (head + 1) & TWIA_RING_MASK;
+   }
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+   {
+      _head = head;
+   }
+   _txLen = 0;
+
+   kick ( );
+   return 0;
+}
+
+//
+// requestFrom
+uint8_t TwoWireAsync::requestFrom ( uint8_t address, uint8_t quantity )
+{
+   if ( quantity > TWI_ASYNC_TX_LENGTH )
+   {
+      quantity = TWI_ASYNC_TX_LENGTH;
+   }
+
+   waitIdle ( );
+
+   _rxIndex = 0;
+   _rxCount = 0;
+   if ( quantity == 0 )
+   {
+      return 0;
+   }
+
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+   {
+      while ( TWCR & _BV(TWSTO) );
+      _sla   = (address << 1) | TW_READ;
+      _rxLen = quantity;
+      _state = TWIA_RX;
+      TWCR   = TWIA_CR_START;
+   }
+
+   waitIdle ( );
+   return _rxCount;
+}
+
+//
+// read
+int TwoWireAsync::read ( void )
+{
+   if ( _rxIndex < _rxCount )
+   {
+      return _rxBuf[_rxIndex++];
+   }
+   return -1;
+}
+
+//
+// available
+int TwoWireAsync::available ( void )
+{
+   return _rxCount - _rxIndex;
+}
+
+//
+// busy
+bool TwoWireAsync::busy ( void )
+{
+   bool busy;
+
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+   {
+      busy = ( _state != TWIA_IDLE ) || ( _head != _tail );
+   }
+   return busy;
+}
+
+//
+// flush
+uint8_t TwoWireAsync::flush ( void )
+{
+   uint8_t status;
+
+   waitIdle ( );
+   status  = _status;
+   _status = 0;
+   return status;
+}
+
+//
+// onFlushDone
+void TwoWireAsync::onFlushDone ( t_twiFlushDone callback )
+{
+   _callback = callback;
+}
+
+//
+// service
+void TwoWireAsync::service ( void )
+{
+   uint16_t tail = _tail;
+   bool     done = false;
+
+   switch ( TW_STATUS )
+   {
+      case TW_START:
+      case TW_REP_START:
+         if ( _state == TWIA_RX )
+         {
+            TWDR = _sla;
+         }
+         else
+         {
+            _sla       = _ring[tail];
+            tail       = (tail + 1) & TWIA_RING_MASK;
+            _remaining = _ring[tail];
+            _tail      = (tail + 1) & TWIA_RING_MASK;
+            TWDR       = _sla;
+         }
+         TWCR = TWIA_CR_NEXT;
+         break;
+
+      case TW_MT_SLA_NACK:
+      case TW_MT_DATA_NACK:
+         _status = ( TW_STATUS == TW_MT_SLA_NACK ) ? TWIA_ERR_ADDR
+                                                   : TWIA_ERR_DATA;
+         // Drop the rest of the transaction
+         _tail = (tail + _remaining) & TWIA_RING_MASK;
+         _remaining = 0;
+         // fall through
+      case TW_MT_SLA_ACK:
+      case TW_MT_DATA_ACK:
+         if ( _remaining )
+         {
+            TWDR  = _ring[_tail];
+            _tail = (_tail + 1) & TWIA_RING_MASK;
+            _remaining--;
+            TWCR  = TWIA_CR_NEXT;
+         }
+         else if ( _head != _tail )
+         {
+            // Next transaction without releasing the bus
+            TWCR = TWIA_CR_START;
+         }
+         else
+         {
+            done = true;
+         }
+         break;
+
+      case TW_MR_DATA_ACK:
+      case TW_MR_DATA_NACK:
+         _rxBuf[_rxCount++] = TWDR;
+         _rxLen--;
+         if ( TW_STATUS == TW_MR_DATA_NACK )
+         {
+            done = true;
+            break;
+         }
+         // fall through
+      case TW_MR_SLA_ACK:
+         // Acknowledge all but the last byte
+         TWCR = ( _rxLen > 1 ) ? TWIA_CR_ACK : TWIA_CR_NEXT;
+         break;
+
+      case TW_MR_SLA_NACK:
+         _status = TWIA_ERR_ADDR;
+         done = true;
+         break;
+
+      default:
+         // Arbitration lost or bus error, drop what is pending
+         _status = TWIA_ERR_OTHER;
+         _tail = _head;
+         _remaining = 0;
+         done = true;
+         break;
+   }
+
+   if ( done )
+   {
+      TWCR   = TWIA_CR_STOP;
+      done   = ( _state == TWIA_TX );
+      _state = TWIA_IDLE;
+      if ( done && ( _callback != NULL ) )
+      {
+         _callback ( _status );
+      }
+   }
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// room
+uint16_t TwoWireAsync::room ( void )
+{
+   uint16_t tail;
+
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+   {
+      tail = _tail;
+   }
+   return TWIA_RING_MASK - ((_head - tail) & TWIA_RING_MASK);
+}
+
+//
+// kick
+void TwoWireAsync::kick ( void )
+{
+   ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+   {
+      if ( _state == TWIA_IDLE )
+      {
+         // Previous stop condition must have been sent
+         while ( TWCR & _BV(TWSTO) );
+         _state = TWIA_TX;
+         TWCR   = TWIA_CR_START;
+      }
+   }
+}
+
+//
+// waitIdle
+void TwoWireAsync::waitIdle ( void )
+{
+   while ( busy ( ) )
+   {
+      if ( !(SREG & _BV(SREG_I)) && (TWCR & _BV(TWINT)) )
+      {
+         service ( );
+      }
+   }
+}
+
+// INTERRUPT SERVICE ROUTINE
+// ---------------------------------------------------------------------------
+ISR(TWI_vect)
+{
+   WireAsync.service ( );
+}
+
+#endif // defined (TWI_ASYNC)
@@ -0,0 +1,264 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file TwiAsync.h
+// This file implements an interrupt driven, non blocking TWI master for AVR
+// microcontrollers.
+//
+// @brief
+// Implements a minimal Wire compatible TWI master that queues complete
+// write transactions in a ring buffer and drains them from the TWI interrupt.
+// endTransmission returns as soon as the transaction has been queued, freeing
+// the CPU while the TWI peripheral clocks the bytes out. Reads are performed
+// synchronously once the queue has been drained.
+//
+// The transport is only used when TWI_ASYNC is defined below. When enabled,
+// the I2C drivers of this library use it in place of the Wire library
+// (TwoWire owns the same TWI interrupt vector). Therefore, sketches must not
+// include Wire.h or use the Wire library when TWI_ASYNC is defined.
+//
+// @version API 1.0.0
+//
+// ---------------------------------------------------------------------------
+#ifndef _TWI_ASYNC_H_
+#define _TWI_ASYNC_H_
+
+/*!
+ @defined
+ @abstract   Enables the interrupt driven TWI transport.
+ @discussion If defined, the I2C drivers of the library will queue their
+ transactions and return immediately instead of blocking until the bytes have
+ been clocked out. Uncomment this line to use it, the Wire library must not be
+ used by the sketch in this mode.
+ */
+//#define TWI_ASYNC
+
+#include <inttypes.h>
+
+/*!
+ @typedef
+ @abstract   Flush done callback.
+ @discussion Called from the TWI interrupt when the last queued transaction
+ has been sent. status is 0 if all the transactions since the previous flush
+ have been acknowledged, or the Wire error code of the last failure otherwise
+ (2: address NACK, 3: data NACK, 4: other error).
+ */
+typedef void (*t_twiFlushDone)( uint8_t status );
+
+#if defined (TWI_ASYNC)
+
+#if !defined (__AVR__)
+#error "TWI_ASYNC IS ONLY SUPPORTED ON AVR PROCESSORS"
+#endif
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+/*!
+ @defined
+ @abstract   Size of the transaction ring buffer.
+ @discussion Size in bytes of the ring buffer holding the queued transactions.
+ Each transaction takes its length plus two bytes of the buffer. Must be a
+ power of 2 no larger than 32768.
+
+ A LiquidCrystal_I2C character is one transaction of 6 bytes, the default
+ holds a full 20x4 redraw (80 characters and 4 set cursor commands, 504 bytes)
+ so that it is queued without waiting on the bus. Once the ring is full,
+ endTransmission blocks until the interrupt has freed enough room: define a
+ smaller size before including the library to save RAM at the cost of
+ blocking on larger updates.
+ */
+#ifndef TWI_ASYNC_BUFFER_SIZE
+#define TWI_ASYNC_BUFFER_SIZE  512
+#endif
+
+/*!
+ @defined
+ @abstract   Maximum length of a single transaction.
+ @discussion Same limit as the Wire library transmit buffer.
+ */
+#define TWI_ASYNC_TX_LENGTH    32
+
+/*!
+ @defined
+ @abstract   Default TWI bus frequency in Hz.
+ */
+#define TWI_ASYNC_FREQ         100000L
+
+/*!
+ @class
+ @abstract    TwoWireAsync
+ @discussion  Interrupt driven TWI master exposing the subset of the Wire
+ interface used by the library plus methods to query and wait for the
+ transmit queue.
+ */
+class TwoWireAsync
+{
+public:
+   /*!
+    @method
+    @abstract   Constructor method
+    @discussion Class constructor.
+    */
+   TwoWireAsync ( );
+
+   /*!
+    @method
+    @abstract   Initializes the TWI peripheral.
+    @discussion Enables the internal pull-ups of SDA and SCL and configures the
+    bus at TWI_ASYNC_FREQ. Calling it while transactions are queued waits for
+    them to complete.
+    */
+   void begin ( void );
+
+   /*!
+    @method
+    @abstract   Sets the bus frequency.
+    @param      freq[in] bus frequency in Hz.
+    */
+   void setClock ( uint32_t freq );
+
+   /*!
+    @method
+    @abstract   Starts staging a write transaction.
+    @param      address[in] 7 bit I2C address of the slave.
+    */
+   void beginTransmission ( uint8_t address );
+
+   /*!
+    @method
+    @abstract   Adds a byte to the staged transaction.
+    @result     1 if the byte has been staged, 0 if the transaction is full.
+    */
+   size_t write ( uint8_t value );
+
+   /*!
+    @method
+    @abstract   Adds a set of bytes to the staged transaction.
+    @result     number of bytes staged.
+    */
+   size_t write ( const uint8_t *data, size_t len );
+
+   /*!
+    @method
+    @abstract   Queues the staged transaction.
+    @discussion Copies the staged transaction into the ring buffer and starts
+    the bus if it was idle. If the ring buffer is full it waits for enough room
+    to be freed by the interrupt.
+    @result     0 if the transaction has been queued, 1 if it was too long.
+    Acknowledge errors are reported by flush and the flush done callback.
+    */
+   uint8_t endTransmission ( void );
+
+   /*!
+    @method
+    @abstract   Reads bytes from a slave.
+    @discussion Waits for the transmit queue to drain and reads quantity bytes
+    from the slave. This call blocks until the read has completed.
+    @result     number of bytes read.
+    */
+   uint8_t requestFrom ( uint8_t address, uint8_t quantity );
+
+   /*!
+    @method
+    @abstract   Returns the next byte read by requestFrom.
+    @result     byte read or -1 if there are no more bytes available.
+    */
+   int read ( void );
+
+   /*!
+    @method
+    @abstract   Number of bytes read by requestFrom still available.
+    */
+   int available ( void );
+
+   /*!
+    @method
+    @abstract   Checks if there is bus activity pending.
+    @result     true while there are transactions queued or being sent.
+    */
+   bool busy ( void );
+
+   /*!
+    @method
+    @abstract   Waits for all the queued transactions to be sent.
+    @result     0 if all the transactions since the last flush succeeded,
+    Wire error code of the last failure otherwise.
+    */
+   uint8_t flush ( void );
+
+   /*!
+    @method
+    @abstract   Sets the callback called when the queue has drained.
+    @discussion The callback executes in interrupt context and must be short.
+    @param      callback[in] function to call, NULL to disable it.
+    */
+   void onFlushDone ( t_twiFlushDone callback );
+
+   /*!
+    @method
+    @abstract   TWI interrupt service.
+    @discussion Advances the TWI state machine. Called from the TWI interrupt,
+    users should never call this method.
+    */
+   void service ( void );
+
+#if (ARDUINO <  100)
+   size_t send ( uint8_t value ) { return write ( value ); }
+   int receive ( void ) { return read ( ); }
+#endif
+
+private:
+   /*!
+    @method
+    @abstract   Issues a start condition if the bus is idle.
+    */
+   void kick ( void );
+
+   /*!
+    @method
+    @abstract   Free bytes in the ring buffer.
+    @discussion Reads the interrupt owned index atomically.
+    */
+   uint16_t room ( void );
+
+   /*!
+    @method
+    @abstract   Waits until the bus is idle.
+    @discussion If interrupts are disabled the state machine is polled, so
+    that the queue drains even from within a critical section.
+    */
+   void waitIdle ( void );
+
+   uint8_t _ring[TWI_ASYNC_BUFFER_SIZE]; // Queued transactions: SLA, len, data
+   volatile uint16_t _head;              // Ring write index
+   volatile uint16_t _tail;              // Ring read index
+   volatile uint8_t _state;              // State of the bus state machine
+   volatile uint8_t _status;             // Last error since last flush
+   volatile uint8_t _remaining;          // Bytes left in current transaction
+   volatile uint8_t _sla;                // Address of current transaction
+   volatile uint8_t _rxLen;              // Bytes left to read
+   uint8_t _rxBuf[TWI_ASYNC_TX_LENGTH];  // Read buffer
+   volatile uint8_t _rxCount;            // Bytes stored in the read buffer
+   uint8_t _rxIndex;                     // Read index of the read buffer
+   uint8_t _txAddr;                      // Staged transaction address
+   uint8_t _txLen;                       // Staged transaction length
+   uint8_t _txBuf[TWI_ASYNC_TX_LENGTH];  // Staged transaction
+   t_twiFlushDone _callback;             // Flush done callback
+};
+
+extern TwoWireAsync WireAsync;
+
+#endif // defined (TWI_ASYNC)
+
+#endif // _TWI_ASYNC_H_
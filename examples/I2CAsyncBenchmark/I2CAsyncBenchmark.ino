@@ -0,0 +1,101 @@
+// ---------------------------------------------------------------------------
+// I2CAsyncBenchmark
+//
+// Measures how long a full redraw of an I2C LCD keeps the CPU busy (CPU time)
+// against the time it takes the display to actually be updated (frame time).
+//
+// In blocking mode both times are the same since every write waits for the
+// TWI peripheral. Defining TWI_ASYNC in TwiAsync.h queues the writes and drains
+// them from the TWI interrupt, the CPU time then only accounts for building
+// and queueing the expander words. The CPU time saved is the part of the frame
+// time the CPU is free for other work: about 0 in blocking mode and most of the
+// frame with the default TWI_ASYNC_BUFFER_SIZE, which holds a whole 20x4
+// frame. Run the sketch once in each mode to compare them.
+//
+// Results are printed on the serial port.
+// ---------------------------------------------------------------------------
+#include <TwiAsync.h>
+#if !defined (TWI_ASYNC)
+#include <Wire.h>
+#endif
+#include <LiquidCrystal_I2C.h>
+
+#define LCD_COLS   20
+#define LCD_ROWS   4
+#define ITERATIONS 10
+
+// Set the pins on the I2C chip used for LCD connections:
+//                    addr, en,rw,rs,d4,d5,d6,d7,bl,blpol
+LiquidCrystal_I2C lcd(0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE);
+
+volatile unsigned long flushedAt;
+
+// Called from the TWI interrupt once the queued writes have been sent
+void frameDone ( uint8_t status )
+{
+   flushedAt = micros ( );
+}
+
+// Redraws the whole display with the same character
+void drawFrame ( char c )
+{
+   for ( uint8_t row = 0; row < LCD_ROWS; row++ )
+   {
+      lcd.setCursor ( 0, row );
+      for ( uint8_t col = 0; col < LCD_COLS; col++ )
+      {
+         lcd.write ( c );
+      }
+   }
+}
+
+void setup()
+{
+   Serial.begin ( 57600 );
+   lcd.begin ( LCD_COLS, LCD_ROWS );
+   lcd.onFlushDone ( frameDone );
+   lcd.flush ( );
+
+#if defined (TWI_ASYNC)
+   Serial.println ( F("Interrupt driven transport") );
+#else
+   Serial.println ( F("Blocking transport") );
+#endif
+}
+
+void loop()
+{
+   unsigned long start;
+   unsigned long cpuTime   = 0;
+   unsigned long frameTime = 0;
+
+   for ( uint8_t i = 0; i < ITERATIONS; i++ )
+   {
+      flushedAt = 0;
+      start = micros ( );
+      drawFrame ( '0' + i );
+      cpuTime += micros ( ) - start;
+
+      // The CPU would be free to do other work from here on
+      while ( lcd.busy ( ) );
+      frameTime += ( flushedAt ? flushedAt : micros ( ) ) - start;
+   }
+
+   cpuTime   /= ITERATIONS;
+   frameTime /= ITERATIONS;
+
+   Serial.print ( LCD_COLS );
+   Serial.print ( 'x' );
+   Serial.print ( LCD_ROWS );
+   Serial.print ( F(" frame - CPU time: ") );
+   Serial.print ( cpuTime );
+   Serial.print ( F(" us - frame time: ") );
+   Serial.print ( frameTime );
+   Serial.print ( F(" us - CPU time saved: ") );
+   Serial.print ( frameTime > cpuTime ? frameTime - cpuTime : 0 );
+   Serial.print ( F(" us (") );
+   Serial.print ( frameTime > cpuTime ? ( frameTime - cpuTime ) * 100 / frameTime : 0 );
+   Serial.println ( F("%)") );
+
+   delay ( 1000 );
+}
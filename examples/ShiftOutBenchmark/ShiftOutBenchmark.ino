@@ -0,0 +1,99 @@
+// ---------------------------------------------------------------------------
+// ShiftOutBenchmark
+//
+// Measures the CPU cycles needed to shift out a byte with:
+//  - Arduino's shiftOut
+//  - the previous fio_shiftOut, one critical section per bit and the bit
+//    order tested at runtime (reproduced below as shiftOutPerBit)
+//  - the unrolled fio_shiftOut<MSBFIRST> used by the shift register drivers
+//
+// Connect nothing or a shift register to the data and clock pins, results
+// are printed on the serial port.
+// ---------------------------------------------------------------------------
+#include <FastIO.h>
+
+#define DATA_PIN   2
+#define CLOCK_PIN  3
+#define ITERATIONS 1000
+
+#define CYCLES_PER_US  ( F_CPU / 1000000L )
+
+fio_register dataRegister;
+fio_bit      dataBit;
+fio_register clockRegister;
+fio_bit      clockBit;
+
+// fio_shiftOut as it was before the unrolled version
+void shiftOutPerBit ( fio_register dataRegister, fio_bit dataBit,
+                      fio_register clockRegister, fio_bit clockBit,
+                      uint8_t value, uint8_t bitOrder )
+{
+   for ( int8_t i = 0; i < 8; i++ )
+   {
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+      {
+         if ( value & ( ( bitOrder == LSBFIRST ) ? 0x01 : 0x80 ) )
+         {
+            fio_digitalWrite_HIGH ( dataRegister, dataBit );
+         }
+         else
+         {
+            fio_digitalWrite_LOW ( dataRegister, dataBit );
+         }
+         if ( bitOrder == LSBFIRST ) value >>= 1; else value <<= 1;
+         fio_digitalWrite_HIGH ( clockRegister, clockBit );
+         fio_digitalWrite_LOW ( clockRegister, clockBit );
+      }
+   }
+}
+
+void printResult ( const __FlashStringHelper *name, unsigned long time )
+{
+   Serial.print ( name );
+   Serial.print ( time * CYCLES_PER_US / ITERATIONS );
+   Serial.println ( F(" cycles/byte") );
+}
+
+void setup()
+{
+   Serial.begin ( 57600 );
+   dataRegister  = fio_pinToOutputRegister ( DATA_PIN );
+   dataBit       = fio_pinToBit ( DATA_PIN );
+   clockRegister = fio_pinToOutputRegister ( CLOCK_PIN );
+   clockBit      = fio_pinToBit ( CLOCK_PIN );
+}
+
+void loop()
+{
+   unsigned long start;
+   unsigned long elapsed;
+
+   start = micros ( );
+   for ( int i = 0; i < ITERATIONS; i++ )
+   {
+      shiftOut ( DATA_PIN, CLOCK_PIN, MSBFIRST, (uint8_t)i );
+   }
+   elapsed = micros ( ) - start;
+   printResult ( F("shiftOut:                 "), elapsed );
+
+   start = micros ( );
+   for ( int i = 0; i < ITERATIONS; i++ )
+   {
+      shiftOutPerBit ( dataRegister, dataBit, clockRegister, clockBit,
+                       (uint8_t)i, MSBFIRST );
+   }
+   elapsed = micros ( ) - start;
+   printResult ( F("fio_shiftOut per bit:     "), elapsed );
+
+   start = micros ( );
+   for ( int i = 0; i < ITERATIONS; i++ )
+   {
+      fio_shiftOut<MSBFIRST> ( dataRegister, dataBit, clockRegister, clockBit,
+                               (uint8_t)i );
+   }
+   elapsed = micros ( ) - start;
+   printResult ( F("fio_shiftOut<MSBFIRST>:   "), elapsed );
+
+   Serial.println ( );
+   delay ( 2000 );
+}
@@ -26,12 +26,23 @@
 #include <Wire.h>
 
 //#define _LCD_I2C_
+//#define _LCD_I2C_MCP23008_
+//#define _LCD_I2C_MCP23017_
 #define _LCD_SI2C_
+//#define _LCD_SR1_
 
 #ifdef _LCD_I2C_
 #include <LiquidCrystal_I2C.h>
 #endif
 
+#ifdef _LCD_I2C_MCP23008_
+#include <LiquidCrystal_I2C_MCP23008.h>
+#endif
+
+#ifdef _LCD_I2C_MCP23017_
+#include <LiquidCrystal_I2C_MCP23017.h>
+#endif
+
 #ifdef _LCD_SI2C_
 #include <LiquidCrystal_SI2C.h>
 #endif
@@ -79,6 +90,14 @@ extern void *__brkval;
  */
 #define ITERATIONS    10
 
+/*!
+ @defined    CYCLES_PER_US
+ @abstract   CPU cycles per microsecond.
+ @discussion Used to report the cost of each write in CPU cycles, comparable
+ between boards running at different clock speeds.
+ */
+#define CYCLES_PER_US  ( F_CPU / 1000000L )
+
 /*!
  @defined    LCD_ROWS
  @abstract   LCD rows
@@ -98,7 +117,19 @@ extern void *__brkval;
  @abstract   Define several constants required to manage the LCD backlight and contrast
  */
 #ifdef _LCD_I2C_
-const int   BACKLIGHT_PIN  = 12;
+const int   BACKLIGHT_PIN  = 3;
+const int   CONTRAST_PIN  = 0; // none
+const int   CONTRAST      = 0; // none
+#endif
+
+#ifdef _LCD_I2C_MCP23008_
+const int   BACKLIGHT_PIN  = 7;
+const int   CONTRAST_PIN  = 0; // none
+const int   CONTRAST      = 0; // none
+#endif
+
+#ifdef _LCD_I2C_MCP23017_
+const int   BACKLIGHT_PIN  = 3;
 const int   CONTRAST_PIN  = 0; // none
 const int   CONTRAST      = 0; // none
 #endif
@@ -173,6 +204,14 @@ typedef struct
 LiquidCrystal_I2C lcd(0x38);  // set the LCD address to 0x20 for a 16 chars and 2 line display
 #endif
 
+#ifdef _LCD_I2C_MCP23008_
+LiquidCrystal_I2C_MCP23008 lcd(0x20);  // Adafruit I2C/SPI backpack default address
+#endif
+
+#ifdef _LCD_I2C_MCP23017_
+LiquidCrystal_I2C_MCP23017 lcd(0x20);
+#endif
+
 #ifdef _LCD_SI2C_
 LiquidCrystal_SI2C	lcd(0x4e,2,1,0,4,5,6,7);
 #endif
@@ -267,7 +306,7 @@ static void LCDSetup ( uint8_t contrasPin, uint8_t backlight, uint8_t cols, uint
    }*/
    
    lcd.begin ( cols, rows );
-   lcd.setBacklightPin(3, POSITIVE);
+   lcd.setBacklightPin(backlight, POSITIVE);
   lcd.setBacklight(HIGH);
    lcd.clear ( );
 }
@@ -489,9 +528,15 @@ void loop ()
       Serial.print ( F(" us - ") );
       Serial.print ( F(" write: ") );
       Serial.print ( myBenchMarks[i].benchTime / (float)myBenchMarks[i].numWrites );
-      Serial.println ( F(" us") );
+      Serial.print ( F(" us - ") );
+      Serial.print ( myBenchMarks[i].benchTime * CYCLES_PER_US / 
+                     myBenchMarks[i].numWrites );
+      Serial.println ( F(" cycles/write") );
       fAllWrites += myBenchMarks[i].benchTime / (float)myBenchMarks[i].numWrites;
    }
    Serial.print( F("avg. write: ") );
-   Serial.println( fAllWrites / (float)NUM_BENCHMARKS );
+   Serial.print( fAllWrites / (float)NUM_BENCHMARKS );
+   Serial.print( F(" us - ") );
+   Serial.print( (long)(fAllWrites * CYCLES_PER_US / NUM_BENCHMARKS) );
+   Serial.println( F(" cycles") );
  }
\ No newline at end of file
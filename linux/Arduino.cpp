@@ -0,0 +1,86 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file Arduino.cpp
+// Minimal Arduino core for the Linux host build of the library.
+//
+// @brief
+// Timing functions on the monotonic clock. @see Arduino.h.
+//
+// ---------------------------------------------------------------------------
+#include <time.h>
+#include <errno.h>
+
+#include "Arduino.h"
+
+// STATIC helper functions
+// ---------------------------------------------------------------------------
+
+//
+// now - monotonic time in microseconds
+static uint64_t now ( void )
+{
+   struct timespec ts;
+
+   clock_gettime ( CLOCK_MONOTONIC, &ts );
+   return ( (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 );
+}
+
+//
+// start - time of the first call, Arduino timers start at 0
+static uint64_t start ( void )
+{
+   static uint64_t origin = now ( );
+
+   return ( origin );
+}
+
+// PUBLIC FUNCTIONS
+// ---------------------------------------------------------------------------
+
+//
+// delay
+void delay ( unsigned long ms )
+{
+   struct timespec ts;
+
+   ts.tv_sec  = ms / 1000;
+   ts.tv_nsec = ( ms % 1000 ) * 1000000L;
+   while ( ( nanosleep ( &ts, &ts ) != 0 ) && ( errno == EINTR ) );
+}
+
+//
+// delayMicroseconds
+void delayMicroseconds ( unsigned int us )
+{
+   struct timespec ts;
+
+   ts.tv_sec  = us / 1000000;
+   ts.tv_nsec = ( us % 1000000 ) * 1000L;
+   while ( ( nanosleep ( &ts, &ts ) != 0 ) && ( errno == EINTR ) );
+}
+
+//
+// millis
+unsigned long millis ( void )
+{
+   uint64_t origin = start ( );
+
+   return ( (unsigned long)( ( now ( ) - origin ) / 1000 ) );
+}
+
+//
+// micros
+unsigned long micros ( void )
+{
+   uint64_t origin = start ( );
+
+   return ( (unsigned long)( now ( ) - origin ) );
+}
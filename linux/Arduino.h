@@ -0,0 +1,70 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file Arduino.h
+// Minimal Arduino core for the Linux host build of the library.
+//
+// @brief
+// Provides the types, constants and timing functions used by LCD, I2CIO and
+// LiquidCrystal_I2C so that they build unchanged on Linux, with the I2C bus
+// reached through i2c-dev (@see Wire.h). ARDUINO has to be defined by the
+// compiler flags (the library tests it before including this file).
+//
+// ---------------------------------------------------------------------------
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "Print.h"
+
+#define HIGH           0x1
+#define LOW            0x0
+
+#define INPUT          0x0
+#define OUTPUT         0x1
+#define INPUT_PULLUP   0x2
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+// No separate program memory on the host
+#define PROGMEM
+#define pgm_read_byte(p)       (*(const uint8_t *)(p))
+#define pgm_read_byte_near(p)  (*(const uint8_t *)(p))
+
+/*!
+ @function
+ @abstract   Waits for a number of milliseconds.
+ */
+void delay ( unsigned long ms );
+
+/*!
+ @function
+ @abstract   Waits for a number of microseconds.
+ @discussion The wait can be longer than asked for, it is never shorter.
+ */
+void delayMicroseconds ( unsigned int us );
+
+/*!
+ @function
+ @abstract   Milliseconds since the first call to a timing function.
+ */
+unsigned long millis ( void );
+
+/*!
+ @function
+ @abstract   Microseconds since the first call to a timing function.
+ */
+unsigned long micros ( void );
+
+#endif
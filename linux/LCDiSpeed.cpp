@@ -0,0 +1,89 @@
+// ---------------------------------------------------------------------------
+// LCDiSpeed - LCD Interface Speed, Linux host version
+//
+// Runs the frames per second test of the LCDiSpeed sketch on a PCF8574
+// backpack behind a Linux I2C bus and prints the results in the format of
+// examples/LCDiSpeed/LCDiSpeed.txt: average byte transfer time (set cursor
+// commands included), 16x2 frames per second and 16x2 frame time.
+//
+// usage: LCDiSpeed [device [address]]
+//    LCDiSpeed /dev/i2c-1 0x27
+//
+// i2c-stub can stand in for the display:
+//    modprobe i2c-stub chip_addr=0x27
+//    LCDiSpeed /dev/i2c-N 0x27      (N: bus of "SMBus stub driver")
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "LiquidCrystal_I2C.h"
+
+#define LCD_COLS  16
+#define LCD_ROWS  2
+#define FPS_iter  1
+
+#define iLCD_ROWS 2  // independent FPS row size
+#define iLCD_COLS 16 // independent FPS col size
+
+//
+// timeFPS - 10 frames, one per digit, as the LCDiSpeed sketch
+static unsigned long timeFPS ( LCD &lcd, uint8_t iter, uint8_t cols, uint8_t rows )
+{
+   unsigned long stime = micros ( );
+
+   for ( char c = '9'; c >= '0'; c-- )
+   {
+      for ( uint8_t i = 0; i < iter; i++ )
+      {
+         for ( uint8_t row = 0; row < rows; row++ )
+         {
+            lcd.setCursor ( 0, row );
+            for ( uint8_t col = 0; col < cols; col++ )
+            {
+               lcd.write ( c );
+            }
+         }
+      }
+   }
+   return ( micros ( ) - stime );
+}
+
+int main ( int argc, char *argv[] )
+{
+   const char *device = ( argc > 1 ) ? argv[1] : LINUX_I2C_DEVICE;
+   uint8_t addr = ( argc > 2 ) ? (uint8_t)strtoul ( argv[2], NULL, 0 ) : 0x27;
+   unsigned long etime;
+
+   //                    addr, en,rw,rs,d4,d5,d6,d7,bl,blpol
+   LiquidCrystal_I2C lcd ( addr, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE );
+
+   // Make sure that the display answers before timing it
+   Wire.setDevice ( device );
+   Wire.begin ( );
+   Wire.beginTransmission ( addr );
+   if ( Wire.endTransmission ( ) != 0 )
+   {
+      fprintf ( stderr, "No device at 0x%02X on %s\n", addr, device );
+      return ( 1 );
+   }
+
+   lcd.begin ( LCD_COLS, LCD_ROWS );
+   lcd.clear ( );
+
+   etime = timeFPS ( lcd, FPS_iter, LCD_COLS, LCD_ROWS );
+
+   // Scale to the independent 16x2 display size
+   etime = etime * iLCD_ROWS * iLCD_COLS / LCD_ROWS / LCD_COLS;
+
+   printf ( "Linux i2c-dev %s 0x%02X\n", device, addr );
+   printf ( "Interface    ByteXfer    %dx%dFPS      Ftime\n", iLCD_COLS, iLCD_ROWS );
+   printf ( "----------------------------------------------\n" );
+   printf ( "%-4s%13duS%13.2f%10.2fms\n", "I2C",
+            (int)( etime / ( FPS_iter * ( 10.0 * ( iLCD_COLS * iLCD_ROWS + iLCD_ROWS ) ) ) + 0.5 ),
+            ( 10.0 * FPS_iter ) * 1000000.0 / etime,
+            etime / 10.0 / FPS_iter / 1000 );
+
+   return ( 0 );
+}
@@ -0,0 +1,267 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_GPIOChip.cpp
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK for the Linux host build, using the parallel port of
+// the LCD on GPIO character device lines.
+//
+// @brief
+// @see LiquidCrystal_GPIOChip.h.
+//
+// ---------------------------------------------------------------------------
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#include <Arduino.h>
+#include "LiquidCrystal_GPIOChip.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// Bits of the lines in the request
+#define RS_BIT          ( (uint64_t)1 << 0 )
+#define EN_BIT          ( (uint64_t)1 << 1 )
+#define DATA_SHIFT      2
+
+// STATIC helper functions
+// ---------------------------------------------------------------------------
+
+//
+// now - monotonic time in nanoseconds, from the vDSO (no system call)
+static uint64_t now ( void )
+{
+   struct timespec ts;
+
+   clock_gettime ( CLOCK_MONOTONIC, &ts );
+   return ( (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec );
+}
+
+//
+// waitUntil - spin until a point in time, the waits are too short to sleep
+static void waitUntil ( uint64_t deadline )
+{
+   while ( now ( ) < deadline );
+}
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_GPIOChip::LiquidCrystal_GPIOChip ( const char *chip, uint32_t rs,
+                                                 uint32_t enable,
+                                                 uint32_t d0, uint32_t d1,
+                                                 uint32_t d2, uint32_t d3,
+                                                 uint32_t d4, uint32_t d5,
+                                                 uint32_t d6, uint32_t d7 )
+{
+   init ( chip, 8, rs, enable, d0, d1, d2, d3, d4, d5, d6, d7 );
+}
+
+LiquidCrystal_GPIOChip::LiquidCrystal_GPIOChip ( const char *chip, uint32_t rs,
+                                                 uint32_t enable,
+                                                 uint32_t d0, uint32_t d1,
+                                                 uint32_t d2, uint32_t d3 )
+{
+   init ( chip, 4, rs, enable, d0, d1, d2, d3, 0, 0, 0, 0 );
+}
+
+LiquidCrystal_GPIOChip::~LiquidCrystal_GPIOChip ( )
+{
+   if ( _lineFd >= 0 )
+   {
+      close ( _lineFd );
+   }
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_GPIOChip::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   if ( _lineFd < 0 )
+   {
+      struct gpio_v2_line_request req;
+      int chipFd = open ( _chip, O_RDWR | O_CLOEXEC );
+
+      if ( chipFd < 0 )
+      {
+         return;
+      }
+
+      // All the lines in one request, outputs driven low
+      // ----------------------------------------------------------------------
+      memset ( &req, 0, sizeof ( req ) );
+      memcpy ( req.offsets, _offsets, _numLines * sizeof ( _offsets[0] ) );
+      strncpy ( req.consumer, GPIOCHIP_CONSUMER, sizeof ( req.consumer ) - 1 );
+      req.num_lines = _numLines;
+      req.config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+      req.config.num_attrs = 1;
+      req.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+      req.config.attrs[0].attr.values = 0;
+      req.config.attrs[0].mask = ( (uint64_t)1 << _numLines ) - 1;
+
+      if ( ioctl ( chipFd, GPIO_V2_GET_LINE_IOCTL, &req ) == 0 )
+      {
+         _lineFd = req.fd;
+      }
+      close ( chipFd );
+
+      _rs = 0;
+      _nextEnable = now ( );
+   }
+
+   LCD::begin ( cols, lines, dotsize );
+}
+
+//
+// setBacklightPin
+void LiquidCrystal_GPIOChip::setBacklightPin ( uint8_t value, t_backlighPol pol )
+{
+   // Only before the lines have been requested
+   if ( ( _lineFd < 0 ) && ( _blBit == 0 ) )
+   {
+      _offsets[_numLines] = value;
+      _blBit = ( (uint64_t)1 << _numLines );
+      _numLines++;
+   }
+   _polarity = pol;
+}
+
+//
+// setBacklight
+void LiquidCrystal_GPIOChip::setBacklight ( uint8_t value )
+{
+   if ( ( _blBit != 0 ) && ( _lineFd >= 0 ) )
+   {
+      bool on = ( ( value > 0 ) && ( _polarity == POSITIVE ) ) ||
+                ( ( value == 0 ) && ( _polarity == NEGATIVE ) );
+
+      setLines ( on ? _blBit : 0, _blBit );
+   }
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// init
+void LiquidCrystal_GPIOChip::init ( const char *chip, uint8_t dataLines,
+                                    uint32_t rs, uint32_t enable,
+                                    uint32_t d0, uint32_t d1, uint32_t d2, uint32_t d3,
+                                    uint32_t d4, uint32_t d5, uint32_t d6, uint32_t d7 )
+{
+   _chip       = chip;
+   _lineFd     = -1;
+   _dataLines  = dataLines;
+   _blBit      = 0;
+   _rs         = 0;
+   _nextEnable = 0;
+
+   _offsets[0] = rs;
+   _offsets[1] = enable;
+   _offsets[2] = d0;
+   _offsets[3] = d1;
+   _offsets[4] = d2;
+   _offsets[5] = d3;
+   _offsets[6] = d4;
+   _offsets[7] = d5;
+   _offsets[8] = d6;
+   _offsets[9] = d7;
+   _numLines   = DATA_SHIFT + dataLines;
+
+   // Initialise displaymode functions to defaults: LCD_1LINE and LCD_5x8DOTS
+   // -------------------------------------------------------------------------
+   if ( dataLines == 4 )
+      _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   else
+      _displayfunction = LCD_8BITMODE | LCD_1LINE | LCD_5x8DOTS;
+
+   _polarity = POSITIVE;
+}
+
+//
+// setLines
+bool LiquidCrystal_GPIOChip::setLines ( uint64_t bits, uint64_t mask )
+{
+   struct gpio_v2_line_values values;
+
+   values.bits = bits;
+   values.mask = mask;
+   return ( ioctl ( _lineFd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values ) == 0 );
+}
+
+//
+// writeNbits
+bool LiquidCrystal_GPIOChip::writeNbits ( uint8_t value, uint8_t numBits, bool rs )
+{
+   uint64_t rsBit    = rs ? RS_BIT : 0;
+   uint64_t dataMask = ( ( (uint64_t)1 << numBits ) - 1 ) << DATA_SHIFT;
+   uint64_t rise;
+   bool result = true;
+
+   // The LCD has to be done with the previous write
+   waitUntil ( _nextEnable );
+
+   // RS set-up time to En rise, only when it changes
+   if ( rsBit != _rs )
+   {
+      result = setLines ( rsBit, RS_BIT );
+      waitUntil ( now ( ) + LCD_T_AS );
+      _rs = rsBit;
+   }
+
+   // RS and data with En rising, then En falling latches the data
+   result = result && setLines ( rsBit | EN_BIT | ( ( (uint64_t)value << DATA_SHIFT ) & dataMask ),
+                                 RS_BIT | EN_BIT | dataMask );
+   rise = now ( );
+   waitUntil ( rise + LCD_T_PWEH );
+   result = result && setLines ( 0, EN_BIT );
+
+   _nextEnable = rise + LCD_T_CYCE;
+   return ( result );
+}
+
+// low level data pushing commands
+//----------------------------------------------------------------------------
+
+//
+// send - write either command or data
+bool LiquidCrystal_GPIOChip::send(uint8_t value, uint8_t mode)
+{
+   bool rs = ( mode == LCD_DATA );
+   bool result;
+
+   if ( _lineFd < 0 )
+   {
+      return false;
+   }
+
+   if ( mode == FOUR_BITS )
+   {
+      result = writeNbits ( value, 4, rs );
+   }
+   else if ( _dataLines == 8 )
+   {
+      result = writeNbits ( value, 8, rs );
+   }
+   else
+   {
+      result = writeNbits ( value >> 4, 4, rs ) && writeNbits ( value, 4, rs );
+   }
+
+   // Execution time, waited for by the next write
+   _nextEnable = now ( ) + GPIOCHIP_EXEC_TIME * 1000ULL;
+   return result;
+}
@@ -0,0 +1,186 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_GPIOChip.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK for the Linux host build, using the parallel port of
+// the LCD on GPIO character device lines.
+//
+// @brief
+// Same LCD wiring as LiquidCrystal (4 bit and 8 bit, R/W tied to ground),
+// the lines being offsets of a /dev/gpiochipN device. All the lines are
+// held by a single GPIO v2 line request, so a nibble (or byte) is written
+// with two GPIO_V2_LINE_SET_VALUES_IOCTL system calls:
+//    - RS and the data lines set with En rising.
+//    - En falling, latching the data.
+// When RS changes, it is set on its own first to meet the RS set-up time.
+//
+// The 37us command execution time is not slept: the time the LCD is busy
+// until is recorded and the next write spins on the monotonic clock until
+// then, so any work done between two writes shortens the wait.
+//
+//    LiquidCrystal_GPIOChip lcd ( "/dev/gpiochip0", 25, 24, 23, 17, 18, 22 );
+//    lcd.begin ( 16, 2 );
+//    lcd.print ( "hello, world!" );
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_GPIOChip_h
+#define LiquidCrystal_GPIOChip_h
+
+#include <inttypes.h>
+
+#include "LCD.h"
+
+/*!
+ @defined
+ @abstract   Command execution time on the LCD.
+ @discussion Time in microseconds the LCD takes to execute a command or a
+ data write.
+ */
+#define GPIOCHIP_EXEC_TIME   37
+
+/*!
+ @defined
+ @abstract   GPIO consumer label of the LCD lines.
+ */
+#define GPIOCHIP_CONSUMER    "LiquidCrystal"
+
+
+class LiquidCrystal_GPIOChip : public LCD
+{
+public:
+   /*!
+    @method
+    @abstract   8 bit LCD constructor.
+    @discussion Defines the GPIO chip and the line offsets of the LCD. The
+    constructor does not initialize the LCD.
+
+    @param      chip[in] GPIO character device, e.g. "/dev/gpiochip0".
+    @param      rs[in] line of the LCD register select.
+    @param      enable[in] line of the LCD enable.
+    @param      d0 .. d7[in] lines of the LCD data lines.
+    */
+   LiquidCrystal_GPIOChip ( const char *chip, uint32_t rs, uint32_t enable,
+                            uint32_t d0, uint32_t d1, uint32_t d2, uint32_t d3,
+                            uint32_t d4, uint32_t d5, uint32_t d6, uint32_t d7 );
+
+   /*!
+    @method
+    @abstract   4 bit LCD constructor.
+    @discussion Defines the GPIO chip and the line offsets of the LCD. The
+    constructor does not initialize the LCD.
+
+    @param      chip[in] GPIO character device, e.g. "/dev/gpiochip0".
+    @param      rs[in] line of the LCD register select.
+    @param      enable[in] line of the LCD enable.
+    @param      d0 .. d3[in] lines of the LCD data lines D4 .. D7.
+    */
+   LiquidCrystal_GPIOChip ( const char *chip, uint32_t rs, uint32_t enable,
+                            uint32_t d0, uint32_t d1, uint32_t d2, uint32_t d3 );
+
+   /*!
+    @method
+    @abstract   Class destructor.
+    @discussion Releases the GPIO lines.
+    */
+   virtual ~LiquidCrystal_GPIOChip ( );
+
+   /*!
+    @function
+    @abstract   LCD initialization and associated HW.
+    @discussion Requests the GPIO lines as outputs driven low and initializes
+    the LCD to a given size (col, row). This methods initializes the LCD,
+    therefore, it MUST be called prior to using any other method from this
+    class or parent class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    @result     false if the lines are not available.
+    */
+   virtual bool send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Sets the line to control the backlight.
+    @discussion Has to be called before begin, the line is requested with
+    the LCD lines.
+
+    @param      value: line offset of the backlight (0 .. 255).
+    @param      pol: backlight polarity POSITIVE|NEGATIVE.
+    */
+   void setBacklightPin ( uint8_t value, t_backlighPol pol );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    @discussion The setBacklightPin has to be called before begin for this
+    method to work.
+
+    @param      value: backlight mode (HIGH|LOW)
+    */
+   void setBacklight ( uint8_t value );
+
+private:
+
+   /*!
+    @method
+    @abstract   Initialises class private variables.
+    */
+   void init ( const char *chip, uint8_t dataLines, uint32_t rs, uint32_t enable,
+               uint32_t d0, uint32_t d1, uint32_t d2, uint32_t d3,
+               uint32_t d4, uint32_t d5, uint32_t d6, uint32_t d7 );
+
+   /*!
+    @method
+    @abstract   Writes numBits bits of value to the LCD data lines.
+    @discussion Waits for the previous write to complete, then sets RS and
+    the data lines with En rising and drops En.
+    */
+   bool writeNbits ( uint8_t value, uint8_t numBits, bool rs );
+
+   /*!
+    @method
+    @abstract   Sets the level of a set of requested lines.
+    @param      bits[in] levels, bit n for the n-th requested line.
+    @param      mask[in] lines to update.
+    @result     true on success.
+    */
+   bool setLines ( uint64_t bits, uint64_t mask );
+
+   const char *_chip;         // GPIO character device
+   int      _lineFd;          // Line request, -1 if not requested
+   uint32_t _offsets[11];     // RS, En, data lines, backlight
+   uint8_t  _dataLines;       // 4 or 8
+   uint8_t  _numLines;        // Lines in the request
+   uint64_t _blBit;           // Backlight line bit, 0 if none
+   uint64_t _rs;              // Current RS line level bit
+   uint64_t _nextEnable;      // Earliest En rise (monotonic ns)
+};
+
+#endif
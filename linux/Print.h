@@ -0,0 +1,74 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file Print.h
+// Print class of the Linux host build of the library.
+//
+// @brief
+// Same interface as the Arduino Print class for strings, characters and
+// numbers, LCD derives from it.
+//
+// ---------------------------------------------------------------------------
+#ifndef Print_h
+#define Print_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print
+{
+public:
+   virtual ~Print ( ) { }
+
+   virtual size_t write ( uint8_t ) = 0;
+   virtual size_t write ( const uint8_t *buffer, size_t size );
+   size_t write ( const char *str )
+   {
+      return ( ( str == NULL ) ? 0 : write ( (const uint8_t *)str, strlen ( str ) ) );
+   }
+   size_t write ( const char *buffer, size_t size )
+   {
+      return ( write ( (const uint8_t *)buffer, size ) );
+   }
+
+   virtual int availableForWrite ( void ) { return 0; }
+   virtual void flush ( void ) { }
+
+   size_t print ( const char str[] );
+   size_t print ( char c );
+   size_t print ( unsigned char n, int base = DEC );
+   size_t print ( int n, int base = DEC );
+   size_t print ( unsigned int n, int base = DEC );
+   size_t print ( long n, int base = DEC );
+   size_t print ( unsigned long n, int base = DEC );
+   size_t print ( double n, int digits = 2 );
+
+   size_t println ( const char str[] );
+   size_t println ( char c );
+   size_t println ( unsigned char n, int base = DEC );
+   size_t println ( int n, int base = DEC );
+   size_t println ( unsigned int n, int base = DEC );
+   size_t println ( long n, int base = DEC );
+   size_t println ( unsigned long n, int base = DEC );
+   size_t println ( double n, int digits = 2 );
+   size_t println ( void );
+
+private:
+   size_t printNumber ( unsigned long n, uint8_t base );
+   size_t printFloat ( double n, uint8_t digits );
+};
+
+#endif
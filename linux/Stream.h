@@ -0,0 +1,32 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file Stream.h
+// Stream class of the Linux host build of the library.
+//
+// @brief
+// Same interface as the Arduino Stream class for the reads, LiquidCrystal_Serial
+// writes to a Stream.
+//
+// ---------------------------------------------------------------------------
+#ifndef Stream_h
+#define Stream_h
+
+#include "Print.h"
+
+class Stream : public Print
+{
+public:
+   virtual int available ( void ) = 0;
+   virtual int read ( void ) = 0;
+   virtual int peek ( void ) = 0;
+};
+
+#endif
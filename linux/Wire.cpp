@@ -0,0 +1,259 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file Wire.cpp
+// Wire class of the Linux host build of the library, on i2c-dev.
+//
+// @brief
+// @see Wire.h.
+//
+// ---------------------------------------------------------------------------
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "Wire.h"
+
+// STATIC helper functions
+// ---------------------------------------------------------------------------
+
+//
+// smbusAccess - SMBus transfer, as i2c_smbus_access of libi2c
+static int smbusAccess ( int fd, uint8_t readWrite, uint8_t command, int size,
+                         union i2c_smbus_data *data )
+{
+   struct i2c_smbus_ioctl_data args;
+
+   args.read_write = readWrite;
+   args.command    = command;
+   args.size       = size;
+   args.data       = data;
+   return ( ioctl ( fd, I2C_SMBUS, &args ) );
+}
+
+// CONSTRUCTOR
+// ---------------------------------------------------------------------------
+TwoWire::TwoWire ( void )
+{
+   _device    = LINUX_I2C_DEVICE;
+   _fd        = -1;
+   _plainI2C  = false;
+   _slave     = -1;
+   _txAddress = 0;
+   _txLength  = 0;
+   _rxIndex   = 0;
+   _rxLength  = 0;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// setDevice
+void TwoWire::setDevice ( const char *device )
+{
+   _device = device;
+}
+
+//
+// begin
+void TwoWire::begin ( void )
+{
+   unsigned long funcs = 0;
+
+   if ( _fd < 0 )
+   {
+      _fd = open ( _device, O_RDWR );
+      if ( ( _fd >= 0 ) && ( ioctl ( _fd, I2C_FUNCS, &funcs ) == 0 ) )
+      {
+         _plainI2C = ( ( funcs & I2C_FUNC_I2C ) != 0 );
+      }
+      _slave = -1;
+   }
+}
+
+//
+// end
+void TwoWire::end ( void )
+{
+   if ( _fd >= 0 )
+   {
+      close ( _fd );
+      _fd = -1;
+   }
+}
+
+//
+// beginTransmission
+void TwoWire::beginTransmission ( uint8_t address )
+{
+   _txAddress = address;
+   _txLength  = 0;
+}
+
+//
+// write
+size_t TwoWire::write ( uint8_t value )
+{
+   if ( _txLength >= BUFFER_LENGTH )
+   {
+      return ( 0 );
+   }
+   _txBuffer[_txLength++] = value;
+   return ( 1 );
+}
+
+//
+// write
+size_t TwoWire::write ( const uint8_t *data, size_t len )
+{
+   size_t n = 0;
+
+   while ( ( n < len ) && write ( data[n] ) )
+   {
+      n++;
+   }
+   return ( n );
+}
+
+//
+// endTransmission
+uint8_t TwoWire::endTransmission ( void )
+{
+   if ( _fd < 0 )
+   {
+      return ( 4 );
+   }
+
+   if ( _plainI2C )
+   {
+      // The whole transaction in a single system call
+      struct i2c_msg msg;
+      struct i2c_rdwr_ioctl_data xfer;
+
+      msg.addr  = _txAddress;
+      msg.flags = 0;
+      msg.len   = _txLength;
+      msg.buf   = _txBuffer;
+      xfer.msgs  = &msg;
+      xfer.nmsgs = 1;
+
+      if ( ioctl ( _fd, I2C_RDWR, &xfer ) < 0 )
+      {
+         return ( ( errno == ENXIO ) || ( errno == EREMOTEIO ) ? 2 : 4 );
+      }
+   }
+   else
+   {
+      // SMBus only adapter: quick write to probe, send byte otherwise
+      if ( !setSlave ( _txAddress ) )
+      {
+         return ( 4 );
+      }
+      if ( _txLength == 0 )
+      {
+         if ( smbusAccess ( _fd, I2C_SMBUS_WRITE, 0, I2C_SMBUS_QUICK, NULL ) < 0 )
+         {
+            return ( 2 );
+         }
+      }
+      for ( uint8_t i = 0; i < _txLength; i++ )
+      {
+         if ( smbusAccess ( _fd, I2C_SMBUS_WRITE, _txBuffer[i], I2C_SMBUS_BYTE,
+                            NULL ) < 0 )
+         {
+            return ( 2 );
+         }
+      }
+   }
+   return ( 0 );
+}
+
+//
+// requestFrom
+uint8_t TwoWire::requestFrom ( uint8_t address, uint8_t quantity )
+{
+   _rxIndex  = 0;
+   _rxLength = 0;
+
+   if ( quantity > BUFFER_LENGTH )
+   {
+      quantity = BUFFER_LENGTH;
+   }
+
+   if ( _fd >= 0 )
+   {
+      if ( _plainI2C )
+      {
+         struct i2c_msg msg;
+         struct i2c_rdwr_ioctl_data xfer;
+
+         msg.addr  = address;
+         msg.flags = I2C_M_RD;
+         msg.len   = quantity;
+         msg.buf   = _rxBuffer;
+         xfer.msgs  = &msg;
+         xfer.nmsgs = 1;
+
+         if ( ioctl ( _fd, I2C_RDWR, &xfer ) >= 0 )
+         {
+            _rxLength = quantity;
+         }
+      }
+      else if ( setSlave ( address ) )
+      {
+         union i2c_smbus_data data;
+
+         while ( ( _rxLength < quantity ) &&
+                 ( smbusAccess ( _fd, I2C_SMBUS_READ, 0, I2C_SMBUS_BYTE, &data ) >= 0 ) )
+         {
+            _rxBuffer[_rxLength++] = data.byte;
+         }
+      }
+   }
+   return ( _rxLength );
+}
+
+//
+// available
+int TwoWire::available ( void )
+{
+   return ( _rxLength - _rxIndex );
+}
+
+//
+// read
+int TwoWire::read ( void )
+{
+   return ( ( _rxIndex < _rxLength ) ? _rxBuffer[_rxIndex++] : -1 );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// setSlave
+bool TwoWire::setSlave ( uint8_t address )
+{
+   if ( _slave != address )
+   {
+      if ( ioctl ( _fd, I2C_SLAVE, (unsigned long)address ) < 0 )
+      {
+         return ( false );
+      }
+      _slave = address;
+   }
+   return ( true );
+}
+
+TwoWire Wire;
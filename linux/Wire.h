@@ -0,0 +1,155 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file Wire.h
+// Wire class of the Linux host build of the library, on i2c-dev.
+//
+// @brief
+// Same interface as the Arduino Wire class, so that I2CIO and the I2C LCD
+// drivers run unchanged on a Linux I2C bus (/dev/i2c-N).
+//
+// A transmission is staged by beginTransmission/write and sent by
+// endTransmission as a single I2C_RDWR ioctl: I2CIO::write(values, len)
+// sends the 4 expander words of an LCD character with one system call. On
+// SMBus only adapters (such as i2c-stub) each byte is sent with an SMBus
+// send byte command instead, one system call per byte.
+//
+//    Wire.setDevice ( "/dev/i2c-0" );    // before lcd.begin, default i2c-1
+//    LiquidCrystal_I2C lcd ( 0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE );
+//    lcd.begin ( 16, 2 );
+//
+// ---------------------------------------------------------------------------
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include <inttypes.h>
+#include <stddef.h>
+
+/*!
+ @defined
+ @abstract   Default I2C bus device.
+ */
+#ifndef LINUX_I2C_DEVICE
+#define LINUX_I2C_DEVICE   "/dev/i2c-1"
+#endif
+
+/*!
+ @defined
+ @abstract   Size of the transmit and receive buffers.
+ @discussion Same as the Arduino Wire library.
+ */
+#define BUFFER_LENGTH      32
+
+class TwoWire
+{
+public:
+   /*!
+    @method
+    @abstract   Constructor method.
+    */
+   TwoWire ( void );
+
+   /*!
+    @method
+    @abstract   Selects the I2C bus device.
+    @discussion Has to be called before begin, the default is
+    LINUX_I2C_DEVICE.
+    @param      device[in] path of the bus device, e.g. "/dev/i2c-0".
+    */
+   void setDevice ( const char *device );
+
+   /*!
+    @method
+    @abstract   Opens the I2C bus device.
+    @discussion Can be called more than once, the device is only opened once.
+    */
+   void begin ( void );
+
+   /*!
+    @method
+    @abstract   Closes the I2C bus device.
+    */
+   void end ( void );
+
+   /*!
+    @method
+    @abstract   Starts staging a write transaction.
+    @param      address[in] 7 bit I2C address of the device.
+    */
+   void beginTransmission ( uint8_t address );
+
+   /*!
+    @method
+    @abstract   Stages a byte of the write transaction.
+    @result     1 if the byte was staged, 0 if the buffer is full.
+    */
+   size_t write ( uint8_t value );
+
+   /*!
+    @method
+    @abstract   Stages a set of bytes of the write transaction.
+    @result     number of bytes staged.
+    */
+   size_t write ( const uint8_t *data, size_t len );
+
+   /*!
+    @method
+    @abstract   Sends the staged write transaction.
+    @result     0 on success, 2 if the address was not acknowledged, 4 on any
+    other error (bus device not open).
+    */
+   uint8_t endTransmission ( void );
+   uint8_t endTransmission ( uint8_t sendStop ) { return endTransmission ( ); }
+
+   /*!
+    @method
+    @abstract   Reads bytes from a device.
+    @param      address[in] 7 bit I2C address of the device.
+    @param      quantity[in] number of bytes to read (up to BUFFER_LENGTH).
+    @result     number of bytes read.
+    */
+   uint8_t requestFrom ( uint8_t address, uint8_t quantity );
+
+   /*!
+    @method
+    @abstract   Number of bytes read and not consumed yet.
+    */
+   int available ( void );
+
+   /*!
+    @method
+    @abstract   Consumes a byte read by requestFrom.
+    @result     the byte, -1 if there is none.
+    */
+   int read ( void );
+
+private:
+   /*!
+    @method
+    @abstract   Sets the device address for SMBus transfers.
+    @result     true on success.
+    */
+   bool setSlave ( uint8_t address );
+
+   const char *_device;                 // Bus device path
+   int      _fd;                        // Bus device, -1 if not open
+   bool     _plainI2C;                  // Adapter supports I2C_RDWR
+   int      _slave;                     // Address set for SMBus, -1 if none
+   uint8_t  _txAddress;                 // Address of the staged transaction
+   uint8_t  _txBuffer[BUFFER_LENGTH];   // Staged bytes
+   uint8_t  _txLength;                  // Number of staged bytes
+   uint8_t  _rxBuffer[BUFFER_LENGTH];   // Bytes read
+   uint8_t  _rxIndex;                   // Next byte to consume
+   uint8_t  _rxLength;                  // Number of bytes read
+};
+
+extern TwoWire Wire;
+
+#endif
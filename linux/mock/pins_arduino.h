@@ -0,0 +1,180 @@
+// ---------------------------------------------------------------------------
+// Copyright 2011 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file pins_arduino.h
+// Mock core of the cores with set and clear output registers, for the host
+// test of FastIO (test_fastio).
+//
+// @brief
+// Built with ARDUINO_ARCH_SAMD, ARDUINO_ARCH_SAM or ARDUINO_ARCH_ESP8266
+// defined, each port is a block of 32 bit registers laid out as on the
+// device:
+//    - SAMD, PORT->Group[n]: DIR .. OUT, OUTCLR, OUTSET, OUTTGL, IN.
+//    - SAM, PIOx: SODR, CODR, ODSR, PDSR at 0x30 .. 0x3C, OWER, OWDR, OWSR
+//      at 0xA0 .. 0xA8.
+//    - ESP8266, GPIO: GPO, GPOS, GPOC .. GPI.
+// portOutputRegister returns the output register of the port (OUT, ODSR,
+// GPO) as a MockRegister, which FastIO uses as its fio_register: every
+// store goes through mockStore, which applies it as the device does and
+// logs it. Pin n is bit n % 32 of port n / 32, but for the ESP8266 GPIO16:
+// the GPO register only has pins 0 .. 15, GPIO16 is bit 0 of port 1 (the
+// RTC GPIO register) and can only be written with digitalWrite.
+//
+// ---------------------------------------------------------------------------
+#ifndef pins_arduino_h
+#define pins_arduino_h
+
+#include <stdint.h>
+
+#define LSBFIRST   0
+#define MSBFIRST   1
+
+#define F_CPU      48000000UL
+
+// Registers of a port, in 32 bit words
+#if defined (ARDUINO_ARCH_SAMD)
+#define MOCK_OUT   4     // OUT
+#define MOCK_CLR   5     // OUTCLR
+#define MOCK_SET   6     // OUTSET
+#define MOCK_IN    8     // IN
+#elif defined (ARDUINO_ARCH_SAM)
+#define MOCK_SET   12    // PIO_SODR
+#define MOCK_CLR   13    // PIO_CODR
+#define MOCK_OUT   14    // PIO_ODSR
+#define MOCK_IN    15    // PIO_PDSR
+#define MOCK_OWER  40    // PIO_OWER
+#define MOCK_OWDR  41    // PIO_OWDR
+#define MOCK_OWSR  42    // PIO_OWSR
+#elif defined (ARDUINO_ARCH_ESP8266)
+#define MOCK_OUT   0     // GPO
+#define MOCK_SET   1     // GPOS
+#define MOCK_CLR   2     // GPOC
+#define MOCK_IN    6     // GPI
+#endif
+
+// Pins on the output register of a port
+#if defined (ARDUINO_ARCH_ESP8266)
+#define MOCK_PINS(port)  ( (port) == 0 ? 0x0000FFFFUL : 0x00000001UL )
+#else
+#define MOCK_PINS(port)  0xFFFFFFFFUL
+#endif
+
+#define MOCK_REGS     48
+#define MOCK_PORTS    2
+#define MOCK_LOG_LEN  256
+
+/*!
+ @typedef
+ @abstract   Store to a register of the mock.
+ */
+typedef struct
+{
+   uint8_t  port;              // port written
+   uint8_t  reg;               // register of the port (MOCK_xxx)
+   uint32_t value;             // value stored
+   uint32_t out[MOCK_PORTS];   // output registers after the store
+   bool     irqOff;            // interrupts disabled during the store
+} t_mockStore;
+
+extern uint32_t    mockPorts[MOCK_PORTS][MOCK_REGS];
+extern t_mockStore mockLog[MOCK_LOG_LEN];
+extern int         mockLogLen;
+extern int         mockIrqOff;
+
+/*!
+ @function
+ @abstract   Stores a value to a register of the mock.
+ @discussion Updates the output register as the device does and logs the
+ store.
+ */
+void mockStore ( uint32_t *reg, uint32_t value );
+
+/*!
+ @class
+ @abstract   Register of the mock, as seen through a MockRegister.
+ */
+class MockRef
+{
+public:
+   MockRef ( uint32_t *reg ) : _reg ( reg ) { }
+   operator uint32_t ( ) const { return ( *_reg ); }
+   MockRef &operator= ( uint32_t value ) { mockStore ( _reg, value ); return ( *this ); }
+   MockRef &operator|= ( uint32_t value ) { return ( *this = *_reg | value ); }
+   MockRef &operator&= ( uint32_t value ) { return ( *this = *_reg & value ); }
+   MockRef &operator^= ( uint32_t value ) { return ( *this = *_reg ^ value ); }
+private:
+   uint32_t *_reg;
+};
+
+/*!
+ @class
+ @abstract   Pointer to a register of the mock, the fio_register of FastIO.
+ */
+class MockRegister
+{
+public:
+   MockRegister ( ) : _reg ( 0 ) { }
+   MockRegister ( uint32_t *reg ) : _reg ( reg ) { }
+   MockRegister operator+ ( int n ) const { return ( MockRegister ( _reg + n ) ); }
+   MockRef operator* ( ) const { return ( MockRef ( _reg ) ); }
+   bool operator== ( const MockRegister &r ) const { return ( _reg == r._reg ); }
+   bool operator!= ( const MockRegister &r ) const { return ( _reg != r._reg ); }
+private:
+   uint32_t *_reg;
+};
+
+#define FIO_REGISTER MockRegister
+
+// Core pin API
+// ---------------------------------------------------------------------------
+#define digitalPinToPort(pin)     ( (pin) / 32 )
+#define digitalPinToBitMask(pin)  ( (uint32_t)1 << ( (pin) % 32 ) )
+#define portOutputRegister(port)  ( MockRegister ( &mockPorts[port][MOCK_OUT] ) )
+#define portInputRegister(port)   ( MockRegister ( &mockPorts[port][MOCK_IN] ) )
+
+// Port and bit of a pin, as written by digitalWrite
+inline uint8_t mockPinPort ( uint8_t pin )
+{
+#if defined (ARDUINO_ARCH_ESP8266)
+   return ( pin == 16 ? 1 : 0 );
+#else
+   return ( digitalPinToPort ( pin ) );
+#endif
+}
+
+inline uint32_t mockPinBit ( uint8_t pin )
+{
+#if defined (ARDUINO_ARCH_ESP8266)
+   return ( pin == 16 ? 1 : digitalPinToBitMask ( pin ) );
+#else
+   return ( digitalPinToBitMask ( pin ) );
+#endif
+}
+
+inline void noInterrupts ( void ) { mockIrqOff++; }
+inline void interrupts ( void ) { mockIrqOff--; }
+
+inline void pinMode ( uint8_t pin, uint8_t mode ) { }
+
+inline void digitalWrite ( uint8_t pin, uint8_t value )
+{
+   uint32_t *port = mockPorts[mockPinPort ( pin )];
+
+   mockStore ( &port[value ? MOCK_SET : MOCK_CLR], mockPinBit ( pin ) );
+}
+
+inline void analogWrite ( uint8_t pin, int value ) { }
+
+inline int digitalRead ( uint8_t pin )
+{
+   return ( ( mockPorts[mockPinPort ( pin )][MOCK_IN] & mockPinBit ( pin ) ) != 0 );
+}
+
+#endif
@@ -0,0 +1,323 @@
+// ---------------------------------------------------------------------------
+// test_fastio - checks the fast IO of the cores with set and clear output
+// registers (SAMD, SAM and ESP8266)
+//
+// Built once per core against the register map of mock/pins_arduino.h, the
+// stores to the registers are logged as they reach the mock. Checks that:
+//    - fio_pinToOutputRegister returns the output register of the port and,
+//      on the SAM, enables its direct writes (PIO_OWER).
+//    - fio_digitalWrite_HIGH/LOW and fio_digitalWrite are a single store to
+//      the set or clear register, the other pins of the port keep their level.
+//    - fio_shiftOut<> and fio_shiftOut clock the bits out in order with set
+//      and clear stores only, fio_shiftOut<> with interrupts enabled.
+//    - the LiquidCrystal data lines of a port are written by one set and one
+//      clear store, and the nibbles latched on En falling decode back.
+//    - on the ESP8266, GPIO16 (off the GPO register) is written with
+//      digitalWrite, by the LiquidCrystal too.
+//
+// usage: test_fastio_<core>, exit status 0 if all the checks pass.
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+
+#include <Arduino.h>
+#include "FastIO.h"
+#include "LiquidCrystal.h"
+
+// MOCK registers
+// ---------------------------------------------------------------------------
+uint32_t    mockPorts[MOCK_PORTS][MOCK_REGS];
+t_mockStore mockLog[MOCK_LOG_LEN];
+int         mockLogLen;
+int         mockIrqOff;
+
+void mockStore ( uint32_t *reg, uint32_t value )
+{
+   int port = ( reg - &mockPorts[0][0] ) / MOCK_REGS;
+   int r    = ( reg - &mockPorts[0][0] ) % MOCK_REGS;
+   uint32_t *regs = mockPorts[port];
+
+   *reg = value;
+   switch ( r )
+   {
+      case MOCK_SET:
+         regs[MOCK_OUT] |= value & MOCK_PINS ( port );
+         break;
+      case MOCK_CLR:
+         regs[MOCK_OUT] &= ~( value & MOCK_PINS ( port ) );
+         break;
+#if defined (ARDUINO_ARCH_SAM)
+      case MOCK_OUT:
+         // Only the pins enabled in PIO_OWSR are written
+         regs[MOCK_OUT] = value & regs[MOCK_OWSR];
+         break;
+      case MOCK_OWER:
+         regs[MOCK_OWSR] |= value;
+         break;
+      case MOCK_OWDR:
+         regs[MOCK_OWSR] &= ~value;
+         break;
+#endif
+   }
+   regs[MOCK_IN] = regs[MOCK_OUT];
+
+   if ( mockLogLen < MOCK_LOG_LEN )
+   {
+      t_mockStore *entry = &mockLog[mockLogLen++];
+
+      entry->port   = port;
+      entry->reg    = r;
+      entry->value  = value;
+      entry->irqOff = ( mockIrqOff != 0 );
+      for ( int p = 0; p < MOCK_PORTS; p++ )
+      {
+         entry->out[p] = mockPorts[p][MOCK_OUT];
+      }
+   }
+}
+
+static void resetMock ( void )
+{
+   mockLogLen = 0;
+}
+
+// Stores to a register of a port
+static int storesTo ( int port, int reg )
+{
+   int n = 0;
+
+   for ( int i = 0; i < mockLogLen; i++ )
+   {
+      n += ( mockLog[i].port == port ) && ( mockLog[i].reg == reg );
+   }
+   return ( n );
+}
+
+// Level of a pin after a store
+static bool level ( const t_mockStore *entry, uint8_t pin )
+{
+   return ( ( entry->out[mockPinPort ( pin )] & mockPinBit ( pin ) ) != 0 );
+}
+
+// Byte clocked out on the rising edges of a pin, MSB first
+static uint8_t clockedOut ( uint8_t dataPin, uint8_t clockPin )
+{
+   bool    prev  = false;       // clock low before the first store
+   uint8_t value = 0;
+
+   for ( int i = 0; i < mockLogLen; i++ )
+   {
+      bool clock = level ( &mockLog[i], clockPin );
+
+      if ( !prev && clock )
+      {
+         value = ( value << 1 ) | level ( &mockLog[i], dataPin );
+      }
+      prev = clock;
+   }
+   return ( value );
+}
+
+// Nibbles latched on the falling edges of En, from data lines d4 .. d7
+static int latched ( uint8_t en, const uint8_t *d, uint8_t *nibbles )
+{
+   int  n    = 0;
+   bool prev = false;           // En low before the first store
+
+   for ( int i = 0; i < mockLogLen; i++ )
+   {
+      bool enable = level ( &mockLog[i], en );
+
+      if ( prev && !enable )
+      {
+         nibbles[n] = 0;
+         for ( int b = 0; b < 4; b++ )
+         {
+            nibbles[n] |= level ( &mockLog[i], d[b] ) << b;
+         }
+         n++;
+      }
+      prev = enable;
+   }
+   return ( n );
+}
+
+// CHECKS
+// ---------------------------------------------------------------------------
+static int failures;
+
+#define CHECK(cond) \
+   do { if ( !( cond ) ) { printf ( "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond ); failures++; } } while ( 0 )
+
+// Writes 'H' to a 4 bit LCD on rs, en and d4 .. d7, the other pins of the
+// ports high
+static void checkLcd ( uint8_t rs, uint8_t en, const uint8_t *d )
+{
+   LiquidCrystal lcd ( rs, en, d[0], d[1], d[2], d[3] );
+   uint8_t nibbles[4];
+
+   lcd.begin ( 16, 2 );
+   for ( int p = 0; p < MOCK_PORTS; p++ )
+   {
+      mockPorts[p][MOCK_OUT] = mockPorts[p][MOCK_IN] = 0xFFFFFFFF;
+   }
+   for ( int b = 0; b < 4; b++ )
+   {
+      mockPorts[mockPinPort ( d[b] )][MOCK_OUT] &= ~mockPinBit ( d[b] );
+   }
+   mockPorts[mockPinPort ( en )][MOCK_OUT] &= ~mockPinBit ( en );
+
+   resetMock ( );
+   lcd.write ( 'H' );
+
+   CHECK ( latched ( en, d, nibbles ) == 2 );
+   CHECK ( nibbles[0] == 0x4 && nibbles[1] == 0x8 );
+   for ( int p = 0; p < MOCK_PORTS; p++ )
+   {
+      CHECK ( storesTo ( p, MOCK_OUT ) == 0 );
+   }
+   CHECK ( mockPorts[mockPinPort ( rs )][MOCK_OUT] & mockPinBit ( rs ) );
+   CHECK ( mockPorts[0][MOCK_OUT] & 0x01 );   // not an LCD pin, still high
+}
+
+int main ( void )
+{
+   const uint8_t  dataPin  = 5;
+   const uint8_t  clockPin = 6;
+   const uint32_t dataBit  = digitalPinToBitMask ( dataPin );
+   const uint32_t clockBit = digitalPinToBitMask ( clockPin );
+   fio_register   reg;
+
+   // Output register of the pin
+   // ------------------------------------------------------------------------
+   reg = fio_pinToOutputRegister ( dataPin );
+   fio_pinToOutputRegister ( clockPin );
+   CHECK ( reg == portOutputRegister ( 0 ) );
+   CHECK ( fio_pinToBit ( dataPin ) == dataBit );
+#if defined (ARDUINO_ARCH_SAM)
+   CHECK ( ( mockPorts[0][MOCK_OWSR] & ( dataBit | clockBit ) ) == ( dataBit | clockBit ) );
+#endif
+   CHECK ( !( mockPorts[0][MOCK_OUT] & dataBit ) );
+
+   // Single pin writes
+   // ------------------------------------------------------------------------
+   mockPorts[0][MOCK_OUT] = 0x80000001;
+   resetMock ( );
+   fio_digitalWrite_HIGH ( reg, dataBit );
+   CHECK ( mockLogLen == 1 );
+   CHECK ( mockLog[0].reg == MOCK_SET && mockLog[0].value == dataBit );
+   CHECK ( mockPorts[0][MOCK_OUT] == ( 0x80000001 | dataBit ) );
+
+   resetMock ( );
+   fio_digitalWrite_LOW ( reg, dataBit );
+   CHECK ( mockLogLen == 1 );
+   CHECK ( mockLog[0].reg == MOCK_CLR && mockLog[0].value == dataBit );
+   CHECK ( mockPorts[0][MOCK_OUT] == 0x80000001 );
+
+   resetMock ( );
+   fio_digitalWrite ( reg, dataBit, HIGH );
+   fio_digitalWrite ( reg, dataBit, LOW );
+   CHECK ( mockLogLen == 2 );
+   CHECK ( mockLog[0].reg == MOCK_SET && mockLog[1].reg == MOCK_CLR );
+   CHECK ( mockPorts[0][MOCK_OUT] == 0x80000001 );
+   CHECK ( fio_digitalRead ( portInputRegister ( 0 ), 0x80000000 ) == HIGH );
+   CHECK ( fio_digitalRead ( portInputRegister ( 0 ), dataBit ) == LOW );
+
+   // Shift out
+   // ------------------------------------------------------------------------
+   resetMock ( );
+   fio_shiftOut<MSBFIRST> ( reg, dataBit, reg, clockBit, 0xA5 );
+   CHECK ( mockLogLen == 8 * 3 );
+   CHECK ( clockedOut ( dataPin, clockPin ) == 0xA5 );
+   CHECK ( storesTo ( 0, MOCK_OUT ) == 0 );
+   for ( int i = 0; i < mockLogLen; i++ )
+   {
+      CHECK ( !mockLog[i].irqOff );
+   }
+   CHECK ( ( mockPorts[0][MOCK_OUT] & ~( dataBit | clockBit ) ) == 0x80000001 );
+   CHECK ( !( mockPorts[0][MOCK_OUT] & clockBit ) );
+
+   resetMock ( );
+   fio_shiftOut<LSBFIRST> ( reg, dataBit, reg, clockBit, 0x0F );
+   CHECK ( clockedOut ( dataPin, clockPin ) == 0xF0 );
+
+   resetMock ( );
+   fio_shiftOut ( reg, dataBit, reg, clockBit, 0x12, LSBFIRST );
+   CHECK ( clockedOut ( dataPin, clockPin ) == 0x48 );
+   CHECK ( storesTo ( 0, MOCK_OUT ) == 0 );
+
+   // LiquidCrystal port groups
+   // ------------------------------------------------------------------------
+   {
+      // d4 .. d7 in order on one port: one group, shifted
+      const uint8_t d[4] = { 8, 9, 10, 11 };
+
+      checkLcd ( 2, 3, d );
+      // RS, then data set and clear, En high and low per nibble
+      CHECK ( mockLogLen == 1 + 2 * 4 );
+      CHECK ( mockLog[1].reg == MOCK_SET && mockLog[1].value == ( 0x4UL << 8 ) );
+      CHECK ( mockLog[2].reg == MOCK_CLR && mockLog[2].value == ( 0xBUL << 8 ) );
+      CHECK ( mockLog[5].reg == MOCK_SET && mockLog[5].value == ( 0x8UL << 8 ) );
+      CHECK ( mockLog[6].reg == MOCK_CLR && mockLog[6].value == ( 0x7UL << 8 ) );
+   }
+   {
+      // d4 .. d7 out of order on one port
+      const uint8_t d[4] = { 12, 4, 15, 7 };
+
+      checkLcd ( 2, 3, d );
+      CHECK ( mockLogLen == 1 + 2 * 4 );
+      CHECK ( mockLog[1].reg == MOCK_SET && mockLog[1].value == ( 1UL << 15 ) );
+      CHECK ( mockLog[2].reg == MOCK_CLR &&
+              mockLog[2].value == ( ( 1UL << 12 ) | ( 1UL << 4 ) | ( 1UL << 7 ) ) );
+   }
+#if !defined (ARDUINO_ARCH_ESP8266)
+   {
+      // d4, d5 on port 0 and d6, d7 on port 1: one set and clear per port
+      const uint8_t d[4] = { 8, 9, 40, 41 };
+
+      checkLcd ( 2, 3, d );
+      CHECK ( mockLogLen == 1 + 2 * 6 );
+      CHECK ( mockLog[1].port == 0 && mockLog[1].reg == MOCK_SET && mockLog[1].value == 0 );
+      CHECK ( mockLog[3].port == 1 && mockLog[3].reg == MOCK_SET && mockLog[3].value == ( 1UL << 8 ) );
+      CHECK ( mockLog[4].port == 1 && mockLog[4].reg == MOCK_CLR && mockLog[4].value == ( 1UL << 9 ) );
+   }
+#else
+   // GPIO16, off the GPO register
+   // ------------------------------------------------------------------------
+   {
+      fio_register reg16 = fio_pinToOutputRegister ( 16 );
+      fio_bit      bit16 = fio_pinToBit ( 16 );
+
+      resetMock ( );
+      fio_digitalWrite ( reg16, bit16, HIGH );
+      CHECK ( mockPorts[1][MOCK_OUT] & 0x01 );
+      CHECK ( fio_digitalRead ( fio_pinToInputRegister ( 16 ), fio_pinToBit ( 16 ) ) == LOW );
+      fio_digitalWrite_HIGH ( reg16, bit16 );
+      CHECK ( mockPorts[1][MOCK_OUT] & 0x01 );
+      fio_digitalWrite_SWITCH ( reg16, bit16 );
+      CHECK ( !( mockPorts[1][MOCK_OUT] & 0x01 ) );
+      CHECK ( storesTo ( 0, MOCK_SET ) + storesTo ( 0, MOCK_CLR ) == 0 );
+
+      resetMock ( );
+      fio_shiftOut<MSBFIRST> ( reg, dataBit, reg16, bit16, 0xA5 );
+      CHECK ( clockedOut ( dataPin, 16 ) == 0xA5 );
+   }
+   {
+      // En on GPIO16
+      const uint8_t d[4] = { 8, 9, 10, 11 };
+
+      checkLcd ( 2, 16, d );
+      CHECK ( mockLog[1].reg == MOCK_SET && mockLog[1].value == ( 0x4UL << 8 ) );
+   }
+   {
+      // D6 on GPIO16: no port group, digitalWrite for the data lines
+      const uint8_t d[4] = { 8, 9, 16, 11 };
+
+      checkLcd ( 2, 3, d );
+      CHECK ( mockLogLen == 1 + 2 * ( 4 + 2 ) );
+   }
+#endif
+
+   printf ( "%s\n", failures ? "FAILED" : "OK" );
+   return ( failures ? 1 : 0 );
+}
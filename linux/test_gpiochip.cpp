@@ -0,0 +1,159 @@
+// ---------------------------------------------------------------------------
+// test_gpiochip - checks the GPIO character device transport of the Linux
+// host build
+//
+// ioctl is replaced by a mock of the GPIO v2 interface that keeps the level
+// of the requested lines and latches the data lines on En falling, as the
+// LCD does; the chip and the line request are /dev/null. Checks that:
+//    - the lines are requested at once, as outputs driven low.
+//    - every nibble (4 bit) or byte (8 bit) is two GPIO_V2_LINE_SET_VALUES
+//      system calls, plus one when RS changes, and decodes back.
+//    - En rises are at least the enable cycle time apart within a character
+//      and the execution time apart between characters.
+//    - the backlight line follows setBacklight and its polarity.
+//
+// usage: test_gpiochip, exit status 0 if all the checks pass.
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#include <Arduino.h>
+#include "LiquidCrystal_GPIOChip.h"
+
+// MOCK gpiochip
+// ---------------------------------------------------------------------------
+static struct gpio_v2_line_request lastReq; // last line request
+static uint64_t lines;              // level of the requested lines
+static int      setCalls;           // GPIO_V2_LINE_SET_VALUES system calls
+static uint8_t  latched[64];        // data lines on En falling
+static uint8_t  latchedRs[64];      // RS on En falling
+static uint64_t rise[64];           // En rise times (ns)
+static int      latchLen;
+
+static uint64_t nowNs ( void )
+{
+   struct timespec ts;
+
+   clock_gettime ( CLOCK_MONOTONIC, &ts );
+   return ( (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec );
+}
+
+extern "C" int ioctl ( int fd, unsigned long request, ... )
+{
+   va_list ap;
+   void *arg;
+
+   va_start ( ap, request );
+   arg = va_arg ( ap, void * );
+   va_end ( ap );
+
+   switch ( request )
+   {
+      case GPIO_V2_GET_LINE_IOCTL:
+      {
+         struct gpio_v2_line_request *req = (struct gpio_v2_line_request *)arg;
+
+         lastReq = *req;
+         lines   = req->config.attrs[0].attr.values;
+         req->fd = open ( "/dev/null", O_RDWR );
+         return ( 0 );
+      }
+
+      case GPIO_V2_LINE_SET_VALUES_IOCTL:
+      {
+         struct gpio_v2_line_values *values = (struct gpio_v2_line_values *)arg;
+         uint64_t prev = lines;
+
+         setCalls++;
+         lines = ( lines & ~values->mask ) | ( values->bits & values->mask );
+
+         // En is the second line of the request, data from the third
+         if ( !( prev & 0x02 ) && ( lines & 0x02 ) && ( latchLen < 64 ) )
+         {
+            rise[latchLen] = nowNs ( );
+         }
+         else if ( ( prev & 0x02 ) && !( lines & 0x02 ) && ( latchLen < 64 ) )
+         {
+            latched[latchLen]   = (uint8_t)( lines >> 2 );
+            latchedRs[latchLen] = lines & 0x01;
+            latchLen++;
+         }
+         return ( 0 );
+      }
+   }
+   return ( -1 );
+}
+
+static void resetMock ( void )
+{
+   setCalls = latchLen = 0;
+}
+
+// CHECKS
+// ---------------------------------------------------------------------------
+static int failures;
+
+#define CHECK(cond) \
+   do { if ( !( cond ) ) { printf ( "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond ); failures++; } } while ( 0 )
+
+int main ( void )
+{
+   // 4 bit: rs, en, d4..d7 and a backlight line
+   // ------------------------------------------------------------------------
+   LiquidCrystal_GPIOChip lcd ( "/dev/null", 25, 24, 23, 17, 18, 22 );
+
+   lcd.setBacklightPin ( 4, POSITIVE );
+   lcd.begin ( 16, 2 );
+
+   CHECK ( lastReq.num_lines == 7 );
+   CHECK ( lastReq.offsets[0] == 25 && lastReq.offsets[1] == 24 );
+   CHECK ( lastReq.offsets[2] == 23 && lastReq.offsets[5] == 22 );
+   CHECK ( lastReq.offsets[6] == 4 );
+   CHECK ( lastReq.config.flags == GPIO_V2_LINE_FLAG_OUTPUT );
+   CHECK ( strcmp ( lastReq.consumer, GPIOCHIP_CONSUMER ) == 0 );
+   CHECK ( lines & 0x40 );          // begin switches the backlight on
+
+   resetMock ( );
+   lcd.print ( "Hi" );
+   CHECK ( setCalls == 1 + 4 * 2 ); // RS set once, 2 per nibble
+   CHECK ( latchLen == 4 );
+   CHECK ( ( ( latched[0] & 0x0F ) << 4 | ( latched[1] & 0x0F ) ) == 'H' );
+   CHECK ( ( ( latched[2] & 0x0F ) << 4 | ( latched[3] & 0x0F ) ) == 'i' );
+   CHECK ( latchedRs[0] && latchedRs[1] && latchedRs[2] && latchedRs[3] );
+   CHECK ( rise[1] - rise[0] >= LCD_T_CYCE );
+   CHECK ( rise[2] - rise[1] >= GPIOCHIP_EXEC_TIME * 1000ULL );
+
+   resetMock ( );
+   lcd.setCursor ( 0, 1 );
+   CHECK ( setCalls == 1 + 2 * 2 );
+   CHECK ( latchLen == 2 && !latchedRs[0] );
+   CHECK ( ( ( latched[0] & 0x0F ) << 4 | ( latched[1] & 0x0F ) ) == 0xC0 );
+
+   lcd.setBacklight ( LOW );
+   CHECK ( !( lines & 0x40 ) );
+
+   // 8 bit, negative backlight
+   // ------------------------------------------------------------------------
+   LiquidCrystal_GPIOChip lcd8 ( "/dev/null", 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 );
+
+   lcd8.setBacklightPin ( 12, NEGATIVE );
+   lcd8.begin ( 16, 2 );
+
+   CHECK ( lastReq.num_lines == 11 );
+   CHECK ( !( lines & 0x400 ) );
+
+   resetMock ( );
+   lcd8.print ( "Hi" );
+   CHECK ( setCalls == 1 + 2 * 2 );
+   CHECK ( latchLen == 2 );
+   CHECK ( latched[0] == 'H' && latched[1] == 'i' );
+   CHECK ( rise[1] - rise[0] >= GPIOCHIP_EXEC_TIME * 1000ULL );
+
+   printf ( "%s\n", failures ? "FAILED" : "OK" );
+   return ( failures ? 1 : 0 );
+}
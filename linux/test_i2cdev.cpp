@@ -0,0 +1,214 @@
+// ---------------------------------------------------------------------------
+// test_i2cdev - checks the i2c-dev transport of the Linux host build
+//
+// ioctl is replaced by a mock of the i2c-dev interface that records the
+// transfers, the bus device is /dev/null. Checks that:
+//    - with an I2C adapter every LCD character is one I2C_RDWR system call
+//      carrying the 4 expander words, which decode back to the character.
+//    - with an SMBus only adapter (i2c-stub) the same words are sent as
+//      SMBus send byte commands, the address being set once.
+//    - the MCP23008 backpack, the same driver on I2CIO_MCP23008, writes the
+//      4 expander words of a character to the GPIO register in one I2C_RDWR.
+//    - an MCP23008 burst write fills the Wire buffer with 31 values, a
+//      longer one fails without writing.
+//
+// usage: test_i2cdev, exit status 0 if all the checks pass.
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "LiquidCrystal_I2C.h"
+#include "I2CIO_MCP23008.h"
+#include "LiquidCrystal_I2C_MCP23008.h"
+
+// MOCK i2c-dev
+// ---------------------------------------------------------------------------
+static unsigned long mockFuncs;     // functionality of the mock adapter
+static int     rdwrCalls;           // I2C_RDWR system calls
+static int     smbusCalls;          // I2C_SMBUS system calls
+static int     slaveCalls;          // I2C_SLAVE system calls
+static uint8_t lastAddr;            // address of the last write
+static uint8_t sent[64];            // bytes of the last writes
+static int     sentLen;
+
+extern "C" int ioctl ( int fd, unsigned long request, ... )
+{
+   va_list ap;
+   void *arg;
+
+   va_start ( ap, request );
+   arg = va_arg ( ap, void * );
+   va_end ( ap );
+
+   switch ( request )
+   {
+      case I2C_FUNCS:
+         *(unsigned long *)arg = mockFuncs;
+         return ( 0 );
+
+      case I2C_SLAVE:
+         slaveCalls++;
+         lastAddr = (uint8_t)(unsigned long)arg;
+         return ( 0 );
+
+      case I2C_RDWR:
+      {
+         struct i2c_rdwr_ioctl_data *xfer = (struct i2c_rdwr_ioctl_data *)arg;
+
+         rdwrCalls++;
+         for ( unsigned m = 0; m < xfer->nmsgs; m++ )
+         {
+            struct i2c_msg *msg = &xfer->msgs[m];
+
+            if ( msg->flags & I2C_M_RD )
+            {
+               for ( int i = 0; i < msg->len; i++ ) msg->buf[i] = 0xFF;
+            }
+            else
+            {
+               lastAddr = msg->addr;
+               for ( int i = 0; ( i < msg->len ) && ( sentLen < 64 ); i++ )
+               {
+                  sent[sentLen++] = msg->buf[i];
+               }
+            }
+         }
+         return ( 0 );
+      }
+
+      case I2C_SMBUS:
+      {
+         struct i2c_smbus_ioctl_data *args = (struct i2c_smbus_ioctl_data *)arg;
+
+         smbusCalls++;
+         if ( ( args->read_write == I2C_SMBUS_WRITE ) &&
+              ( args->size == I2C_SMBUS_BYTE ) && ( sentLen < 64 ) )
+         {
+            sent[sentLen++] = args->command;
+         }
+         else if ( args->read_write == I2C_SMBUS_READ )
+         {
+            args->data->byte = 0xFF;
+         }
+         return ( 0 );
+      }
+   }
+   return ( -1 );
+}
+
+static void resetMock ( void )
+{
+   rdwrCalls = smbusCalls = slaveCalls = sentLen = 0;
+}
+
+// CHECKS
+// ---------------------------------------------------------------------------
+static int failures;
+
+#define CHECK(cond) \
+   do { if ( !( cond ) ) { printf ( "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond ); failures++; } } while ( 0 )
+
+//
+// decode - character of 4 expander words, mapping en=2, rs=0, d4..d7=4..7
+static int decode ( const uint8_t *w )
+{
+   if ( !( w[0] & 0x04 ) || ( w[1] & 0x04 ) || !( w[2] & 0x04 ) || ( w[3] & 0x04 ) ||
+        !( w[0] & w[2] & 0x01 ) )
+   {
+      return ( -1 );
+   }
+   return ( ( w[1] & 0xF0 ) | ( w[3] >> 4 ) );
+}
+
+//
+// decodeMCP23008 - same for the Adafruit wiring, en=2, rs=1, d4..d7=3..6
+static int decodeMCP23008 ( const uint8_t *w )
+{
+   if ( !( w[0] & 0x04 ) || ( w[1] & 0x04 ) || !( w[2] & 0x04 ) || ( w[3] & 0x04 ) ||
+        !( w[0] & w[2] & 0x02 ) )
+   {
+      return ( -1 );
+   }
+   return ( ( ( w[1] << 1 ) & 0xF0 ) | ( ( w[3] >> 3 ) & 0x0F ) );
+}
+
+int main ( void )
+{
+   //                    addr, en,rw,rs,d4,d5,d6,d7,bl,blpol
+   LiquidCrystal_I2C lcd ( 0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE );
+
+   Wire.setDevice ( "/dev/null" );
+
+   // I2C adapter: one I2C_RDWR per character
+   // ------------------------------------------------------------------------
+   mockFuncs = I2C_FUNC_I2C | I2C_FUNC_SMBUS_BYTE;
+   lcd.begin ( 16, 2 );
+
+   resetMock ( );
+   lcd.print ( "Hi" );
+   CHECK ( rdwrCalls == 2 );
+   CHECK ( smbusCalls == 0 );
+   CHECK ( lastAddr == 0x27 );
+   CHECK ( sentLen == 8 );
+   CHECK ( decode ( &sent[0] ) == 'H' );
+   CHECK ( decode ( &sent[4] ) == 'i' );
+
+   // SMBus only adapter: send byte per expander word, address set once
+   // ------------------------------------------------------------------------
+   Wire.end ( );
+   mockFuncs = I2C_FUNC_SMBUS_BYTE | I2C_FUNC_SMBUS_QUICK;
+   lcd.begin ( 16, 2 );
+
+   resetMock ( );
+   lcd.print ( "Hi" );
+   CHECK ( rdwrCalls == 0 );
+   CHECK ( smbusCalls == 8 );
+   CHECK ( slaveCalls == 0 );
+   CHECK ( sentLen == 8 );
+   CHECK ( decode ( &sent[0] ) == 'H' );
+   CHECK ( decode ( &sent[4] ) == 'i' );
+
+   // MCP23008: GPIO register address and the 4 words in one I2C_RDWR
+   // ------------------------------------------------------------------------
+   LiquidCrystal_I2C_MCP23008 lcdMcp ( 0x20 );
+
+   Wire.end ( );
+   mockFuncs = I2C_FUNC_I2C | I2C_FUNC_SMBUS_BYTE;
+   lcdMcp.begin ( 16, 2 );
+
+   resetMock ( );
+   lcdMcp.print ( "H" );
+   CHECK ( rdwrCalls == 1 );
+   CHECK ( lastAddr == 0x20 );
+   CHECK ( sentLen == 5 );
+   CHECK ( sent[0] == 0x09 );
+   CHECK ( decodeMCP23008 ( &sent[1] ) == 'H' );
+   CHECK ( sent[1] & 0x80 );       // backlight on
+
+   // MCP23008 burst: the GPIO register address and up to 31 values
+   // ------------------------------------------------------------------------
+   I2CIO_MCP23008 mcp;
+   uint8_t burst[MCP23008_BURST_MAX + 1];
+
+   memset ( burst, 0x55, sizeof ( burst ) );
+   mcp.begin ( 0x21 );
+   mcp.portMode ( OUTPUT );
+
+   resetMock ( );
+   CHECK ( mcp.write ( burst, MCP23008_BURST_MAX ) == 1 );
+   CHECK ( rdwrCalls == 1 && sentLen == 1 + MCP23008_BURST_MAX );
+   CHECK ( sent[0] == 0x09 && sent[MCP23008_BURST_MAX] == 0x55 );
+
+   resetMock ( );
+   CHECK ( mcp.write ( burst, MCP23008_BURST_MAX + 1 ) == 0 );
+   CHECK ( rdwrCalls == 0 );
+
+   printf ( "%s\n", failures ? "FAILED" : "OK" );
+   return ( failures ? 1 : 0 );
+}
@@ -0,0 +1,180 @@
+// ---------------------------------------------------------------------------
+// test_serial - checks LiquidCrystal_Serial on a pseudo-terminal
+//
+// The stream writes to the slave side of a pseudo-terminal standing in for
+// the UART, the bytes received by the backpack are read from the master
+// side. availableForWrite reports the room left in a UART transmit buffer
+// set by the test. Checks that:
+//    - begin, setCursor and print send the SerLCD byte stream.
+//    - print returns without writing more than the stream has room for, poll
+//      moves the rest once there is room.
+//    - write through streams (availableForWrite always 0, SoftwareSerial)
+//      are written straight away.
+//    - once the ring buffer is full the bytes in excess wait for the stream.
+//
+// usage: test_serial, exit status 0 if all the checks pass.
+// ---------------------------------------------------------------------------
+#define _XOPEN_SOURCE 600
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include <Arduino.h>
+#include "LiquidCrystal_Serial.h"
+
+// PSEUDO-TERMINAL STREAM
+// ---------------------------------------------------------------------------
+class PtyStream : public Stream
+{
+public:
+   PtyStream ( int fd, bool reportsRoom ) :
+      _fd ( fd ), _reportsRoom ( reportsRoom ), room ( 0 ), writes ( 0 ) { }
+
+   size_t write ( uint8_t value )
+   {
+      writes++;
+      if ( room > 0 ) room--;
+      return ( ::write ( _fd, &value, 1 ) == 1 );
+   }
+   int availableForWrite ( void ) { return ( _reportsRoom ? room : 0 ); }
+   int available ( void ) { return ( 0 ); }
+   int read ( void ) { return ( -1 ); }
+   int peek ( void ) { return ( -1 ); }
+
+private:
+   int  _fd;
+   bool _reportsRoom;
+
+public:
+   int  room;                       // room left in the UART buffer
+   int  writes;                     // bytes written to the stream
+};
+
+//
+// openPty - raw pseudo-terminal, returns the master, slave in *slave
+static int openPty ( int *slave )
+{
+   struct termios tio;
+   int master = posix_openpt ( O_RDWR | O_NOCTTY );
+
+   if ( ( master < 0 ) || grantpt ( master ) || unlockpt ( master ) )
+   {
+      return ( -1 );
+   }
+   *slave = open ( ptsname ( master ), O_RDWR | O_NOCTTY );
+   if ( *slave < 0 )
+   {
+      return ( -1 );
+   }
+   tcgetattr ( *slave, &tio );
+   cfmakeraw ( &tio );
+   tcsetattr ( *slave, TCSANOW, &tio );
+   fcntl ( master, F_SETFL, O_NONBLOCK );
+   return ( master );
+}
+
+//
+// received - bytes received by the backpack
+static int received ( int master, uint8_t *buf, int size )
+{
+   int len = 0;
+   int n;
+
+   usleep ( 10000 );
+   while ( ( len < size ) && ( ( n = ::read ( master, buf + len, size - len ) ) > 0 ) )
+   {
+      len += n;
+   }
+   return ( len );
+}
+
+// CHECKS
+// ---------------------------------------------------------------------------
+static int failures;
+
+#define CHECK(cond) \
+   do { if ( !( cond ) ) { printf ( "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond ); failures++; } } while ( 0 )
+
+// display on, clear, entry mode, backlight 255, cursor (3,1), "Hi", 42
+static const uint8_t expected[] =
+{
+   0xFE, 0x0C, 0xFE, 0x01, 0xFE, 0x06, 0x7C, 0x9D, 0xFE, 0xC3,
+   'H', 'i', '4', '2'
+};
+
+static int matches ( const uint8_t *buf, int len )
+{
+   if ( len != (int)sizeof ( expected ) )
+   {
+      return ( 0 );
+   }
+   for ( int i = 0; i < len; i++ )
+   {
+      if ( buf[i] != expected[i] ) return ( 0 );
+   }
+   return ( 1 );
+}
+
+int main ( void )
+{
+   uint8_t buf[256];
+   int slave;
+   int master = openPty ( &slave );
+
+   if ( master < 0 )
+   {
+      printf ( "no pseudo-terminal\n" );
+      return ( 1 );
+   }
+
+   // Stream reporting its room: print does not write more than it can take
+   // ------------------------------------------------------------------------
+   {
+      PtyStream stream ( slave, true );
+      LiquidCrystal_Serial lcd ( stream );
+
+      stream.room = 4;
+      lcd.begin ( 16, 2 );
+      lcd.setCursor ( 3, 1 );
+      lcd.print ( "Hi" );
+      lcd.print ( 42 );
+      CHECK ( stream.writes == 4 );
+      CHECK ( lcd.poll ( ) == sizeof ( expected ) - 4 );
+
+      stream.room = 64;
+      CHECK ( lcd.poll ( ) == 0 );
+      CHECK ( matches ( buf, received ( master, buf, sizeof ( buf ) ) ) );
+
+      // A full ring buffer: the bytes in excess wait for the stream
+      stream.room = 0;
+      stream.writes = 0;
+      for ( int i = 0; i < SERIAL_LCD_TX_LENGTH + 7; i++ )
+      {
+         lcd.write ( 'x' );
+      }
+      CHECK ( stream.writes == 8 );
+      CHECK ( lcd.poll ( ) == SERIAL_LCD_TX_LENGTH - 1 );
+      lcd.flush ( );
+      CHECK ( received ( master, buf, sizeof ( buf ) ) == SERIAL_LCD_TX_LENGTH + 7 );
+   }
+
+   // Write through stream: everything written without poll or flush
+   // ------------------------------------------------------------------------
+   {
+      PtyStream stream ( slave, false );
+      LiquidCrystal_Serial lcd ( stream, true );
+
+      lcd.begin ( 16, 2 );
+      lcd.setCursor ( 3, 1 );
+      lcd.print ( "Hi" );
+      lcd.print ( 42 );
+      CHECK ( stream.writes == sizeof ( expected ) );
+      CHECK ( lcd.poll ( ) == 0 );
+      CHECK ( matches ( buf, received ( master, buf, sizeof ( buf ) ) ) );
+   }
+
+   printf ( "%s\n", failures ? "FAILED" : "OK" );
+   return ( failures ? 1 : 0 );
+}